@@ -0,0 +1,33 @@
+// times the encode and syndrome variants for every rs8 and rs16 shape on this machine and saves the fastest as a
+//  profile for rs_tune_init() to load, see inc/rs_tune.h. Run from the build the profile is for, eg
+//  make autotune RELEASE=1 && ./autotune --out rs_tune.txt
+#include "rs_tune.h"
+#include <stdio.h>
+#include <string.h>
+
+int main(int argc, char** argv)
+{
+	const char* out_path = "rs_tune.txt";
+	for (int i = 1; i < argc; ++i)
+	{
+		if (!strcmp(argv[i], "--out") && i + 1 < argc)
+			out_path = argv[++i];
+		else
+		{
+			fprintf(stderr, "usage: %s [--out FILE]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	rs_tune_init(NULL);
+	printf("ns per call of each variant, fastest of several rounds\n");
+	rs_tune_run(stdout);
+
+	if (rs_tune_save(out_path))
+	{
+		fprintf(stderr, "couldn't write %s\n", out_path);
+		return 1;
+	}
+	printf("saved to %s\n", out_path);
+	return 0;
+}
@@ -0,0 +1,92 @@
+// compares the cache cold and warm cost of the field arithmetic and small decodes for whichever backend was built,
+//  run once from a normal build and once from a NO_LUT=1 build to compare the two, RELEASE=1 for both
+#include "gf8.h"
+#include "gf16.h"
+#include "rs_gf8.h"
+#include "rs_gf16.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BILLION 1000000000
+#define EVICT_SZ (32 * 1024 * 1024)	// bigger than any last level cache we run on
+#define COLD_RUNS 201				// odd so there's a single median
+#define WARM_RUNS 1000000
+
+static volatile uint8_t evict_buf[EVICT_SZ];
+volatile int64_t sink;	// keeps results alive without the compiler being able to drop the calls
+
+int64_t now_ns(void)
+{
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (int64_t)t.tv_sec * BILLION + t.tv_nsec;
+}
+
+// touching a buffer bigger than the caches pushes the tables and most of the code back out to memory
+void evict_caches(void)
+{
+	for (int32_t i = 0; i < EVICT_SZ; i += 64)
+		evict_buf[i]++;
+}
+
+int cmp_i64(const void* a, const void* b)
+{
+	int64_t x = *(const int64_t*)a, y = *(const int64_t*)b;
+	return (x > y) - (x < y);
+}
+
+// inputs that vary per call so nothing can be hoisted, the op index picks what gets timed
+int64_t run_op(int8_t op, int32_t i)
+{
+	switch (op)
+	{
+	case 0:
+		return gf8_mul(i & GF8_MAX, (i >> 3) & GF8_MAX);
+	case 1:
+		return gf16_mul(i & GF16_MAX, (i >> 4) & GF16_MAX);
+	case 2:
+		return gf16_inverse(1 + i % GF16_MAX);
+	case 3:
+		return gf16_pow(2 + i % 14, i & 0x3F);
+	case 4:	// 4 check symbols, 1 error
+		return rs8_decode_systematic(01230013 ^ (1 << (3 * (i % 7))), 21, 4, 0, 0x7F);
+	default:	// 6 check symbols, 2 errors
+		return rs16_decode_systematic(rs16_encode_systematic(0x123456789, 6) ^ ((int64_t)7 << (4 * (3 + i % 12))) ^ 0x500, 60, 6, 0, 0x7FFF);
+	}
+}
+
+int main(void)
+{
+	const char* names[] = {"gf8_mul", "gf16_mul", "gf16_inverse", "gf16_pow", "rs8 decode, 1 error", "rs16 decode, 2 errors"};
+	int64_t cold[COLD_RUNS];
+
+#if defined(GF16_NO_LUT)
+	printf("backend: shift and reduce (NO_LUT)\n");
+#else
+	printf("backend: exp/log LUT\n");
+#endif
+	printf("%-24s %12s %12s\n", "operation", "cold ns", "warm ns");
+	for (int8_t op = 0; op < 6; ++op)
+	{
+		for (int32_t r = 0; r < COLD_RUNS; ++r)
+		{
+			evict_caches();
+			int64_t start = now_ns();
+			sink = run_op(op, r);
+			cold[r] = now_ns() - start;
+		}
+		qsort(cold, COLD_RUNS, sizeof(cold[0]), cmp_i64);
+
+		int64_t start = now_ns();
+		for (int32_t i = 0; i < WARM_RUNS; ++i)
+			sink = run_op(op, i);
+		double warm = (double)(now_ns() - start) / WARM_RUNS;
+
+		printf("%-24s %12lld %12.2f\n", names[op], (long long)cold[COLD_RUNS / 2], warm);
+	}
+	printf("cold is the median of %d single calls after evicting the caches, timer overhead included\n", COLD_RUNS);
+
+	return 0;
+}
@@ -0,0 +1,243 @@
+// A/B timings for the implementation variants that are still open questions in the code
+//
+// every variant is always compiled under its own name, the defines only pick which one the library uses:
+//  GF8_SCALE_MUL   GF16_SCALE_MUL		poly_scale multiplies by the bits of x instead of shift + select
+//  GF8_MUL_LOOP    GF16_MUL_LOOP		poly_mul as a loop over the terms instead of unrolled
+//  GF8_EVAL_MOD    GF16_EVAL_MOD		poly_eval by division with a binomial instead of Horner on the log tables
+//  RS8_ERASE_LIST  RS16_ERASE_LIST		erasure locator from a position list instead of scanning the bitmask
+//
+// the first half times each pair in isolation on the same inputs, the second half times the full decoders as built,
+//  so to see a variant inside the decoder run this once per build, eg
+//  make bench_variants RELEASE=1 && ./bench_variants
+//  make bench_variants RELEASE=1 VARIANTS="GF8_EVAL_MOD GF16_EVAL_MOD" && ./bench_variants
+#include "gf8.h"
+#include "gf16.h"
+#include "rs_gf8.h"
+#include "rs_gf16.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#define BILLION 1000000000
+#define INPUTS 4096	// inputs per case, same ones for both variants
+#define PASSES 500
+
+typedef struct
+{
+	int64_t p[INPUTS];
+	int64_t q[INPUTS];
+	int8_t list[INPUTS][GF16_MAX];
+	int8_t list_cnt[INPUTS];
+	int16_t e_pos[INPUTS];
+} variant_inputs;
+
+static variant_inputs in;
+volatile int64_t sink;	// keeps results alive without the compiler being able to drop the calls
+uint64_t rng_state = 0x5EED5EED5EED5EEDULL;
+
+// xorshift64*, fixed seed so every build sees the same inputs
+uint64_t rng_next(void)
+{
+	rng_state ^= rng_state >> 12;
+	rng_state ^= rng_state << 25;
+	rng_state ^= rng_state >> 27;
+	return rng_state * 0x2545F4914F6CDD1DULL;
+}
+
+int64_t now_ns(void)
+{
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (int64_t)t.tv_sec * BILLION + t.tv_nsec;
+}
+
+// the calls go through a pointer so neither side gets inlined where the other doesn't
+typedef int64_t (*variant_fn)(int32_t i);
+
+double time_variant(variant_fn fn)
+{
+	for (int32_t i = 0; i < INPUTS; ++i)	// warm up
+		sink = fn(i);
+
+	int64_t start = now_ns();
+	for (int32_t p = 0; p < PASSES; ++p)
+	{
+		for (int32_t i = 0; i < INPUTS; ++i)
+			sink = fn(i);
+	}
+	return (double)(now_ns() - start) / ((double)PASSES * INPUTS);
+}
+
+// both variants must agree on every input or the timings mean nothing
+void compare(const char* question, const char* name_a, variant_fn a, const char* name_b, variant_fn b, int8_t b_is_default)
+{
+	int32_t mismatches = 0;
+	for (int32_t i = 0; i < INPUTS; ++i)
+		mismatches += a(i) != b(i);
+
+	double ns_a = time_variant(a);
+	double ns_b = time_variant(b);
+	printf("%-22s %-22s %8.2f %-22s %8.2f  %5.2fx  default %s%s\n", question, name_a, ns_a, name_b, ns_b, ns_a / ns_b,
+		b_is_default ? name_b : name_a, mismatches ? "  MISMATCH" : "");
+}
+
+int64_t gf8_scale_select(int32_t i) { return gf8_poly_scale_select(in.p[i], in.q[i]); }
+int64_t gf8_scale_mul(int32_t i) { return gf8_poly_scale_mul(in.p[i], in.q[i]); }
+int64_t gf16_scale_select(int32_t i) { return gf16_poly_scale_select(in.p[i], in.q[i]); }
+int64_t gf16_scale_mul(int32_t i) { return gf16_poly_scale_mul(in.p[i], in.q[i]); }
+int64_t gf8_mul_unrolled(int32_t i) { return gf8_poly_mul_unrolled(in.p[i], in.q[i]); }
+int64_t gf8_mul_loop(int32_t i) { return gf8_poly_mul_loop(in.p[i], in.q[i]); }
+int64_t gf16_mul_unrolled(int32_t i) { return gf16_poly_mul_unrolled(in.p[i], in.q[i]); }
+int64_t gf16_mul_loop(int32_t i) { return gf16_poly_mul_loop(in.p[i], in.q[i]); }
+int64_t gf8_eval_horner(int32_t i) { return gf8_poly_eval_horner(in.p[i], 21, in.q[i]); }
+int64_t gf8_eval_mod(int32_t i) { return gf8_poly_eval_mod(in.p[i], 21, in.q[i]); }
+int64_t gf16_eval_horner(int32_t i) { return gf16_poly_eval_horner(in.p[i], 60, in.q[i]); }
+int64_t gf16_eval_mod(int32_t i) { return gf16_poly_eval_mod(in.p[i], 60, in.q[i]); }
+int64_t rs8_erase_mask(int32_t i) { return rs8_get_erasure_locator_mask(in.p[i]); }
+int64_t rs8_erase_list(int32_t i) { return rs8_get_erasure_locator_list(in.list[i], in.list_cnt[i]); }
+int64_t rs16_erase_mask(int32_t i) { return rs16_get_erasure_locator_mask(in.p[i]); }
+int64_t rs16_erase_list(int32_t i) { return rs16_get_erasure_locator_list(in.list[i], in.list_cnt[i]); }
+
+// p_bits and q_bits limit the random polynomials, or elements when q is a scalar, nonzero keeps q from being 0
+//  for the evals since the log table has no entry for it
+void make_inputs(int8_t p_bits, int8_t q_bits, int8_t nonzero)
+{
+	int64_t q_mask = ((int64_t)1 << q_bits) - 1;
+	for (int32_t i = 0; i < INPUTS; ++i)
+	{
+		in.p[i] = rng_next() & (((int64_t)1 << p_bits) - 1);
+		in.q[i] = nonzero ? 1 + rng_next() % q_mask : rng_next() & q_mask;
+	}
+}
+
+// masks with up to max_cnt erasures over n terms and the matching position lists
+void make_erasures(int8_t n, int8_t max_cnt)
+{
+	for (int32_t i = 0; i < INPUTS; ++i)
+	{
+		int8_t cnt = rng_next() % (max_cnt + 1);
+		int64_t mask = 0;
+		while (__builtin_popcountll(mask) < cnt)
+			mask |= (int64_t)1 << (rng_next() % n);
+		in.p[i] = mask;
+		in.list_cnt[i] = 0;
+		for (int8_t j = 0; j < n; ++j)
+		{
+			if ((mask >> j) & 1)
+				in.list[i][in.list_cnt[i]++] = j;
+		}
+	}
+}
+
+// decode workload with a mix of everything up to the correction limit, same for every build
+double time_decoder(int8_t field, int8_t chk_syms)
+{
+	int8_t sym_sz = (field == 8) ? GF8_SYM_SZ : GF16_SYM_SZ;
+	int8_t n = (field == 8) ? GF8_MAX : GF16_MAX;
+	int32_t failures = 0;
+	for (int32_t i = 0; i < INPUTS; ++i)
+	{
+		int64_t raw = rng_next() & (((int64_t)1 << (sym_sz * (n - chk_syms))) - 1);
+		int64_t cw = (field == 8) ? rs8_encode_systematic(raw, chk_syms) : rs16_encode_systematic(raw, chk_syms);
+		int8_t erasures = rng_next() % (chk_syms + 1);
+		int8_t errs = rng_next() % ((chk_syms - erasures) / 2 + 1);
+		int16_t e_pos = 0, used = 0;
+		while (__builtin_popcount(used) < erasures + errs)
+		{
+			int8_t j = rng_next() % n;
+			if ((used >> j) & 1)
+				continue;
+			used |= 1 << j;
+			if (__builtin_popcount(e_pos) < erasures)
+			{
+				e_pos |= 1 << j;
+				cw ^= (int64_t)(rng_next() % (n + 1)) << (sym_sz * j);
+			}
+			else
+				cw ^= (int64_t)(1 + rng_next() % n) << (sym_sz * j);
+		}
+		in.p[i] = cw;
+		in.q[i] = raw;
+		in.e_pos[i] = e_pos;
+	}
+
+	int64_t start = now_ns();
+	for (int32_t p = 0; p < PASSES / 10; ++p)
+	{
+		for (int32_t i = 0; i < INPUTS; ++i)
+		{
+			int64_t r = (field == 8) ? rs8_decode_systematic(in.p[i], 21, chk_syms, in.e_pos[i], 0x7F)
+				: rs16_decode_systematic(in.p[i], 60, chk_syms, in.e_pos[i], 0x7FFF);
+			if (!p)
+				failures += r != in.q[i];
+			sink = r;
+		}
+	}
+	double ns = (double)(now_ns() - start) / ((double)(PASSES / 10) * INPUTS);
+	if (failures)
+		printf("rs%d chk %d: %d decode failures\n", field, chk_syms, failures);
+
+	return ns;
+}
+
+int8_t is_defined(const char* list, const char* name)
+{
+	return strstr(list, name) != NULL;
+}
+
+int main(void)
+{
+	const char* active = ""
+#ifdef GF8_SCALE_MUL
+		" GF8_SCALE_MUL"
+#endif
+#ifdef GF16_SCALE_MUL
+		" GF16_SCALE_MUL"
+#endif
+#ifdef GF8_MUL_LOOP
+		" GF8_MUL_LOOP"
+#endif
+#ifdef GF16_MUL_LOOP
+		" GF16_MUL_LOOP"
+#endif
+#ifdef GF8_EVAL_MOD
+		" GF8_EVAL_MOD"
+#endif
+#ifdef GF16_EVAL_MOD
+		" GF16_EVAL_MOD"
+#endif
+#ifdef RS8_ERASE_LIST
+		" RS8_ERASE_LIST"
+#endif
+#ifdef RS16_ERASE_LIST
+		" RS16_ERASE_LIST"
+#endif
+		;
+
+	printf("variants in isolation, ns per call\n");
+	make_inputs(21, 3, 0);
+	compare("gf8 scale", "select", gf8_scale_select, "mul", gf8_scale_mul, is_defined(active, "GF8_SCALE_MUL"));
+	make_inputs(60, 4, 0);
+	compare("gf16 scale", "select", gf16_scale_select, "mul", gf16_scale_mul, is_defined(active, "GF16_SCALE_MUL"));
+	make_inputs(15, 15, 0);	// 5 terms each, the limit of gf8_poly_mul()
+	compare("gf8 poly mul", "unrolled", gf8_mul_unrolled, "loop", gf8_mul_loop, is_defined(active, "GF8_MUL_LOOP"));
+	make_inputs(28, 28, 0);	// 7 terms each so the product fits in 15
+	compare("gf16 poly mul", "unrolled", gf16_mul_unrolled, "loop", gf16_mul_loop, is_defined(active, "GF16_MUL_LOOP"));
+	make_inputs(21, 3, 1);
+	compare("gf8 eval", "horner", gf8_eval_horner, "mod", gf8_eval_mod, is_defined(active, "GF8_EVAL_MOD"));
+	make_inputs(60, 4, 1);
+	compare("gf16 eval", "horner", gf16_eval_horner, "mod", gf16_eval_mod, is_defined(active, "GF16_EVAL_MOD"));
+	make_erasures(GF8_MAX, 6);
+	compare("rs8 erasure locator", "mask", rs8_erase_mask, "list", rs8_erase_list, is_defined(active, "RS8_ERASE_LIST"));
+	make_erasures(GF16_MAX, 14);
+	compare("rs16 erasure locator", "mask", rs16_erase_mask, "list", rs16_erase_list, is_defined(active, "RS16_ERASE_LIST"));
+
+	printf("\nfull decoder with variants:%s\n", *active ? active : " none (defaults)");
+	for (int8_t chk = 2; chk <= 6; chk += 2)
+		printf("rs8  chk %2d %8.2f ns/cw\n", chk, time_decoder(8, chk));
+	for (int8_t chk = 2; chk <= 14; chk += 4)
+		printf("rs16 chk %2d %8.2f ns/cw\n", chk, time_decoder(16, chk));
+
+	return 0;
+}
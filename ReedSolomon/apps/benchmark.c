@@ -1,31 +1,282 @@
-// meant to benchmark some low level operations that get used frequently to determine which implementation to go with
+// end to end throughput and latency of the rs8 and rs16 encoders and decoders for every number of check symbols
+//  build with make benchmark RELEASE=1 (and NO_LUT=1 for the table-free backend), --json for machine readable output
+//
+// every case runs over the same fixed seed workload of WORKLOAD_CW code words so results are comparable between
+//  versions and backends. Throughput comes from timing whole passes over the workload, latency percentiles from
+//  timing every call of one more pass individually, so they include the timer overhead of a few ns.
+//  cycles are read from the TSC on x86, which counts at a fixed reference rate rather than the actual core clock
+//  built with PROFILE=1 it also writes the per stage decoder histograms for the whole run to stderr as json
 #include "rs_gf8.h"
+#include "rs_gf16.h"
 #include "gf8.h"
+#include "gf16.h"
+#include "rs_profile.h"
 #include <stdio.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 #include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
 
-#define MILLION 1000000
 #define BILLION 1000000000
+#define WORKLOAD_CW 4096	// code words per workload, small enough to stay cache resident
+#define DEFAULT_PASSES 200	// timed passes over the workload per case
+#define DEFAULT_SEED 0x5EED5EED5EED5EEDULL
+
+typedef enum
+{
+	OP_ENCODE,
+	OP_DECODE
+} bench_op;
+
+typedef struct
+{
+	int64_t input[WORKLOAD_CW];		// raw data for encodes, received words for decodes
+	int64_t expect[WORKLOAD_CW];	// what a correct call returns, used to count failures
+	int16_t e_pos[WORKLOAD_CW];
+	int8_t field;					// 8 or 16
+	int8_t chk_syms;
+	bench_op op;
+} workload;
+
+typedef struct
+{
+	double ns_per_cw;
+	double cw_per_s;
+	double cycles_per_cw;
+	double p50, p90, p99, p999;	// per call latency in ns
+	int32_t failures;
+} bench_result;
+
+static workload wl;
+static int64_t lat[WORKLOAD_CW];
+volatile int64_t sink;	// keeps results alive without the compiler being able to drop the calls
+
+uint64_t rng_state;
+
+// xorshift64*, fixed seed so every run sees the same workload
+uint64_t rng_next(void)
+{
+	rng_state ^= rng_state >> 12;
+	rng_state ^= rng_state << 25;
+	rng_state ^= rng_state >> 27;
+	return rng_state * 0x2545F4914F6CDD1DULL;
+}
+
+int64_t now_ns(void)
+{
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (int64_t)t.tv_sec * BILLION + t.tv_nsec;
+}
+
+uint64_t read_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return now_ns();	// no portable cycle counter, reports ns instead
+#endif
+}
+
+int cmp_i64(const void* a, const void* b)
+{
+	int64_t x = *(const int64_t*)a, y = *(const int64_t*)b;
+	return (x > y) - (x < y);
+}
+
+// picks cnt distinct symbol positions below n that aren't already in taken
+int16_t rng_positions(int8_t n, int8_t cnt, int16_t taken)
+{
+	int16_t pos = 0;
+	while (cnt)
+	{
+		int16_t bit = 1 << (rng_next() % n);
+		if ((pos | taken) & bit)
+			continue;
+		pos |= bit;
+		--cnt;
+	}
+
+	return pos;
+}
+
+// fills the workload with random data, encoded and then hit with errs errors and erasures erasures
+void make_workload(int8_t field, int8_t chk_syms, bench_op op, int8_t errs, int8_t erasures)
+{
+	int8_t sym_sz = (field == 8) ? GF8_SYM_SZ : GF16_SYM_SZ;
+	int8_t n = (field == 8) ? GF8_MAX : GF16_MAX;
+	int64_t sym_mask = (field == 8) ? GF8_MAX : GF16_MAX;
+	int64_t data_mask = ((int64_t)1 << (sym_sz * (n - chk_syms))) - 1;
+
+	wl.field = field;
+	wl.chk_syms = chk_syms;
+	wl.op = op;
+	for (int32_t i = 0; i < WORKLOAD_CW; ++i)
+	{
+		int64_t raw = rng_next() & data_mask;
+		int64_t cw = (field == 8) ? rs8_encode_systematic(raw, chk_syms) : rs16_encode_systematic(raw, chk_syms);
+		if (op == OP_ENCODE)
+		{
+			wl.input[i] = raw;
+			wl.expect[i] = cw;
+			wl.e_pos[i] = 0;
+			continue;
+		}
+
+		int16_t e_pos = rng_positions(n, erasures, 0);
+		int16_t err_pos = rng_positions(n, errs, e_pos);
+		for (int8_t j = 0; j < n; ++j)
+		{
+			int64_t v = 0;
+			if ((err_pos >> j) & 1)
+				v = 1 + rng_next() % sym_mask;	// errors always change the symbol
+			else if ((e_pos >> j) & 1)
+				v = rng_next() % (sym_mask + 1);	// erasures may or may not
+			cw ^= v << (sym_sz * j);
+		}
+		wl.input[i] = cw;
+		wl.expect[i] = raw;
+		wl.e_pos[i] = e_pos;
+	}
+}
+
+int64_t run_one(int32_t i)
+{
+	if (wl.field == 8)
+	{
+		if (wl.op == OP_ENCODE)
+			return rs8_encode_systematic(wl.input[i], wl.chk_syms);
+		return rs8_decode_systematic(wl.input[i], 21, wl.chk_syms, wl.e_pos[i], 0x7F);
+	}
+	if (wl.op == OP_ENCODE)
+		return rs16_encode_systematic(wl.input[i], wl.chk_syms);
+	return rs16_decode_systematic(wl.input[i], 60, wl.chk_syms, wl.e_pos[i], 0x7FFF);
+}
+
+bench_result run_case(int32_t passes)
+{
+	bench_result r;
+	r.failures = 0;
+	for (int32_t i = 0; i < WORKLOAD_CW; ++i)	// doubles as the warm up pass
+		r.failures += run_one(i) != wl.expect[i];
+
+	int64_t start = now_ns();
+	uint64_t c_start = read_cycles();
+	for (int32_t p = 0; p < passes; ++p)
+	{
+		for (int32_t i = 0; i < WORKLOAD_CW; ++i)
+			sink = run_one(i);
+	}
+	uint64_t cycles = read_cycles() - c_start;
+	int64_t ns = now_ns() - start;
+
+	double calls = (double)passes * WORKLOAD_CW;
+	r.ns_per_cw = ns / calls;
+	r.cw_per_s = calls * BILLION / ns;
+	r.cycles_per_cw = cycles / calls;
+
+	for (int32_t i = 0; i < WORKLOAD_CW; ++i)
+	{
+		int64_t t = now_ns();
+		sink = run_one(i);
+		lat[i] = now_ns() - t;
+	}
+	qsort(lat, WORKLOAD_CW, sizeof(lat[0]), cmp_i64);
+	r.p50 = lat[WORKLOAD_CW * 50 / 100];
+	r.p90 = lat[WORKLOAD_CW * 90 / 100];
+	r.p99 = lat[WORKLOAD_CW * 99 / 100];
+	r.p999 = lat[WORKLOAD_CW * 999 / 1000];
+
+	return r;
+}
+
+int main(int argc, char** argv)
+{
+	int8_t json = 0;
+	int32_t passes = DEFAULT_PASSES;
+	uint64_t seed = DEFAULT_SEED;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (!strcmp(argv[i], "--json"))
+			json = 1;
+		else if (!strcmp(argv[i], "--passes") && i + 1 < argc)
+			passes = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+			seed = strtoull(argv[++i], NULL, 0);
+		else
+		{
+			fprintf(stderr, "usage: %s [--json] [--passes N] [--seed S]\n", argv[0]);
+			return 1;
+		}
+	}
+
+#if defined(GF16_NO_LUT)
+	const char* backend = "nolut";
+#else
+	const char* backend = "lut";
+#endif
+#if defined(__OPTIMIZE__)
+	const char* build = "optimized";
+#else
+	const char* build = "debug";
+#endif
+
+	if (json)
+		printf("{\"backend\": \"%s\", \"build\": \"%s\", \"seed\": %llu, \"passes\": %d, \"workload_cw\": %d, \"results\": [",
+			backend, build, (unsigned long long)seed, passes, WORKLOAD_CW);
+	else
+	{
+		printf("backend %s, %s build, seed 0x%llX, %d passes of %d code words\n", backend, build, (unsigned long long)seed, passes, WORKLOAD_CW);
+		printf("%-5s %3s %-8s %3s %3s %10s %12s %10s %8s %8s %8s %8s %5s\n",
+			"code", "chk", "op", "e", "f", "ns/cw", "cw/s", "cycles/cw", "p50", "p90", "p99", "p99.9", "fail");
+	}
+
+	int8_t first = 1;
+	for (int8_t field = 8; field <= 16; field += 8)
+	{
+		int8_t max_chk = (field == 8) ? 6 : 14;	// limits of the hard coded generator tables
+		for (int8_t chk = 1; chk <= max_chk; ++chk)
+		{
+			// encode, clean decode, then the worst case of errors only, erasures only and a mix of both
+			int8_t cases[][3] = {{OP_ENCODE, 0, 0}, {OP_DECODE, 0, 0}, {OP_DECODE, chk / 2, 0},
+				{OP_DECODE, 0, chk}, {OP_DECODE, (chk - 1) / 2, chk - 2 * ((chk - 1) / 2)}};
+			for (uint8_t c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c)
+			{
+				int8_t errs = cases[c][1], erasures = cases[c][2];
+				if (c > 1 && !errs && !erasures)
+					continue;	// chk = 1 has no room for an error
+				if (c == 4 && (!errs || !erasures))
+					continue;	// mix degenerates into one of the others
+				rng_state = seed ^ ((uint64_t)field << 40) ^ ((uint64_t)chk << 32) ^ c;
+				make_workload(field, chk, cases[c][0], errs, erasures);
+				bench_result r = run_case(passes);
+
+				const char* op = (cases[c][0] == OP_ENCODE) ? "encode" : "decode";
+				if (json)
+					printf("%s\n  {\"code\": \"rs%d\", \"chk_syms\": %d, \"op\": \"%s\", \"errors\": %d, \"erasures\": %d, "
+						"\"ns_per_cw\": %.3f, \"cw_per_s\": %.0f, \"cycles_per_cw\": %.2f, "
+						"\"p50_ns\": %.0f, \"p90_ns\": %.0f, \"p99_ns\": %.0f, \"p999_ns\": %.0f, \"failures\": %d}",
+						first ? "" : ",", field, chk, op, errs, erasures, r.ns_per_cw, r.cw_per_s, r.cycles_per_cw,
+						r.p50, r.p90, r.p99, r.p999, r.failures);
+				else
+					printf("rs%-3d %3d %-8s %3d %3d %10.2f %12.0f %10.1f %8.0f %8.0f %8.0f %8.0f %5d\n",
+						field, chk, op, errs, erasures, r.ns_per_cw, r.cw_per_s, r.cycles_per_cw,
+						r.p50, r.p90, r.p99, r.p999, r.failures);
+				first = 0;
+			}
+		}
+	}
+	if (json)
+		printf("\n]}\n");
+
+#ifdef RS_PROFILE
+	rs_profile_snapshot snap;
+	rs_profile_snapshot_get(&snap);
+	rs_profile_export_json(stderr, &snap);
+#endif
 
-int main(void)
-{
-	struct timespec start, end;
-	int x = 1;
-	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &start);
-	for (int i = 0; i < BILLION; i++)
-	{
-		// x ^= gf8_poly_scale(i, i);
-		x ^= gf8_mul(i & 7, x & 7);
-		x ^= gf8_mul(i & 7, x & 7);
-		x ^= gf8_mul(i & 7, x & 7);
-		x ^= gf8_mul(i & 7, x & 7);
-	}
-	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &end);
-	printf("%o\n", x); // prevent optimizing x out;
-	int64_t nanoseconds = (end.tv_sec - start.tv_sec) * BILLION;
-	nanoseconds += (end.tv_nsec - start.tv_nsec);
-	double seconds = (double)nanoseconds / (double)BILLION;
-	printf("1 billion calls took: %f seconds\n", seconds);
 	return 0;
-}
\ No newline at end of file
+}
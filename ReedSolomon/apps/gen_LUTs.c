@@ -2,12 +2,96 @@
 #include <stdio.h>
 #include "gf8.h"
 #include "gf16.h"
+#include "gf32.h"
+#include "gf64.h"
+#include "gf256.h"
+#include "golay24.h"
+#include "rs_gf8_cache.h"
+#include "rs_tables.h"
+#include <stdlib.h>
+#include <string.h>
 
-int main()
+#define MAX_RS8_FULL 8
+
+// gen_LUTs --bin FILE [--rs8-full CHK_SYMS]... writes the runtime built tables to a file for rs_tables_open()
+//  instead of printing the C initializers. Each --rs8-full adds an 8MB rs8 full decode table for that many check
+//  symbols with every symbol transmitted, which takes a while to fill
+int write_tables(const char* path, const int8_t* rs8_full_chk, int8_t rs8_full_cnt)
+{
+	static gf256_elem gf256_mul[2][1 + GF256_MAX][16];
+	static uint32_t golay[(sizeof(golay24_chk) + sizeof(golay24_errata)) / sizeof(uint32_t) + 1];
+	rs_table_src src[2 + MAX_RS8_FULL];
+	rs8_full_table* full[MAX_RS8_FULL] = {NULL};
+	int8_t cnt = 0;
+
+	gf256_init();
+	memcpy(gf256_mul[0], gf256_mul_lo, sizeof(gf256_mul_lo));
+	memcpy(gf256_mul[1], gf256_mul_hi, sizeof(gf256_mul_hi));
+	src[cnt++] = (rs_table_src){RS_TABLE_GF256_MUL, 0, gf256_mul, sizeof(gf256_mul)};
+
+	golay24_init();
+	memcpy(golay, golay24_chk, sizeof(golay24_chk));
+	memcpy((uint8_t*)golay + sizeof(golay24_chk), golay24_errata, sizeof(golay24_errata));
+	src[cnt++] = (rs_table_src){RS_TABLE_GOLAY24, 0, golay, sizeof(golay24_chk) + sizeof(golay24_errata)};
+
+	int8_t ret = 0;
+	for (int8_t i = 0; i < rs8_full_cnt && !ret; ++i)
+	{
+		full[i] = malloc(sizeof(rs8_full_table));
+		if (!full[i])
+		{
+			ret = -1;
+			break;
+		}
+		rs8_full_table_init(full[i], rs8_full_chk[i], 0x7F);
+		src[cnt++] = (rs_table_src){RS_TABLE_RS8_FULL, (uint8_t)rs8_full_chk[i] | 0x7F << 8, full[i], sizeof(rs8_full_table)};
+	}
+	if (!ret)
+		ret = rs_tables_write(path, src, cnt);
+
+	for (int8_t i = 0; i < rs8_full_cnt; ++i)
+		free(full[i]);
+	return ret;
+}
+
+int main(int argc, char** argv)
 {
+	const char* bin_path = NULL;
+	int8_t rs8_full_chk[MAX_RS8_FULL];
+	int8_t rs8_full_cnt = 0;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (!strcmp(argv[i], "--bin") && i + 1 < argc)
+			bin_path = argv[++i];
+		else if (!strcmp(argv[i], "--rs8-full") && i + 1 < argc && rs8_full_cnt < MAX_RS8_FULL)
+		{
+			int chk = atoi(argv[++i]);
+			if (chk < 1 || chk > 6)
+			{
+				fprintf(stderr, "--rs8-full takes 1 through 6 check symbols\n");
+				return 1;
+			}
+			rs8_full_chk[rs8_full_cnt++] = chk;
+		}
+		else
+		{
+			fprintf(stderr, "usage: %s [--bin FILE [--rs8-full CHK_SYMS]...]\n", argv[0]);
+			return 1;
+		}
+	}
+	if (bin_path)
+	{
+		if (write_tables(bin_path, rs8_full_chk, rs8_full_cnt))
+		{
+			fprintf(stderr, "couldn't write %s\n", bin_path);
+			return 1;
+		}
+		return 0;
+	}
+
 	int8_t x;
-	int8_t exp_LUT[15];
-	int8_t log_LUT[16];
+	int8_t exp_LUT[63];
+	int8_t log_LUT[64];
 	log_LUT[0] = 0xFF;
 	uint64_t g_poly;
 
@@ -35,7 +119,7 @@ int main()
 	for (int i = 1; i < 15; ++i)
 	{
 		g_poly = gf16_poly_scale(g_poly, exp_LUT[i]) ^ (g_poly << GF16_SYM_SZ);
-		printf("0x%llX,\n", g_poly);
+		printf("0x%llX,\n", (unsigned long long)g_poly);
 	}
 
 	printf("\n\nGenerating GF(8) LUTs\n");
@@ -63,4 +147,81 @@ int main()
 		g_poly = gf8_poly_scale(g_poly, exp_LUT[i]) ^ (g_poly << GF8_SYM_SZ);
 		printf("0%o,\n", (uint32_t)g_poly);
 	}
-}
\ No newline at end of file
+
+	printf("\n\nGenerating GF(32) LUTs\n");
+	printf("exp LUT:\n");
+	x = 1;
+	for (int i = 0; i < 31; ++i)
+	{
+		printf("0x%02X, ", x);
+		exp_LUT[i] = x;
+		log_LUT[x] = i;
+		x = gf32_mul2_noLUT(x);
+	}
+	printf("\nduplicate exp entries after to avoid modulo op\n");
+
+	printf("log LUT:\n");
+	for (int i = 0; i < 32; ++i)
+	{
+		printf("0x%02X, ", (uint8_t)log_LUT[i]);
+	}
+
+	printf("\nReed Solomon generator polynomials:\n");
+	gf32_poly g32 = {{1}};
+	for (int i = 0; i < 31; ++i)
+	{
+		if (i)
+			g32 = gf32_poly_add(gf32_poly_scale(g32, exp_LUT[i]), gf32_poly_shift_up(g32, 1));
+		printf("{{");
+		for (int w = 0; w < GF32_WORDS; ++w)
+			printf("0x%llX%s", (unsigned long long)g32.w[w], (w < GF32_WORDS - 1) ? ", " : "}},\n");
+	}
+
+	printf("\n\nGenerating GF(64) LUTs\n");
+	printf("exp LUT:\n");
+	x = 1;
+	for (int i = 0; i < 63; ++i)
+	{
+		printf("0x%02X, ", x);
+		exp_LUT[i] = x;
+		log_LUT[x] = i;
+		x = gf64_mul2_noLUT(x);
+	}
+	printf("\nduplicate exp entries after to avoid modulo op\n");
+
+	printf("log LUT:\n");
+	for (int i = 0; i < 64; ++i)
+	{
+		printf("0x%02X, ", (uint8_t)log_LUT[i]);
+	}
+
+	printf("\nReed Solomon generator polynomials:\n");
+	gf64_poly g64 = {{1}};
+	for (int i = 0; i < 63; ++i)
+	{
+		if (i)
+			g64 = gf64_poly_add(gf64_poly_scale(g64, exp_LUT[i]), gf64_poly_shift_up(g64, 1));
+		printf("{{");
+		for (int w = 0; w < GF64_WORDS; ++w)
+			printf("0x%llX%s", (unsigned long long)g64.w[w], (w < GF64_WORDS - 1) ? ", " : "}},\n");
+	}
+
+	printf("\n\nGenerating GF(256) LUTs\n");
+	printf("exp LUT:\n");
+	uint8_t x256 = 1;
+	uint8_t log256[256] = {0xFF};
+	for (int i = 0; i < 255; ++i)
+	{
+		printf("0x%02X, ", x256);
+		log256[x256] = i;
+		x256 = gf256_mul2_noLUT(x256);
+	}
+	printf("\nduplicate exp entries after to avoid modulo op\n");
+
+	printf("log LUT:\n");
+	for (int i = 0; i < 256; ++i)
+	{
+		printf("0x%02X, ", log256[i]);
+	}
+	printf("\nnibble split product tables are built at runtime by gf256_init()\n");
+}
@@ -0,0 +1,333 @@
+// generates marker dictionaries from rs8 or rs16 code words, picking the subset with the largest minimum bit distance
+//  between every pair of markers under every rotation and reflection, with self-similar markers left out
+//
+// markers are read as a ring of n = data + chk symbols, so a rotation is a cyclic shift by whole symbols and a
+//  reflection reverses the symbol order. The distance between two markers is the smallest Hamming distance between
+//  one and any of the 2n rotations/reflections of the other, and a marker's self distance is the same against its
+//  own transforms other than itself, which has to meet the minimum too so a rotated read can't be mistaken for
+//  another orientation of the same marker
+//
+// selection is greedy over the candidates in a seeded random order. Candidates are checked against the dictionary
+//  so far in parallel a block at a time, then the survivors of the block are accepted in order after checking them
+//  against the ones accepted earlier in the same block, giving the same dictionary as a plain sequential greedy pass.
+//  With --count the minimum distance is searched downwards from the largest possible until the dictionary has at
+//  least that many markers. If even distance 1 doesn't give that many the markers found are still printed, with a
+//  warning and exit status 2.
+//
+// eg  ./gen_markers --code 8 --data 3 --chk 4 --count 20
+//     ./gen_markers --code 16 --data 4 --chk 6 --min-dist 16 --threads 8
+#include "rs_gf8.h"
+#include "rs_gf16.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_SYMS 15				// rs16 code word length
+#define MAX_TRANSFORMS (2 * MAX_SYMS)
+#define BLOCK_CANDIDATES 4096	// candidates checked in parallel between sequential accept passes
+#define MAX_THREADS 64
+
+typedef struct
+{
+	int8_t field;		// 8 or 16
+	int8_t sym_sz;
+	int8_t n;			// symbols per marker
+	int8_t chk;
+	int8_t transforms;	// 2n, n rotations of the word and n of its reflection
+	uint64_t mask;
+} marker_code;
+
+typedef struct
+{
+	uint64_t* cand;		// candidate code words
+	int32_t cand_cnt;
+	uint64_t* dict;		// every transform of every accepted marker, transforms words per marker
+	int32_t dict_cnt;
+	int32_t dict_max;	// stop once there are this many
+	int32_t dict_cap;	// markers dict has room for, grows as needed
+	int32_t min_dist;
+} selection;
+
+typedef struct
+{
+	const selection* sel;
+	const uint8_t* self_ok;
+	uint8_t* ok;
+	int32_t begin, end;	// candidate range to check
+	int32_t dict_cnt;	// markers in the dictionary when the block started
+} check_job;
+
+static marker_code code;
+uint64_t rng_state = 0x5EED5EED5EED5EEDULL;
+
+// xorshift64*, fixed seed so the same arguments give the same dictionary
+uint64_t rng_next(void)
+{
+	rng_state ^= rng_state >> 12;
+	rng_state ^= rng_state << 25;
+	rng_state ^= rng_state >> 27;
+	return rng_state * 0x2545F4914F6CDD1DULL;
+}
+
+uint64_t rotate_syms(uint64_t w, int8_t k)
+{
+	if (!k)
+		return w;
+	int8_t shift = code.sym_sz * k;
+	return ((w >> shift) | (w << (code.sym_sz * code.n - shift))) & code.mask;
+}
+
+uint64_t reflect_syms(uint64_t w)
+{
+	uint64_t r = 0;
+	uint64_t sym_mask = (1ULL << code.sym_sz) - 1;
+	for (int8_t i = 0; i < code.n; ++i)
+	{
+		r = (r << code.sym_sz) | (w & sym_mask);
+		w >>= code.sym_sz;
+	}
+
+	return r;
+}
+
+// out[0] is always w itself
+void get_transforms(uint64_t w, uint64_t* out)
+{
+	uint64_t r = reflect_syms(w);
+	for (int8_t k = 0; k < code.n; ++k)
+	{
+		out[k] = rotate_syms(w, k);
+		out[code.n + k] = rotate_syms(r, k);
+	}
+}
+
+// smallest distance from w to its own transforms, ignoring the identity
+int32_t self_distance(uint64_t w)
+{
+	uint64_t t[MAX_TRANSFORMS];
+	get_transforms(w, t);
+	int32_t d = 64;
+	for (int8_t k = 1; k < code.transforms; ++k)
+	{
+		int32_t dk = __builtin_popcountll(w ^ t[k]);
+		d = dk < d ? dk : d;
+	}
+
+	return d;
+}
+
+// the hot kernel, xor + popcount against every transform of every marker from first up to last, bailing on the
+//  first one that's too close
+int8_t far_enough(uint64_t w, const uint64_t* dict, int32_t first, int32_t last, int32_t min_dist)
+{
+	const uint64_t* t = dict + (int64_t)first * code.transforms;
+	const uint64_t* end = dict + (int64_t)last * code.transforms;
+	for (; t < end; ++t)
+	{
+		if (__builtin_popcountll(w ^ *t) < min_dist)
+			return 0;
+	}
+
+	return 1;
+}
+
+void* check_block(void* arg)
+{
+	check_job* job = arg;
+	for (int32_t i = job->begin; i < job->end; ++i)
+		job->ok[i - job->begin] = job->self_ok[i] && far_enough(job->sel->cand[i], job->sel->dict, 0, job->dict_cnt, job->sel->min_dist);
+
+	return NULL;
+}
+
+// greedy selection at sel->min_dist, returns the number of markers found
+int32_t select_markers(selection* sel, const int32_t* self_dist, int8_t threads)
+{
+	static uint8_t ok[BLOCK_CANDIDATES];
+	uint8_t* self_ok = malloc(sel->cand_cnt);
+	for (int32_t i = 0; i < sel->cand_cnt; ++i)
+		self_ok[i] = self_dist[i] >= sel->min_dist;
+
+	sel->dict_cnt = 0;
+	for (int32_t block = 0; block < sel->cand_cnt && sel->dict_cnt < sel->dict_max; block += BLOCK_CANDIDATES)
+	{
+		int32_t block_end = block + BLOCK_CANDIDATES < sel->cand_cnt ? block + BLOCK_CANDIDATES : sel->cand_cnt;
+		int32_t block_dict = sel->dict_cnt;
+
+		pthread_t tid[MAX_THREADS];
+		check_job jobs[MAX_THREADS];
+		int32_t per_thread = (block_end - block + threads - 1) / threads;
+		for (int8_t t = 0; t < threads; ++t)
+		{
+			jobs[t].sel = sel;
+			jobs[t].self_ok = self_ok;
+			jobs[t].begin = block + t * per_thread;
+			jobs[t].end = jobs[t].begin + per_thread < block_end ? jobs[t].begin + per_thread : block_end;
+			jobs[t].ok = ok + t * per_thread;
+			jobs[t].dict_cnt = block_dict;
+			if (jobs[t].begin < jobs[t].end)
+				pthread_create(&tid[t], NULL, check_block, &jobs[t]);
+		}
+		for (int8_t t = 0; t < threads; ++t)
+		{
+			if (jobs[t].begin < jobs[t].end)
+				pthread_join(tid[t], NULL);
+		}
+
+		// only the markers accepted during this block still need checking against
+		for (int32_t i = block; i < block_end && sel->dict_cnt < sel->dict_max; ++i)
+		{
+			if (!ok[i - block] || !far_enough(sel->cand[i], sel->dict, block_dict, sel->dict_cnt, sel->min_dist))
+				continue;
+			if (sel->dict_cnt == sel->dict_cap)
+			{
+				sel->dict_cap *= 2;
+				sel->dict = realloc(sel->dict, sizeof(uint64_t) * code.transforms * sel->dict_cap);
+				if (!sel->dict)
+				{
+					fprintf(stderr, "out of memory\n");
+					exit(1);
+				}
+			}
+			get_transforms(sel->cand[i], sel->dict + (int64_t)sel->dict_cnt * code.transforms);
+			++sel->dict_cnt;
+		}
+	}
+
+	free(self_ok);
+	return sel->dict_cnt;
+}
+
+int main(int argc, char** argv)
+{
+	int8_t field = 8, data = 3, chk = 4, threads = 0;
+	int32_t min_dist = 0, count = 0, max_cand = 1 << 20;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (!strcmp(argv[i], "--code") && i + 1 < argc)
+			field = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--data") && i + 1 < argc)
+			data = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--chk") && i + 1 < argc)
+			chk = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--min-dist") && i + 1 < argc)
+			min_dist = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--count") && i + 1 < argc)
+			count = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--threads") && i + 1 < argc)
+			threads = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--candidates") && i + 1 < argc)
+			max_cand = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+			rng_state = strtoull(argv[++i], NULL, 0);
+		else
+		{
+			fprintf(stderr, "usage: %s [--code 8|16] [--data N] [--chk N] [--min-dist BITS | --count N] [--threads N]"
+				" [--candidates N] [--seed S]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	int8_t max_n = (field == 8) ? GF8_MAX : GF16_MAX;
+	int8_t max_chk = (field == 8) ? 6 : 14;	// limits of the hard coded generator tables
+	if ((field != 8 && field != 16) || data < 1 || chk < 1 || chk > max_chk || data + chk > max_n || max_cand < 1)
+	{
+		fprintf(stderr, "unsupported code, rs%d with %d data and %d check symbols\n", field, data, chk);
+		return 1;
+	}
+	if (!min_dist && !count)
+		count = 100;
+	if (threads < 1)
+	{
+		long cores = sysconf(_SC_NPROCESSORS_ONLN);
+		threads = cores < 1 ? 1 : (cores > MAX_THREADS ? MAX_THREADS : cores);
+	}
+	threads = threads > MAX_THREADS ? MAX_THREADS : threads;
+
+	code.field = field;
+	code.sym_sz = (field == 8) ? GF8_SYM_SZ : GF16_SYM_SZ;
+	code.n = data + chk;
+	code.chk = chk;
+	code.transforms = 2 * code.n;
+	code.mask = (code.sym_sz * code.n == 64) ? ~0ULL : (1ULL << (code.sym_sz * code.n)) - 1;
+
+	// every code word if there aren't too many, otherwise a random sample of distinct raw data
+	int64_t space = 1LL << (code.sym_sz * data);
+	int32_t cand_cnt = space < max_cand ? space : max_cand;
+	selection sel;
+	sel.cand_cnt = cand_cnt;
+	sel.cand = malloc(sizeof(uint64_t) * cand_cnt);
+	int32_t* self_dist = malloc(sizeof(int32_t) * cand_cnt);
+	sel.dict_max = count ? count : cand_cnt;
+	sel.dict_cap = 256;
+	sel.dict = malloc(sizeof(uint64_t) * code.transforms * sel.dict_cap);
+	if (!sel.cand || !self_dist || !sel.dict)
+	{
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+	if (space <= max_cand)
+	{
+		for (int32_t i = 0; i < cand_cnt; ++i)
+			sel.cand[i] = i;
+		for (int32_t i = cand_cnt - 1; i > 0; --i)	// Fisher-Yates so the greedy pass doesn't favour small data values
+		{
+			int32_t j = rng_next() % (i + 1);
+			uint64_t tmp = sel.cand[i];
+			sel.cand[i] = sel.cand[j];
+			sel.cand[j] = tmp;
+		}
+	}
+	else
+	{
+		for (int32_t i = 0; i < cand_cnt; ++i)	// duplicates are possible but just get rejected as too close
+			sel.cand[i] = rng_next() % space;
+	}
+	for (int32_t i = 0; i < cand_cnt; ++i)
+	{
+		sel.cand[i] = (field == 8) ? (uint64_t)rs8_encode_systematic(sel.cand[i], chk) : (uint64_t)rs16_encode_systematic(sel.cand[i], chk);
+		self_dist[i] = self_distance(sel.cand[i]);
+	}
+
+
+	struct timespec t0, t1;
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	if (min_dist)
+	{
+		sel.min_dist = min_dist;
+		select_markers(&sel, self_dist, threads);
+	}
+	else	// largest distance that still gives count markers, distance 1 is the last try since it takes every candidate
+	{
+		for (sel.min_dist = code.sym_sz * code.n; ; --sel.min_dist)
+		{
+			if (select_markers(&sel, self_dist, threads) >= count || sel.min_dist == 1)
+				break;
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+
+	fprintf(stderr, "rs%d, %d data + %d check symbols, %d candidates, %d threads: %d markers at min distance %d bits in %.3fs\n",
+		field, data, chk, cand_cnt, threads, sel.dict_cnt, sel.min_dist,
+		(t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9);
+	int8_t digits = (code.sym_sz * code.n + 3) / 4;
+	for (int32_t i = 0; i < sel.dict_cnt; ++i)
+	{
+		uint64_t cw = sel.dict[(int64_t)i * code.transforms];
+		printf("%d 0x%0*llX 0x%llX\n", i, digits, (unsigned long long)cw, (unsigned long long)(cw >> (code.sym_sz * chk)));
+	}
+
+	free(sel.cand);
+	free(self_dist);
+	free(sel.dict);
+	if (count && sel.dict_cnt < count)	// the candidates ran out first, more of them or fewer check symbols might help
+	{
+		fprintf(stderr, "only found %d of the %d markers asked for\n", sel.dict_cnt, count);
+		return 2;
+	}
+	return 0;
+}
@@ -0,0 +1,73 @@
+// runs the local decode service, see inc/rs_service.h, until SIGINT or SIGTERM. By default there's one worker per
+//  CPU, worker i pinned to CPU i, eg
+//  make rs_daemon RELEASE=1 && ./rs_daemon --name default --workers 4 --cpus 2,3,4,5
+#include "rs_service.h"
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+int main(int argc, char** argv)
+{
+	const char* name = "default";
+	long cpu_online = sysconf(_SC_NPROCESSORS_ONLN);
+	int8_t workers = cpu_online < 1 ? 1 : cpu_online > RS_SERVICE_MAX_WORKERS ? RS_SERVICE_MAX_WORKERS : cpu_online;
+	int16_t cpus[RS_SERVICE_MAX_WORKERS];
+	int8_t cpu_cnt = 0;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (!strcmp(argv[i], "--name") && i + 1 < argc)
+			name = argv[++i];
+		else if (!strcmp(argv[i], "--workers") && i + 1 < argc)
+			workers = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--cpus") && i + 1 < argc)
+		{
+			for (char* p = strtok(argv[++i], ","); p && cpu_cnt < RS_SERVICE_MAX_WORKERS; p = strtok(NULL, ","))
+				cpus[cpu_cnt++] = atoi(p);
+		}
+		else
+		{
+			fprintf(stderr, "usage: %s [--name NAME] [--workers N] [--cpus A,B,...]\n", argv[0]);
+			return 1;
+		}
+	}
+	if (workers < 1 || workers > RS_SERVICE_MAX_WORKERS)
+	{
+		fprintf(stderr, "--workers must be 1 through %d\n", RS_SERVICE_MAX_WORKERS);
+		return 1;
+	}
+	if (!cpu_cnt)
+	{
+		for (; cpu_cnt < workers; ++cpu_cnt)
+			cpus[cpu_cnt] = cpu_cnt % (cpu_online < 1 ? 1 : cpu_online);
+	}
+
+	// blocked before the workers start so they inherit the mask and the signals only ever reach sigwait() below
+	sigset_t sigs;
+	sigemptyset(&sigs);
+	sigaddset(&sigs, SIGINT);
+	sigaddset(&sigs, SIGTERM);
+	pthread_sigmask(SIG_BLOCK, &sigs, NULL);
+
+	static rs_service service;	// the batch bookkeeping is too big to want on the stack
+	int8_t r = rs_service_start(&service, name, workers, cpus, cpu_cnt);
+	if (r)
+	{
+		if (r == -2)
+			fprintf(stderr, "a daemon is already running as %s\n", name);
+		else if (r == -3)
+			fprintf(stderr, "/dev/shm/tiny_ecc.%s is from an incompatible build, remove it once its daemon has stopped\n", name);
+		else
+			fprintf(stderr, "couldn't create the segment for %s\n", name);
+		return 1;
+	}
+	printf("serving %s with %d workers\n", name, workers);
+	fflush(stdout);
+
+	int sig;
+	sigwait(&sigs, &sig);
+	rs_service_stop(&service);
+	printf("stopped\n");
+	return 0;
+}
@@ -0,0 +1,380 @@
+// channel simulator for picking chk_syms and erasure thresholds, sweeps a symbol error rate and prints frame and
+//  symbol error rates after decoding, split into failures the decoder reported and ones it didn't
+//
+// every code word is random data through rs8/rs16_encode_systematic(), then one of the channel models, then
+//  rs8/rs16_get_errata() so failures can be told apart from miscorrections:
+//  iid      every symbol is independently replaced with a wrong value with probability p
+//  burst    bursts of --burst-len wrong symbols start at each symbol with probability p / burst-len, so the symbol
+//           error rate is close to p with the errors clumped together, bursts don't carry over into the next word
+//  erasure  like iid, but each wrong symbol is flagged as an erasure with probability --erase-frac and given a
+//           random value that can happen to be right, the way a reader that knows it lost a symbol would
+//
+// a word counts as a frame error if the data delivered is wrong, where a failed decode delivers the data as
+//  received. detected is the decoder returning a failure sentinel, which also counts words where only check symbols
+//  were hit and the data came through anyway, undetected is it returning a wrong code word without one. ser is
+//  wrong data symbols delivered over data symbols sent, chan_ser is the channel's actual symbol error rate including
+//  erasures, since clipping bursts to the word makes it a little under p
+//
+// the words for each point are split into fixed chunks and every chunk gets its own PRNG seeded from the seed,
+//  the point and the chunk number, so threads take chunks in any order and the results still only depend on the
+//  seed. Within a chunk the words go through each step as a batch so each loop stays tight
+//
+// eg  ./sim_channel --code 16 --chk 4 --model burst --burst-len 3
+//     ./sim_channel --code 8 --chk 4 --model erasure --rates 0.01,0.05,0.1 --words 10000000
+#include "rs_gf8.h"
+#include "rs_gf16.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define CHUNK_WORDS 16384	// words per PRNG stream and per unit of work handed to a thread
+#define BATCH 256
+#define MAX_THREADS 64
+#define MAX_RATES 64
+
+typedef enum
+{
+	CH_IID,
+	CH_BURST,
+	CH_ERASURE
+} channel_model;
+
+typedef struct
+{
+	int8_t field;	// 8 or 16
+	int8_t sym_sz;
+	int8_t n;
+	int8_t chk;
+	uint64_t sym_mask;
+	uint64_t data_mask;
+	channel_model model;
+	int8_t burst_len;
+	uint32_t erase_thresh;	// erase_frac scaled to 2^32
+} sim_code;
+
+typedef struct
+{
+	uint64_t words;
+	uint64_t frame_err;
+	uint64_t detected;
+	uint64_t undetected;
+	uint64_t sym_err;		// wrong data symbols delivered
+	uint64_t chan_err;		// symbols the channel changed or erased
+} sim_counts;
+
+typedef struct
+{
+	const sim_code* code;
+	double rate;
+	uint64_t seed;
+	int64_t chunks;
+	int64_t* next_chunk;	// shared between the threads of one point
+	sim_counts counts;
+} sim_job;
+
+static sim_code code;
+
+uint64_t splitmix64(uint64_t x)
+{
+	x += 0x9E3779B97F4A7C15ULL;
+	x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+	return x ^ (x >> 31);
+}
+
+// xorshift64*, the state is local so every chunk has its own stream
+uint64_t rng_next(uint64_t* s)
+{
+	*s ^= *s >> 12;
+	*s ^= *s << 25;
+	*s ^= *s >> 27;
+	return *s * 0x2545F4914F6CDD1DULL;
+}
+
+// probability as a threshold for 32 random bits
+uint32_t prob_thresh(double p)
+{
+	if (p <= 0)
+		return 0;
+	if (p >= 1)
+		return UINT32_MAX;
+	return (uint32_t)(p * 4294967296.0);
+}
+
+// how many symbols of x are nonzero, by or-ing each symbol's bits down into its lowest one
+int8_t count_syms(uint64_t x, int8_t sym_sz)
+{
+	uint64_t low = 0;
+	for (int8_t b = 0; b < sym_sz; ++b)
+		low |= x >> b;
+	uint64_t ones = 0;
+	for (int8_t j = 0; j < 16; ++j)
+		ones |= 1ULL << (j * sym_sz);
+	return __builtin_popcountll(low & ones);
+}
+
+// adds the channel's errors to recv and returns the erasure flags, err_cnt gets the symbols it changed or erased.
+//  one random draw per symbol, the low half decides whether it's hit and the high half picks the wrong value
+int16_t apply_channel(const sim_code* c, uint64_t* recv, uint32_t thresh, uint64_t* s, int8_t* err_cnt)
+{
+	uint64_t err = 0;
+	int16_t e_pos = 0;
+	int8_t cnt = 0;
+	for (int8_t j = 0; j < c->n; ++j)
+	{
+		uint64_t r = rng_next(s);
+		if ((uint32_t)r >= thresh)
+			continue;
+
+		if (c->model == CH_BURST)
+		{
+			for (int8_t b = 0; b < c->burst_len && j < c->n; ++b, ++j, r = rng_next(s))
+			{
+				err |= (1 + (r >> 32) % c->sym_mask) << (j * c->sym_sz);
+				++cnt;
+			}
+			--j;	// the loop's increment moves past the burst
+		}
+		else if (c->model == CH_ERASURE && (uint32_t)rng_next(s) < c->erase_thresh)
+		{
+			err |= ((r >> 32) & c->sym_mask) << (j * c->sym_sz);
+			e_pos |= 1 << j;
+			++cnt;
+		}
+		else
+		{
+			err |= (1 + (r >> 32) % c->sym_mask) << (j * c->sym_sz);
+			++cnt;
+		}
+	}
+	*recv ^= err;
+	*err_cnt = cnt;
+	return e_pos;
+}
+
+// adds the chunk's counts to counts once at the end, the jobs' counts sit next to each other in run_point() and
+//  adding to them word by word would have the threads fighting over the same cache lines
+void run_chunk(const sim_code* c, double rate, uint64_t seed, sim_counts* counts)
+{
+	sim_counts local = {0};
+	uint64_t raw[BATCH], recv[BATCH], errata[BATCH];
+	int16_t e_pos[BATCH];
+	int8_t err_cnt[BATCH];
+	uint64_t s = splitmix64(seed) | 1;	// xorshift state can't be 0
+	uint32_t thresh = prob_thresh(c->model == CH_BURST ? rate / c->burst_len : rate);
+	int8_t r_sz = c->n * c->sym_sz;
+	int16_t tx_pos = (1 << c->n) - 1;
+
+	for (int32_t w = 0; w < CHUNK_WORDS; w += BATCH)
+	{
+		if (c->field == 8)
+		{
+			for (int32_t i = 0; i < BATCH; ++i)
+			{
+				raw[i] = rng_next(&s) & c->data_mask;
+				recv[i] = rs8_encode_systematic(raw[i], c->chk);
+			}
+		}
+		else
+		{
+			for (int32_t i = 0; i < BATCH; ++i)
+			{
+				raw[i] = rng_next(&s) & c->data_mask;
+				recv[i] = rs16_encode_systematic(raw[i], c->chk);
+			}
+		}
+
+		for (int32_t i = 0; i < BATCH; ++i)
+			e_pos[i] = apply_channel(c, &recv[i], thresh, &s, &err_cnt[i]);
+
+		if (c->field == 8)
+		{
+			for (int32_t i = 0; i < BATCH; ++i)
+				errata[i] = (uint32_t)rs8_get_errata(recv[i], r_sz, c->chk, e_pos[i], tx_pos);	// keeps -1 out of the top bits
+		}
+		else
+		{
+			for (int32_t i = 0; i < BATCH; ++i)
+				errata[i] = rs16_get_errata(recv[i], r_sz, c->chk, e_pos[i], tx_pos);
+		}
+
+		// every failure sentinel has bits set above the code word
+		for (int32_t i = 0; i < BATCH; ++i)
+		{
+			int8_t failed = (errata[i] >> r_sz) != 0;
+			uint64_t out = (failed ? recv[i] : recv[i] ^ errata[i]) >> (c->chk * c->sym_sz);
+			int8_t wrong = count_syms(out ^ raw[i], c->sym_sz);
+			local.frame_err += wrong != 0;
+			local.detected += failed;
+			local.undetected += !failed && wrong;
+			local.sym_err += wrong;
+			local.chan_err += err_cnt[i];
+		}
+		local.words += BATCH;
+	}
+
+	counts->words += local.words;
+	counts->frame_err += local.frame_err;
+	counts->detected += local.detected;
+	counts->undetected += local.undetected;
+	counts->sym_err += local.sym_err;
+	counts->chan_err += local.chan_err;
+}
+
+void* run_job(void* arg)
+{
+	sim_job* job = arg;
+	int64_t chunk;
+	while ((chunk = __atomic_fetch_add(job->next_chunk, 1, __ATOMIC_RELAXED)) < job->chunks)
+		run_chunk(job->code, job->rate, job->seed ^ splitmix64(chunk), &job->counts);
+
+	return NULL;
+}
+
+sim_counts run_point(const sim_code* c, double rate, int32_t point, uint64_t seed, int64_t words, int8_t threads)
+{
+	sim_job jobs[MAX_THREADS];
+	pthread_t tid[MAX_THREADS];
+	int64_t next_chunk = 0;
+	int64_t chunks = (words + CHUNK_WORDS - 1) / CHUNK_WORDS;
+
+	for (int8_t t = 0; t < threads; ++t)
+	{
+		jobs[t] = (sim_job){c, rate, splitmix64(seed ^ splitmix64(point)), chunks, &next_chunk, {0}};
+		pthread_create(&tid[t], NULL, run_job, &jobs[t]);
+	}
+
+	sim_counts total = {0};
+	for (int8_t t = 0; t < threads; ++t)
+	{
+		pthread_join(tid[t], NULL);
+		total.words += jobs[t].counts.words;
+		total.frame_err += jobs[t].counts.frame_err;
+		total.detected += jobs[t].counts.detected;
+		total.undetected += jobs[t].counts.undetected;
+		total.sym_err += jobs[t].counts.sym_err;
+		total.chan_err += jobs[t].counts.chan_err;
+	}
+
+	return total;
+}
+
+int main(int argc, char** argv)
+{
+	int field = 16, chk = 4, burst_len = 3, threads = 0, steps = 12;
+	double min_rate = 1e-3, max_rate = 0.3, erase_frac = 0.5;
+	double rates[MAX_RATES];
+	int rate_cnt = 0;
+	long long words = 1000000;
+	uint64_t seed = 1;
+	const char* model = "iid";
+	for (int i = 1; i < argc; ++i)
+	{
+		if (!strcmp(argv[i], "--code") && i + 1 < argc)
+			field = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--chk") && i + 1 < argc)
+			chk = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--model") && i + 1 < argc)
+			model = argv[++i];
+		else if (!strcmp(argv[i], "--burst-len") && i + 1 < argc)
+			burst_len = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--erase-frac") && i + 1 < argc)
+			erase_frac = atof(argv[++i]);
+		else if (!strcmp(argv[i], "--rates") && i + 1 < argc)
+		{
+			for (char* tok = strtok(argv[++i], ","); tok && rate_cnt < MAX_RATES; tok = strtok(NULL, ","))
+				rates[rate_cnt++] = atof(tok);
+		}
+		else if (!strcmp(argv[i], "--min-rate") && i + 1 < argc)
+			min_rate = atof(argv[++i]);
+		else if (!strcmp(argv[i], "--max-rate") && i + 1 < argc)
+			max_rate = atof(argv[++i]);
+		else if (!strcmp(argv[i], "--steps") && i + 1 < argc)
+			steps = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--words") && i + 1 < argc)
+			words = atoll(argv[++i]);
+		else if (!strcmp(argv[i], "--threads") && i + 1 < argc)
+			threads = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+			seed = strtoull(argv[++i], NULL, 0);
+		else
+		{
+			fprintf(stderr, "usage: %s [--code 8|16] [--chk N] [--model iid|burst|erasure] [--burst-len N] [--erase-frac F]"
+				" [--rates P,P,... | --min-rate P --max-rate P --steps N] [--words N] [--threads N] [--seed S]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	code.field = field;
+	code.sym_sz = (field == 8) ? GF8_SYM_SZ : GF16_SYM_SZ;
+	code.n = (field == 8) ? GF8_MAX : GF16_MAX;
+	code.chk = chk;
+	code.sym_mask = (1 << code.sym_sz) - 1;
+	code.data_mask = (1ULL << ((code.n - chk) * code.sym_sz)) - 1;
+	code.burst_len = burst_len;
+	code.erase_thresh = prob_thresh(erase_frac);
+	if (!strcmp(model, "iid"))
+		code.model = CH_IID;
+	else if (!strcmp(model, "burst"))
+		code.model = CH_BURST;
+	else if (!strcmp(model, "erasure"))
+		code.model = CH_ERASURE;
+	else
+	{
+		fprintf(stderr, "unknown model %s\n", model);
+		return 1;
+	}
+	if ((field != 8 && field != 16) || chk < 1 || chk >= code.n || burst_len < 1 || words < 1 || steps < 1)
+	{
+		fprintf(stderr, "bad code or channel parameters\n");
+		return 1;
+	}
+
+	if (threads < 1)
+		threads = sysconf(_SC_NPROCESSORS_ONLN);
+	if (threads < 1)
+		threads = 1;
+	if (threads > MAX_THREADS)
+		threads = MAX_THREADS;
+
+	if (!rate_cnt)
+	{
+		if (steps > MAX_RATES)
+			steps = MAX_RATES;
+		for (int i = 0; i < steps; ++i)	// log spaced
+			rates[rate_cnt++] = (steps == 1) ? min_rate : min_rate * pow(max_rate / min_rate, (double)i / (steps - 1));
+	}
+
+	words = (words + CHUNK_WORDS - 1) / CHUNK_WORDS * CHUNK_WORDS;
+	printf("# rs%d n %d k %d chk %d, model %s", field, code.n, code.n - chk, chk, model);
+	if (code.model == CH_BURST)
+		printf(" burst-len %d", burst_len);
+	if (code.model == CH_ERASURE)
+		printf(" erase-frac %g", erase_frac);
+	printf(", %lld words per point, seed %llu\n", words, (unsigned long long)seed);
+	printf("# %-10s %-10s %-10s %-10s %-12s %-12s %-10s %-12s %-12s\n", "p", "chan_ser", "fer", "ser",
+		"frame_err", "detected", "undetected", "undet_rate", "words/s");
+
+	for (int i = 0; i < rate_cnt; ++i)
+	{
+		struct timespec t0, t1;
+		clock_gettime(CLOCK_MONOTONIC, &t0);
+		sim_counts c = run_point(&code, rates[i], i, seed, words, threads);
+		clock_gettime(CLOCK_MONOTONIC, &t1);
+		double secs = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) * 1e-9;
+
+		printf("  %-10.3e %-10.3e %-10.3e %-10.3e %-12llu %-12llu %-10llu %-12.3e %-12.3e\n", rates[i],
+			(double)c.chan_err / ((double)c.words * code.n), (double)c.frame_err / c.words,
+			(double)c.sym_err / ((double)c.words * (code.n - chk)), (unsigned long long)c.frame_err,
+			(unsigned long long)c.detected, (unsigned long long)c.undetected, (double)c.undetected / c.words,
+			c.words / secs);
+		fflush(stdout);
+	}
+
+	return 0;
+}
@@ -1,7 +1,29 @@
 #include "rs_gf8.h"
+#include "rs_gf16.h"
+#include "rs_gf32.h"
+#include "rs_gf64.h"
+#include "rs_gf8_codec.h"
+#include "rs_gf16_codec.h"
+#include "rs_gf8x2.h"
+#include "rs_gf8_cache.h"
+#include "rs_gf8_ml.h"
+#include "rs_gf256.h"
+#include "golay24.h"
+#include "secded.h"
+#include "rs_tables.h"
+#include "rs_gf16_product.h"
+#include "rs_gf16_fec.h"
+#include "rs_batch.h"
+#include "rs_tune.h"
+#include "rs_gf8_fuse.h"
+#include "rs_service.h"
 #include "gf8.h"
 #include "gf16.h"
+#include <fcntl.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 int main()
 {
@@ -10,6 +32,7 @@ int main()
 	// TODO: do rigorous performance tests on various systems to get an idea which implementation of some functions
 	//  should be the default, ie multiplication vs shift + conditional assignement, for loop with term count tracking
 	//  vs term counting as needed vs max expected width mul/div to avoid branching, should there be an option for SIMD, etc.
+	//  apps/bench_variants.c times the variants implemented so far, both in isolation and inside the decoders
 	/*
 		r = gf8_poly_scale(0137, 3);
 		printf("%o\n", r);  //result 352
@@ -108,5 +131,286 @@ int main()
 	r = rs8_decode_systematic(00013, 21, 4, 0, 0x7F);
 	printf("%o\n", r); // result incorrect decode
 
+	// incremental redundancy, sent with 2 of 4 check symbols, 2 errors, then the other 2 check symbols appended
+	r = rs8_ir_encode(0123, 2, 4);
+	printf("%o ", r); // result 12300
+	printf("%o ", rs8_ir_decode(00300, 15, 2, 4, 0, 037)); // result incorrect decode
+	r = (00300 << 6) | rs8_ir_extend(r, 2, 4, 2);
+	printf("%o %o\n", r, rs8_ir_decode(r, 21, 4, 4, 0, 0x7F)); // result 30013 123
+	printf("%d %lld\n", rs8_ir_extend(r, 2, 4, 3), (long long)rs16_ir_encode(0x123, 5, 4)); // result -1 -1
+
+	printf("\n");
+	rs8_codec c8;
+	// same code as above built at runtime, 7 symbols, 3 data symbols
+	rs8_codec_init(&c8, 013, 1, 7, 3);
+	r = rs8_codec_encode(&c8, 0123);
+	printf("%o\n", r); // result 1230013
+
+	// 2 erasures, 1 error
+	r = rs8_codec_decode(&c8, 00013, 0b1100000);
+	printf("%o\n", r); // result 123
+
+	// primitive polynomial 1101, fcr = 0, shortened to 5 symbols with 2 data symbols
+	rs8_codec_init(&c8, 015, 0, 5, 2);
+	r = rs8_codec_encode(&c8, 045);
+	printf("%o\n", r); // result 45562
+
+	// 1 error, 1 erasure
+	r = rs8_codec_decode(&c8, 041062, 0b00100);
+	printf("%o\n", r); // result 45
+
+	// bits above the shortened code word are ignored
+	printf("%d\n", rs8_codec_get_errata(&c8, 041062 | 1 << 15, 0b00100) == rs8_codec_get_errata(&c8, 041062, 0b00100)); // result 1
+
+	// every degree 3 and 4 polynomial, only 1011, 1101, 10011 and 11001 are primitive. The reducible ones never
+	//  get back to 1 and 11111 does but only after 5 steps
+	rs16_codec c16;
+	int8_t prim8 = 0, prim16 = 0;
+	for (gf8_poly p = 010; p <= 017; ++p)
+		prim8 += rs8_codec_init(&c8, p, 1, 7, 3) == 0;
+	for (gf16_poly p = 020; p <= 037; ++p)
+		prim16 += rs16_codec_init(&c16, p, 1, 15, 11) == 0;
+	printf("%d %d\n", prim8, prim16); // result 2 2
+
+	printf("\n");
+	// 2 code words at once, 4 check symbols
+	gf8x2_poly r2 = rs8x2_encode_systematic(gf8x2_pack(0123, 045), 4);
+	printf("%o %o\n", gf8x2_get_lane(r2, 0), gf8x2_get_lane(r2, 1)); // result 1230013 452136
+
+	// 2 erasures and 1 error in lane 0, 2 errors in lane 1
+	r2 = rs8x2_decode_systematic(gf8x2_pack(00013, 0452100), 4, 0b1100000, 0x7F7F);
+	printf("%o %o\n", gf8x2_get_lane(r2, 0), gf8x2_get_lane(r2, 1)); // result 123 45
+
+	printf("\n");
+	static rs8_cache cache;
+	rs8_cache_init(&cache);
+	// same word with 2 erasures and 1 error as above read twice, then an uncorrectable one twice
+	for (int i = 0; i < 2; ++i)
+		printf("%o ", rs8_cache_decode_systematic(&cache, 00013, 21, 4, 0b1100000, 0x7F));
+	for (int i = 0; i < 2; ++i)
+		printf("%o ", (unsigned)rs8_cache_get_errata(&cache, 0111, 21, 4, 0, 0x7F) >> 30);
+	printf("%d %d\n", (int)cache.hits, (int)cache.misses); // result 123 123 3 3 2 2
+
+	// the full table for 4 check symbols against the decoder on every 127th word, then a word with 2 errors and one
+	//  with 2 erasures and 1 error that goes past the table
+	static rs8_full_table full;	// 8MB
+	rs8_full_table_init(&full, 4, 0x7F);
+	int32_t full_diff = 0;
+	for (gf8_poly w = 0; w < RS8_FULL_ENTRIES; w += 127)
+		full_diff += rs8_full_table_get_errata(&full, w, 0) != rs8_get_errata(w, 21, 4, 0, 0x7F);
+	printf("%d %o %o\n", full_diff, rs8_full_table_decode_systematic(&full, 030013, 0),
+		rs8_full_table_decode_systematic(&full, 00013, 0b1100000)); // result 0 123 123
+
+	printf("\n");
+	static rs8_ml_codebook ml;
+	int8_t best, second;
+	// every code word of 3 data and 4 check symbols, 2 errors in 1230013 then 3 errors that are as close to another code word
+	rs8_ml_init(&ml, 4, 3);
+	r = rs8_ml_decode(&ml, 01200023, 0, &best, &second);
+	printf("%o %d %d\n", r, best, second); // result 123 2 3
+	r = rs8_ml_decode(&ml, 01530040, 0, &best, &second);
+	printf("%o %d %d\n", r, best, second); // result 123 3 3
+
+	printf("\n");
+	// GF(8) and GF(16) powers including 0, the same with and without NO_LUT=1
+	printf("%d %d %d %d %d %d %d\n", gf8_pow(0, 0), gf8_pow(0, 7), gf8_pow(3, -1), gf8_pow(2, 3), gf16_pow(0, 0),
+		gf16_pow(0, 15), gf16_pow(0, 4)); // result 1 0 6 3 1 0 0
+
+	// GF(32) and GF(64), a * a^-1 and alpha^5 or alpha^6 folded back down by the primitive polynomial
+	printf("%d %d %d %d\n", gf32_mul(7, gf32_inverse(7)), gf32_2pow(5), gf64_mul(45, gf64_inverse(45)), gf64_2pow(6)); // result 1 5 1 3
+
+	// 4 check symbols, 2 errors, the second in the next word of the packed polynomial
+	gf32_poly r32 = rs32_encode_systematic((gf32_poly){{0x123}}, 4);
+	r32.w[0] ^= 7 << (2 * GF32_SYM_SZ);
+	r32.w[1] ^= 0x1F << GF32_SYM_SZ;
+	gf32_poly d32 = rs32_decode_systematic(r32, 31, 4, 0, 0x7FFFFFFF);
+	gf64_poly r64 = rs64_encode_systematic((gf64_poly){{0x123}}, 4);
+	r64.w[0] ^= 7ULL << (3 * GF64_SYM_SZ);
+	r64.w[1] ^= 0x3FULL << GF64_SYM_SZ;
+	gf64_poly d64 = rs64_decode_systematic(r64, 63, 4, 0, 0x7FFFFFFFFFFFFFFF);
+	printf("%llX %llX\n", (unsigned long long)d32.w[0], (unsigned long long)d64.w[0]); // result 123 123
+
+	// x + alpha^2 with 2 check symbols, only the first syndrome is nonzero which no error pattern fits
+	gf32_poly e32 = rs32_get_errata((gf32_poly){{4 | 1 << GF32_SYM_SZ}}, 31, 2, 0, 0x7FFFFFFF);
+	gf64_poly e64 = rs64_get_errata((gf64_poly){{4 | 1 << GF64_SYM_SZ}}, 63, 2, 0, 0x7FFFFFFFFFFFFFFF);
+	printf("%llX %llX\n", (unsigned long long)e32.w[GF32_WORDS - 1] >> 60, (unsigned long long)e64.w[GF64_WORDS - 1] >> 60); // result E E
+
+	printf("\n");
+	static rs256_codec c256;	// tables are too big for the stack
+	gf256_elem raw256[6] = {1, 2, 3, 4, 5, 6};
+	gf256_elem cw256[10];
+	// 10 symbols, 4 check symbols
+	rs256_codec_init(&c256, 10, 4);
+	rs256_encode_systematic(&c256, raw256, cw256);
+	for (int i = 0; i < 10; ++i)
+		printf("%02X ", cw256[i]);
+	printf("\n"); // result E4 9B EB E9 01 02 03 04 05 06
+
+	// 2 errors
+	cw256[1] ^= 0x55;
+	cw256[7] ^= 0x10;
+	r = rs256_decode_systematic(&c256, cw256, NULL, raw256);
+	printf("%d: ", r);
+	for (int i = 0; i < 6; ++i)
+		printf("%02X ", raw256[i]);
+	printf("\n"); // result 2: 01 02 03 04 05 06
+
+	// x + alpha^2 with 2 check symbols same as for rs32 and rs64, then 0 which has no inverse
+	rs256_codec_init(&c256, 10, 2);
+	gf256_elem lone256[10] = {4, 1}, errata256[10];
+	printf("%d %d\n", rs256_get_errata(&c256, lone256, NULL, errata256), gf256_inverse(0)); // result -2 0
+
+	printf("\n");
+	golay24_init();
+	golay24_word g = golay24_encode(0x123);
+	printf("%06X\n", g); // result 1230AC
+
+	// 3 bit errors, then 4
+	int8_t g_cnt;
+	int16_t g_data = golay24_decode(g ^ 0x800101, &g_cnt);
+	printf("%X %d\n", g_data, g_cnt); // result 123 3
+	g_data = golay24_decode(g ^ 0x800111, &g_cnt);
+	printf("%d %d\n", g_data, g_cnt); // result -1 -1
+
+	printf("\n");
+	uint64_t h_data = 0x0123456789ABCDEF;
+	uint8_t h_chk = secded64_get_chk(h_data);
+	printf("%02X\n", h_chk); // result 9C
+
+	// 1 bit error in the data, then 2
+	h_data ^= 1ULL << 40;
+	r = secded64_decode(&h_data, &h_chk);
+	printf("%d %016llX\n", r, (unsigned long long)h_data); // result 1 0123456789ABCDEF
+	h_data ^= 3ULL << 40;
+	r = secded64_decode(&h_data, &h_chk);
+	printf("%d\n", r); // result -1
+
+	// Golay tables round tripped through a table file, then the same file with a byte flipped
+	printf("\n");
+	rs_table_src t_src = {RS_TABLE_GOLAY24, 0, golay24_errata, sizeof(golay24_errata)};
+	rs_tables tab;
+	char t_path[] = "/tmp/test_tables_XXXXXX";
+	close(mkstemp(t_path));
+	r = rs_tables_write(t_path, &t_src, 1);
+	int8_t t_open = rs_tables_open(&tab, t_path, 1);
+	uint64_t t_sz = 0;
+	const uint32_t* t_errata = rs_tables_find(&tab, RS_TABLE_GOLAY24, 0, &t_sz);
+	printf("%d %d %d %d\n", r, t_open, t_sz == sizeof(golay24_errata), t_errata && t_errata[1] == golay24_errata[1]); // result 0 0 1 1
+	rs_tables_close(&tab);
+	FILE* t_file = fopen(t_path, "r+b");
+	fseek(t_file, -1, SEEK_END);
+	int t_last = fgetc(t_file);
+	fseek(t_file, -1, SEEK_END);
+	fputc(t_last ^ 1, t_file);
+	fclose(t_file);
+	printf("%d\n", rs_tables_open(&tab, t_path, 1)); // result -2
+	remove(t_path);
+
+	// 5x5 rs16 product code with 2 check symbols each way, 2 whole rows wiped out
+	printf("\n");
+	rs16_product prod;
+	gf16_poly prod_data[3] = {0x123, 0x456, 0x789};
+	gf16_poly prod_grid[5];
+	rs16_product_init(&prod, 5, 2, 5, 2);
+	rs16_product_encode(&prod, prod_data, prod_grid);
+	prod_grid[2] ^= 0x1F1F1;
+	prod_grid[3] ^= 0x11111;
+	int8_t prod_fails = rs16_product_decode(&prod, prod_grid, NULL, 4);
+	rs16_product_get_data(&prod, prod_grid, prod_data);
+	printf("%d %llX %llX %llX\n", prod_fails, (long long)prod_data[0], (long long)prod_data[1], (long long)prod_data[2]); // result 0 123 456 789
+	prod_grid[2] ^= 0x1F1F1;	// same burst again, the one column pass allowed fixes it all
+	prod_grid[3] ^= 0x11111;
+	printf("%d\n", rs16_product_decode(&prod, prod_grid, NULL, 1)); // result 0
+
+	// 3 data packets with 2 parity packets, stored in code word term order, the first and last data packets lost
+	printf("\n");
+	static rs16_fec fec;	// the inverse cache is too big for the stack
+	uint8_t fec_pkts[5][5] = {"", "", "abcd", "efgh", "ijkl"};
+	uint8_t* fec_data[3] = {fec_pkts[2], fec_pkts[3], fec_pkts[4]};
+	uint8_t* fec_parity[2] = {fec_pkts[0], fec_pkts[1]};
+	rs16_fec_init(&fec, 3, 2);
+	rs16_fec_encode(&fec, (const uint8_t* const*)fec_data, fec_parity, 4);
+	for (int8_t i = 0; i < 4; ++i)
+		fec_pkts[2][i] = fec_pkts[4][i] = 0;
+	r = rs16_fec_recover(&fec, fec_data, (const uint8_t* const*)fec_parity, 0x14, 4);
+	printf("%d %s %s %s\n", r, fec_pkts[2], fec_pkts[3], fec_pkts[4]); // result 2 abcd efgh ijkl
+
+	// mixed batch, a clean rs8 word, an rs16 word with 1 erasure and an rs8 word with 1 error
+	printf("\n");
+	rs_batch_req batch[3] = {
+		{rs8_encode_systematic(0123, 2), RS_BATCH_RS8, 2, 0, 0177},
+		{rs16_encode_systematic(0x123, 4) ^ 0x5, RS_BATCH_RS16, 4, 1, 0x7FFF},
+		{rs8_encode_systematic(0123, 2) ^ 01000, RS_BATCH_RS8, 2, 0, 0177}};
+	int64_t batch_errata[3];
+	int32_t batch_buckets[RS_BUCKET_CNT] = {0};
+	rs_batch_init();
+	rs_batch_get_errata(batch, batch_errata, 3, batch_buckets);
+	printf("%llo %llX %llo, %d %d %d %d\n", (long long)batch_errata[0], (long long)batch_errata[1], (long long)batch_errata[2],
+		batch_buckets[0], batch_buckets[1], batch_buckets[2], batch_buckets[3]); // result 0 5 1000, 1 1 1 0
+	// bits above the code word, the sign bit included, are ignored the same as by rs16_get_errata()
+	rs_batch_req batch_high = {(rs16_encode_systematic(0x123, 4) ^ 0x50) | 5LL << 61, RS_BATCH_RS16, 4, 0, 0x7FFF};
+	rs_batch_get_errata(&batch_high, batch_errata, 1, NULL);
+	printf("%d %llX\n", batch_errata[0] == rs16_get_errata(batch_high.recv, 60, 4, 0, 0x7FFF),
+		(long long)batch_errata[0]); // result 1 50
+
+	// a profile loaded without rs_tune_init() builds the tables its table variants need, and the table syndromes
+	//  ignore bits above the code word like the plain ones
+	printf("\n");
+	char tune_path[] = "/tmp/test_tune_XXXXXX";
+	FILE* tune_file = fdopen(mkstemp(tune_path), "w");
+	fprintf(tune_file, "%s %d\nrs8 2 table table\nrs16 4 table table\n", RS_TUNE_MAGIC, RS_TUNE_VERSION);
+	fclose(tune_file);
+	int8_t tune_load = rs_tune_load(tune_path);
+	gf16_poly tune_cw = rs16_tuned_encode(0x123, 4) ^ 0x500;
+	printf("%d %d %d %llo\n", tune_load, rs16_tuned_get_syndromes(tune_cw | 5LL << 61, 60, 4) == rs16_get_syndromes(tune_cw, 60, 4),
+		rs16_tuned_get_syndromes(tune_cw, 60, 4) != 0, (long long)rs8_tuned_decode(rs8_tuned_encode(012, 2) ^ 0100, 21, 2, 0, 0177)); // result 0 1 1 12
+
+	// the tuned calls agree with the plain ones whichever variants are picked, and the picks survive a save and load
+	printf("\n");
+	rs_tune_init(NULL);
+	rs16_tune[4] = (rs_tune_choice){RS_TUNE_ENC_TABLE, RS_TUNE_SYND_TABLE};
+	r = rs_tune_save(tune_path);
+	tune_load = rs_tune_init(tune_path);
+	tune_cw = rs16_tuned_encode(0x123, 4);
+	printf("%d %d %d %d %llX\n", r, tune_load, rs16_tune[4].synd, tune_cw == rs16_encode_systematic(0x123, 4),
+		(long long)rs16_tuned_decode(tune_cw ^ 0x500, 60, 4, 0, 0x7FFF)); // result 0 0 2 1 123
+	remove(tune_path);
+
+	// 3 reads of the same marker with 3 errors each so no read decodes alone, the 2 symbols wrong in 2 reads have no
+	//  majority and become erasures
+	printf("\n");
+	gf8_poly fuse_cw = rs8_encode_systematic(0123, 4);
+	gf8_poly fuse_reads[3] = {fuse_cw ^ 0111, fuse_cw ^ 0222000, fuse_cw ^ 03300003};
+	gf8_poly fuse_raw = 0;
+	r = rs8_fuse_decode(fuse_reads, NULL, 3, 21, 4, 0177, &fuse_raw);
+	printf("%d %o\n", r, fuse_raw); // result 0 123
+
+	// an encode and a decode of that word with 1 error through a decode service running in this process, then the
+	//  same decode with the sign bit and the positions past the last symbol set, which the service masks off, and
+	//  one with an op that doesn't exist
+	printf("\n");
+	static rs_service service;
+	rs_service_client svc_client;
+	rs_service_req svc_req[4] = {
+		{0x123, RS_SERVICE_ENCODE, RS_BATCH_RS16, 4, 0, 0},
+		{rs16_encode_systematic(0x123, 4) ^ 0x5000, RS_SERVICE_ERRATA, RS_BATCH_RS16, 4, 0, 0x7FFF},
+		{(rs16_encode_systematic(0x123, 4) ^ 0x5000) | INT64_MIN, RS_SERVICE_ERRATA, RS_BATCH_RS16, 4, INT16_MIN, -1},
+		{0x123, 2, RS_BATCH_RS16, 4, 0, 0}};
+	int64_t svc_res[4] = {0};
+	r = rs_service_start(&service, "test_math", 1, NULL, 0);
+	int8_t svc_conn = rs_service_connect(&svc_client, "test_math");
+	int8_t svc_call = rs_service_call(&svc_client, svc_req, svc_res, 4);
+	rs_service_disconnect(&svc_client);
+	rs_service_stop(&service);
+	printf("%d %d %d %d %llX %llX %lld\n", r, svc_conn, svc_call, svc_res[0] == rs16_encode_systematic(0x123, 4),
+		(long long)svc_res[1], (long long)svc_res[2], (long long)svc_res[3]); // result 0 0 0 1 5000 5000 -1
+
+	// a segment left behind by some other build is reported rather than taken over
+	int svc_fd = shm_open("/tiny_ecc.test_math", O_RDWR | O_CREAT | O_EXCL, 0600);
+	r = ftruncate(svc_fd, 64);
+	close(svc_fd);
+	printf("%d %d\n", r, rs_service_start(&service, "test_math", 1, NULL, 0)); // result 0 -3
+	shm_unlink("/tiny_ecc.test_math");
+
 	return 0;
-}
\ No newline at end of file
+}
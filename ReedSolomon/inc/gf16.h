@@ -21,8 +21,16 @@ typedef int8_t gf16_elem;	// a single GF(16) element, only valid in the range of
 typedef int64_t gf16_poly;	// GF(16) polynomial of order no greater than 14 (15 terms) packed in a uint64,
 // while there is room for a 16th term, there is not for its overflow and BCH view Reed Solomon is limited to 15 anyway
 
+#ifndef GF16_NO_LUT
 extern const gf16_elem gf16_exp[GF16_EXP_ENTRIES];	// length not a multiple of 2 so duplicate entries + offset needed for fast wraparound of negatives
 extern const gf16_elem gf16_log[1 + GF16_MAX];		// log_0 undefined so dummy 0xFF included to simplify indexing
+#endif
+
+// split nibble product tables for the region functions, built by gf16_region_init(). A region byte holds 2
+//  independent symbols, one per nibble, so c * byte = lo[c][byte & 0xF] ^ hi[c][byte >> 4] same as GF(256)
+extern uint8_t gf16_region_lo[1 + GF16_MAX][16];	// c * x for x in 0 through 15
+extern uint8_t gf16_region_hi[1 + GF16_MAX][16];	// (c * x) << 4 for x in 0 through 15
+
 
 gf16_elem gf16_mul2_noLUT(gf16_elem x);
 
@@ -38,12 +46,24 @@ gf16_elem gf16_inverse(gf16_elem x);
 
 gf16_poly gf16_poly_scale(gf16_poly p, gf16_elem x);
 
+gf16_poly gf16_poly_scale_select(gf16_poly p, gf16_elem x);
+
+gf16_poly gf16_poly_scale_mul(gf16_poly p, gf16_elem x);
+
 gf16_poly gf16_poly_mul(gf16_poly p, gf16_poly q);
 
+gf16_poly gf16_poly_mul_unrolled(gf16_poly p, gf16_poly q);
+
+gf16_poly gf16_poly_mul_loop(gf16_poly p, gf16_poly q);
+
 gf16_poly gf16_poly_mul_q0_monic(gf16_poly p, gf16_poly q);
 
 gf16_elem gf16_poly_eval(gf16_poly p, gf16_idx p_sz, gf16_elem x);
 
+gf16_elem gf16_poly_eval_horner(gf16_poly p, gf16_idx p_sz, gf16_elem x);
+
+gf16_elem gf16_poly_eval_mod(gf16_poly p, gf16_idx p_sz, gf16_elem x);
+
 gf16_poly gf16_poly_mod(gf16_poly p, gf16_idx p_sz, gf16_poly q, gf16_idx q_sz);
 
 gf16_poly gf16_poly_formal_derivative(gf16_poly p);
@@ -52,4 +72,10 @@ int8_t gf16_poly_get_order(gf16_poly p);
 
 gf16_idx gf16_poly_get_size(gf16_poly p);
 
+void gf16_region_init(void);
+
+void gf16_region_scale(uint8_t* dst, const uint8_t* src, gf16_elem c, int32_t len);
+
+void gf16_region_mul_add(uint8_t* dst, const uint8_t* src, gf16_elem c, int32_t len);
+
 #endif // GF16_H
\ No newline at end of file
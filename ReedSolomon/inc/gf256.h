@@ -0,0 +1,48 @@
+#ifndef GF256_H
+#define GF256_H
+
+// GF(256) field element and byte region math library
+//
+// unlike the smaller fields a GF(256) polynomial of any useful length doesn't fit in a register, so polynomials
+//  are plain byte arrays with the lowest order term at index 0, and the packed SWAR tricks are replaced by the
+//  split nibble table technique, c*x = lo[c][x & 0xF] ^ hi[c][x >> 4], which maps directly onto pshufb when
+//  SSSE3/AVX2 are available. The log/exp tables are the scalar fallback same as the other fields.
+//
+// GF(256) as defined by using primitive polynomial x^8 + x^4 + x^3 + x^2 + 1, ie 100011101 for field element
+//  reduction and the primitive field element used is 2 for the exponent and log tables
+
+#include <stdint.h>
+
+#define GF256_MAX 255					// max value a field element can have
+#define GF256_EXP_ENTRIES 2 * GF256_MAX	// number of entries in the exponent table
+
+typedef uint8_t gf256_elem;	// a single GF(256) element
+
+extern const gf256_elem gf256_exp[GF256_EXP_ENTRIES];	// length not a multiple of 2 so duplicate entries needed for fast wraparound
+extern const gf256_elem gf256_log[1 + GF256_MAX];		// log_0 undefined so dummy 0xFF included to simplify indexing
+
+// split nibble product tables, built by gf256_init() or loaded by gf256_init_from()
+extern gf256_elem gf256_mul_lo[1 + GF256_MAX][16];	// c * x for x in 0 through 15
+extern gf256_elem gf256_mul_hi[1 + GF256_MAX][16];	// c * (x << 4) for x in 0 through 15
+
+void gf256_init(void);
+
+void gf256_init_from(const gf256_elem* tables);
+
+gf256_elem gf256_mul2_noLUT(gf256_elem x);
+
+gf256_elem gf256_mul(gf256_elem a, gf256_elem b);
+
+gf256_elem gf256_div(gf256_elem a, gf256_elem b);
+
+gf256_elem gf256_pow(gf256_elem x, int16_t power);
+
+gf256_elem gf256_inverse(gf256_elem x);
+
+void gf256_region_scale(gf256_elem* dst, const gf256_elem* src, gf256_elem c, int32_t len);
+
+void gf256_region_mul_add(gf256_elem* dst, const gf256_elem* src, gf256_elem c, int32_t len);
+
+gf256_elem gf256_poly_eval(const gf256_elem* p, int16_t p_len, gf256_elem x);
+
+#endif // GF256_H
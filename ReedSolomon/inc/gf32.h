@@ -0,0 +1,71 @@
+#ifndef GF32_H
+#define GF32_H
+
+// GF(32) field element and polynomial math library
+//
+// polynomials are packed as consecutive 5 bit terms with lowest order terms in the least significant bits,
+//  a full 31 term codeword is 155 bits so it's spread over 3 uint64 words of 12 terms each, leaving the top
+//  4 bits of every word free for the overflow of its highest term which keeps the single word SWAR tricks of
+//  gf16.c working unchanged on each word. Terms never straddle a word, so unlike gf8.c and gf16.c all sizes and
+//  indices here are in TERMS not bits.
+//
+// GF(32) as defined by using primitive polynomial 1x^5 + 0x^4 + 0x^3 + 1x^2 + 0x^1 + 1x^0, ie 100101 for field
+//  element reduction and the primitive field element used is 2 for the exponent and log tables
+
+#include <stdint.h>
+
+#define GF32_SYM_SZ 5					// how many bits to shift to move 1 symbol within a word
+#define GF32_MAX 31						// max value a field element can have
+#define GF32_EXP_ENTRIES 2 * GF32_MAX	// number of entries in the exponent table
+#define GF32_WORD_TERMS 12				// terms per uint64 word, 60 bits + 4 bits of overflow room
+#define GF32_WORDS 3					// enough words for 31 terms
+
+typedef int8_t gf32_idx;	// represents a polynomial term index or size in terms of TERMS
+typedef int8_t gf32_elem;	// a single GF(32) element, only valid in the range of 0 through 31
+typedef struct
+{
+	uint64_t w[GF32_WORDS];	// w[0] holds terms 0 through 11, w[1] 12 through 23, w[2] 24 through 35
+} gf32_poly;
+
+extern const gf32_elem gf32_exp[GF32_EXP_ENTRIES];	// length not a multiple of 2 so duplicate entries + offset needed for fast wraparound of negatives
+extern const gf32_elem gf32_log[1 + GF32_MAX];		// log_0 undefined so dummy -1 included to simplify indexing
+
+gf32_elem gf32_mul2_noLUT(gf32_elem x);
+
+gf32_elem gf32_mul(gf32_elem a, gf32_elem b);
+
+gf32_elem gf32_div(gf32_elem a, gf32_elem b);
+
+gf32_elem gf32_pow(gf32_elem x, int8_t power);
+
+gf32_elem gf32_2pow(int8_t power);
+
+gf32_elem gf32_inverse(gf32_elem x);
+
+gf32_elem gf32_poly_get_term(gf32_poly p, gf32_idx i);
+
+gf32_poly gf32_poly_shift_up(gf32_poly p, gf32_idx n);
+
+gf32_poly gf32_poly_shift_down(gf32_poly p, gf32_idx n);
+
+gf32_poly gf32_poly_truncate(gf32_poly p, gf32_idx p_len);
+
+gf32_poly gf32_poly_add(gf32_poly p, gf32_poly q);
+
+int8_t gf32_poly_is_zero(gf32_poly p);
+
+gf32_poly gf32_poly_scale(gf32_poly p, gf32_elem x);
+
+gf32_poly gf32_poly_mul(gf32_poly p, gf32_poly q);
+
+gf32_elem gf32_poly_eval(gf32_poly p, gf32_idx p_len, gf32_elem x);
+
+gf32_poly gf32_poly_mod(gf32_poly p, gf32_idx p_len, gf32_poly q, gf32_idx q_len);
+
+gf32_poly gf32_poly_formal_derivative(gf32_poly p);
+
+int8_t gf32_poly_get_order(gf32_poly p);
+
+gf32_idx gf32_poly_get_size(gf32_poly p);
+
+#endif // GF32_H
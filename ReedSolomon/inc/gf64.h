@@ -0,0 +1,71 @@
+#ifndef GF64_H
+#define GF64_H
+
+// GF(64) field element and polynomial math library
+//
+// polynomials are packed as consecutive 6 bit terms with lowest order terms in the least significant bits,
+//  a full 63 term codeword is 378 bits so it's spread over 7 uint64 words of 9 terms each, leaving the top
+//  10 bits of every word free. The lowest 5 of those take the overflow of its highest term, which keeps the
+//  single word SWAR tricks of gf16.c working unchanged on each word. Terms never straddle a word, so unlike gf8.c
+//  and gf16.c all sizes and indices here are in TERMS not bits.
+//
+// GF(64) as defined by using primitive polynomial 1x^6 + 1x^1 + 1x^0, ie 1000011 for field
+//  element reduction and the primitive field element used is 2 for the exponent and log tables
+
+#include <stdint.h>
+
+#define GF64_SYM_SZ 6					// how many bits to shift to move 1 symbol within a word
+#define GF64_MAX 63						// max value a field element can have
+#define GF64_EXP_ENTRIES 2 * GF64_MAX	// number of entries in the exponent table
+#define GF64_WORD_TERMS 9				// terms per uint64 word, 54 bits with the 5 above them for overflow
+#define GF64_WORDS 7					// enough words for 63 terms
+
+typedef int8_t gf64_idx;	// represents a polynomial term index or size in terms of TERMS
+typedef int8_t gf64_elem;	// a single GF(64) element, only valid in the range of 0 through 63
+typedef struct
+{
+	uint64_t w[GF64_WORDS];	// w[0] holds terms 0 through 8, w[1] 9 through 17 and so on
+} gf64_poly;
+
+extern const gf64_elem gf64_exp[GF64_EXP_ENTRIES];	// length not a multiple of 2 so duplicate entries + offset needed for fast wraparound of negatives
+extern const gf64_elem gf64_log[1 + GF64_MAX];		// log_0 undefined so dummy -1 included to simplify indexing
+
+gf64_elem gf64_mul2_noLUT(gf64_elem x);
+
+gf64_elem gf64_mul(gf64_elem a, gf64_elem b);
+
+gf64_elem gf64_div(gf64_elem a, gf64_elem b);
+
+gf64_elem gf64_pow(gf64_elem x, int8_t power);
+
+gf64_elem gf64_2pow(int8_t power);
+
+gf64_elem gf64_inverse(gf64_elem x);
+
+gf64_elem gf64_poly_get_term(gf64_poly p, gf64_idx i);
+
+gf64_poly gf64_poly_shift_up(gf64_poly p, gf64_idx n);
+
+gf64_poly gf64_poly_shift_down(gf64_poly p, gf64_idx n);
+
+gf64_poly gf64_poly_truncate(gf64_poly p, gf64_idx p_len);
+
+gf64_poly gf64_poly_add(gf64_poly p, gf64_poly q);
+
+int8_t gf64_poly_is_zero(gf64_poly p);
+
+gf64_poly gf64_poly_scale(gf64_poly p, gf64_elem x);
+
+gf64_poly gf64_poly_mul(gf64_poly p, gf64_poly q);
+
+gf64_elem gf64_poly_eval(gf64_poly p, gf64_idx p_len, gf64_elem x);
+
+gf64_poly gf64_poly_mod(gf64_poly p, gf64_idx p_len, gf64_poly q, gf64_idx q_len);
+
+gf64_poly gf64_poly_formal_derivative(gf64_poly p);
+
+int8_t gf64_poly_get_order(gf64_poly p);
+
+gf64_idx gf64_poly_get_size(gf64_poly p);
+
+#endif // GF64_H
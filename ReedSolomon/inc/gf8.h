@@ -20,8 +20,10 @@ typedef int8_t gf8_idx;		// represents a polynomial term index or size in terms
 typedef int8_t gf8_elem;	// a single GF(8) element, only valid in the range of 0 through 7
 typedef int32_t gf8_poly;	// GF(8) polynomial of order no greater than 9 (10 terms) packed in a uint32
 
+#ifndef GF8_NO_LUT
 extern const gf8_elem gf8_exp[GF8_EXP_ENTRIES];	// length not a multiple of 2 so duplicate entries + offset needed for fast wraparound of negatives
 extern const gf8_elem gf8_log[1 + GF8_MAX];		// log_0 undefined so dummy 0xFF included to simplify indexing
+#endif
 
 gf8_elem gf8_mul2_noLUT(gf8_elem x);
 
@@ -37,12 +39,24 @@ gf8_elem gf8_inverse(gf8_elem x);
 
 gf8_poly gf8_poly_scale(gf8_poly p, gf8_elem x);
 
+gf8_poly gf8_poly_scale_select(gf8_poly p, gf8_elem x);
+
+gf8_poly gf8_poly_scale_mul(gf8_poly p, gf8_elem x);
+
 gf8_poly gf8_poly_mul(gf8_poly p, gf8_poly q);
 
+gf8_poly gf8_poly_mul_unrolled(gf8_poly p, gf8_poly q);
+
+gf8_poly gf8_poly_mul_loop(gf8_poly p, gf8_poly q);
+
 gf8_poly gf8_poly_mul_q0_monic(gf8_poly p, gf8_poly q);
 
 gf8_elem gf8_poly_eval(gf8_poly p, gf8_idx p_sz, gf8_elem x);
 
+gf8_elem gf8_poly_eval_horner(gf8_poly p, gf8_idx p_sz, gf8_elem x);
+
+gf8_elem gf8_poly_eval_mod(gf8_poly p, gf8_idx p_sz, gf8_elem x);
+
 gf8_poly gf8_poly_mod(gf8_poly p, gf8_idx p_sz, gf8_poly q, gf8_idx q_sz);
 
 gf8_poly gf8_poly_formal_derivative(gf8_poly p);
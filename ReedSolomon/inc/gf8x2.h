@@ -0,0 +1,33 @@
+#ifndef GF8X2_H
+#define GF8X2_H
+
+// dual lane GF(8) polynomial math, 2 independent gf8_polys side by side in a uint64
+//
+// lane 0 is bits 0 through 31 and lane 1 is bits 32 through 63, each laid out exactly like a gf8_poly. A full
+//  rs8 code word is only 21 bits so there's always room above it for the 2 bits of overflow that gf8_poly_scale()
+//  shifts into before folding, which keeps every lane's overflow from spilling into its neighbour and lets the
+//  same SWAR masks from gf8.c work on both lanes with a single set of instructions.
+// 3 lanes would need 3 * (21 + 2) = 69 bits so 2 is the most that fits for full length codes
+//
+// scalars are packed the same way, each lane's element in the low 3 bits of that lane
+
+#include <stdint.h>
+#include "gf8.h"
+
+#define GF8X2_LANE_SZ 32					// how many bits to shift to move 1 lane
+#define GF8X2_LANE 0xFFFFFFFFULL			// mask for a single lane
+#define GF8X2_LANE_LO 0x0000000100000001ULL	// bit 0 of each lane, multiply to broadcast a lane mask to both lanes
+
+typedef uint64_t gf8x2_poly;	// 2 gf8_polys packed in a uint64, unsigned so shifts never smear the sign between lanes
+
+gf8x2_poly gf8x2_pack(gf8_poly lane0, gf8_poly lane1);
+
+gf8_poly gf8x2_get_lane(gf8x2_poly p, int8_t lane);
+
+gf8x2_poly gf8x2_poly_scale(gf8x2_poly p, gf8x2_poly x);
+
+gf8x2_poly gf8x2_poly_mul_terms(gf8x2_poly p, gf8x2_poly q);
+
+gf8x2_poly gf8x2_poly_mod(gf8x2_poly p, gf8_idx p_sz, gf8x2_poly q, gf8_idx q_sz);
+
+#endif // GF8X2_H
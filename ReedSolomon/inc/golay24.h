@@ -0,0 +1,48 @@
+#ifndef GOLAY24_H
+#define GOLAY24_H
+
+// extended binary Golay (24,12) code, corrects any 3 bit errors in a 24 bit word and detects 4
+//
+// systematic like the Reed Solomon modules, the 12 data bits sit above the 12 check bits in the low 24 bits of a
+//  uint32. The check bits are the remainder of data * x^11 mod the (23,12) Golay generator x^11 + x^10 + x^6 + x^5
+//  + x^4 + x^2 + 1 shifted up 1, with an overall parity bit at the bottom.
+//
+// everything goes through 2 tables of 4096 entries built by golay24_init() or loaded by golay24_init_from(), one
+//  of which has to be called first:
+//  golay24_chk[] maps 12 data bits to their check bits, and since the code is linear the syndrome of a received
+//  word is just its check bits xor golay24_chk[] of its data bits. golay24_errata[] then maps each of the 4096
+//  syndromes to its error pattern, which covers every pattern of up to 3 bits exactly once, with the number of
+//  bit errors in the top byte. The rest of the syndromes are 4 bit errors which can't be told apart and
+//  come back as GOLAY24_FAIL.
+//
+// the batch versions do 8 words at a time with AVX2 gathers from the same tables when available
+
+#include <stdint.h>
+
+#define GOLAY24_DATA_BITS 12
+#define GOLAY24_MASK 0xFFFFFF
+#define GOLAY24_DATA_MASK 0xFFF
+#define GOLAY24_FAIL 0xFF000000	// errata for an uncorrectable word, the top byte read as an int8_t is -1
+
+typedef uint32_t golay24_word;
+
+extern uint16_t golay24_chk[1 + GOLAY24_DATA_MASK + 1];	// 1 extra entry so a 4 byte gather of the last one stays in bounds
+extern uint32_t golay24_errata[1 + GOLAY24_DATA_MASK];	// error pattern | bit error count << 24, by syndrome
+
+void golay24_init(void);
+
+void golay24_init_from(const void* tables);
+
+golay24_word golay24_encode(uint16_t data);
+
+uint16_t golay24_get_syndrome(golay24_word recv);
+
+uint32_t golay24_get_errata(golay24_word recv);
+
+int16_t golay24_decode(golay24_word recv, int8_t* err_cnt);
+
+void golay24_encode_batch(const uint16_t* data, golay24_word* cw, int32_t n);
+
+int32_t golay24_decode_batch(const golay24_word* recv, uint16_t* data, int8_t* err_cnt, int32_t n);
+
+#endif // GOLAY24_H
@@ -0,0 +1,57 @@
+#ifndef RS_BATCH_H
+#define RS_BATCH_H
+
+// batched front end for decoding a mix of rs8 and rs16 code words with different parameters
+//
+// the lane kernels only pay off when every lane takes the same path, rs8x2 needs both lanes to share chk_syms and
+//  a clean word sitting next to one that needs the full decoder wastes the lane either way. So the requests are
+//  first sorted by shape, the field and chk_syms, and the syndromes of each shape group are computed together,
+//  rs8 2 words at a time through rs8x2_get_syndromes() and rs16 through rs16_get_syndromes_table(). That first
+//  stage puts every word in one of the buckets below and each bucket then goes through the cheapest kernel that
+//  gives the right answer for it:
+//   clean words are done, the errata is 0
+//   words with erasures whose Forney syndromes beyond the erasures are all 0 have no errors left to find, so they
+//    skip Berlekamp-Massey and the Chien search and go straight to the Forney magnitudes
+//   everything else goes through rs*_get_errata_synd() with the syndromes already computed
+// results are written back in request order and are exactly what rs8_get_errata() or rs16_get_errata() would
+//  return for each request, failure sentinels included. rs8 results are the gf8_poly cast to int64_t, so cast
+//  back with (gf8_poly) before checking the sentinels.
+//
+// requests go through in chunks of RS_BATCH_MAX with all the bookkeeping on the stack, so any length works and
+//  it's safe to call from several threads at once. rs_batch_init() is optional, it just builds the shared rs16
+//  syndrome table up front instead of on the first call
+
+#include <stdint.h>
+
+#define RS_BATCH_MAX 256	// requests bucketed together at a time
+
+typedef enum
+{
+	RS_BATCH_RS8,
+	RS_BATCH_RS16,
+	RS_BATCH_CODES
+} rs_batch_code;
+
+typedef enum
+{
+	RS_BUCKET_CLEAN,	// syndromes all 0
+	RS_BUCKET_ERASURE,	// erasures explain the syndromes, Forney only
+	RS_BUCKET_ERRORS,	// the full decoder, whether or not it succeeds
+	RS_BUCKET_FAILED,	// more erasures than check symbols, -1 without doing anything
+	RS_BUCKET_CNT
+} rs_batch_bucket;
+
+typedef struct
+{
+	int64_t recv;		// the received word, packed the same as for rs8_get_errata() or rs16_get_errata()
+	int8_t code;		// rs_batch_code
+	int8_t chk_syms;
+	int16_t e_pos;
+	int16_t tx_pos;
+} rs_batch_req;
+
+void rs_batch_init(void);
+
+void rs_batch_get_errata(const rs_batch_req* req, int64_t* errata, int32_t cnt, int32_t* bucket_cnt);
+
+#endif // RS_BATCH_H
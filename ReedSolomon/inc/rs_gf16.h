@@ -13,4 +13,46 @@ gf16_poly rs16_decode_systematic(gf16_poly recv, gf16_idx r_sz, int8_t chk_syms,
 
 gf16_poly rs16_get_errata(gf16_poly recv, gf16_idx r_sz, int8_t chk_syms, int16_t e_pos, int16_t tx_pos);
 
+gf16_poly rs16_get_syndromes(gf16_poly p, gf16_idx p_sz, int8_t nsyms);
+
+// syndromes 1 through 15 of symbol value v at position i, same order as rs16_get_syndromes(), shared by the table
+//  driven syndrome paths in rs_batch, rs_tune and rs_gf16_product. Built by rs16_synd_lut_init()
+extern gf16_poly rs16_synd_lut[GF16_MAX][1 + GF16_MAX];
+
+void rs16_synd_lut_init(void);
+
+gf16_poly rs16_get_syndromes_table(gf16_poly p, gf16_idx p_sz, int8_t nsyms);
+
+gf16_poly rs16_get_errata_synd(gf16_poly synd, int8_t chk_syms, int16_t e_pos, int16_t tx_pos);
+
+gf16_poly rs16_get_erasure_locator(int16_t erase_pos);
+
+gf16_poly rs16_get_erasure_locator_mask(int16_t erase_pos);
+
+gf16_poly rs16_get_erasure_locator_list(const int8_t* erase_list, int8_t erase_cnt);
+
+gf16_poly rs16_get_errata_evaluator(gf16_poly synd, gf16_idx chk_sz, gf16_poly errata_loc);
+
+gf16_poly rs16_get_errata_magnitude(gf16_poly errata_eval, gf16_idx chk_sz, gf16_poly errata_loc, int16_t errata_pos);
+
+// incremental redundancy: a code word with chk_syms check symbols can't be upgraded to more by just sending extra
+//  symbols, the remainder for the bigger generator changes every check symbol, and symbols appended to a word
+//  that's already a code word for the first chk_syms roots would have to be 0 for it to stay one for the new roots.
+//  So it goes the other way round: words are encoded once with the most check symbols that could ever be sent,
+//  max_chk, and the first transmission leaves out the lowest max_chk - chk_syms of them. The receiver decodes it
+//  with those as erasures, which corrects exactly as much as a plain chk_syms code, and on failure asks for more.
+//  rs16_ir_extend() gives the next missing symbols, which go below what's been received so far,
+//  ie recv = recv << extra_syms*GF16_SYM_SZ | extra with e_pos and tx_pos shifted up by extra_syms to match
+//  rs16_ir_extend() re-encodes the data in sent with all max_chk check symbols and keeps the ones asked for, so it
+//  costs a full encode however few it returns. The remainder for the smaller generators doesn't give the lower
+//  check symbols, so there's nothing cheaper short of per-symbol parity tables, and a sender that keeps the
+//  rs16_encode_systematic() word at max_chk around can just shift the next symbols out of that instead
+gf16_poly rs16_ir_encode(gf16_poly raw, int8_t chk_syms, int8_t max_chk);
+
+gf16_poly rs16_ir_extend(gf16_poly sent, int8_t chk_syms, int8_t max_chk, int8_t extra_syms);
+
+gf16_poly rs16_ir_get_errata(gf16_poly recv, gf16_idx r_sz, int8_t chk_syms, int8_t max_chk, int16_t e_pos, int16_t tx_pos);
+
+gf16_poly rs16_ir_decode(gf16_poly recv, gf16_idx r_sz, int8_t chk_syms, int8_t max_chk, int16_t e_pos, int16_t tx_pos);
+
 #endif // RS_GF16_H
\ No newline at end of file
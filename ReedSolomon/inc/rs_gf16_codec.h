@@ -0,0 +1,60 @@
+#ifndef RS_GF16_CODEC_H
+#define RS_GF16_CODEC_H
+
+// Configurable BCH view, systematic encoding Reed Solomon using 4 bit symbols
+//
+// Unlike rs_gf16.h which is hard wired to primitive polynomial 10011, fcr = 1 and the full 15 symbol block,
+//  everything here is derived once by rs16_codec_init() from the primitive polynomial, first consecutive root,
+//  and the shortened code length n and data length k, then passed by const pointer to every call.
+//  Packed polynomials keep the same layout as gf16.h and the shortened padding terms (n and above) are never
+//  evaluated or searched, they're simply folded away by the masks held in the codec.
+
+#include <stdint.h>
+#include "gf16.h"
+
+#define RS16_CODEC_EXP_ENTRIES 3 * GF16_MAX	// 3 periods so log sums from Forney never need a modulo
+#define RS16_CODEC_RED_MAX 2 * GF16_SYM_SZ - 2	// max number of distinct shifts needed to fold overflow back into a term
+
+typedef struct
+{
+	gf16_elem exp[RS16_CODEC_EXP_ENTRIES];	// exp table for the chosen primitive polynomial, repeated to avoid modulo ops
+	gf16_elem log[1 + GF16_MAX];				// log_0 undefined so dummy -1 included to simplify indexing
+	gf16_poly red_mask[RS16_CODEC_RED_MAX];	// overflow bits that fold back down into their term by a right shift of red_shift
+	int8_t red_shift[RS16_CODEC_RED_MAX];
+	int8_t red_cnt;							// number of valid mask/shift pairs, 2 for 10011
+	gf16_elem synd_root[GF16_MAX];			// alpha^(fcr + i) for syndrome i
+	gf16_elem root_inv[GF16_MAX];				// X(p)^-1 = alpha^-p for codeword position p, the Chien/Forney eval points
+	gf16_elem forney_log[GF16_MAX];			// log of the X(p)^(1-fcr) term of Forney, all 0 when fcr = 1
+	gf16_poly g_poly;						// generator polynomial, prod(x - alpha^(fcr + i)) for i in [0, chk_syms)
+	gf16_poly msg_mask;						// valid data bits before shifting into place
+	gf16_poly prime;
+	gf16_idx n_sz;							// sizes in BITS not symbols, same as everywhere else
+	gf16_idx chk_sz;
+	int16_t tx_pos;							// set bits for the transmitted positions, ie everything below n
+	int8_t fcr;
+	int8_t n;
+	int8_t k;
+	int8_t chk_syms;
+} rs16_codec;
+
+int8_t rs16_codec_init(rs16_codec* c, gf16_poly prime, int8_t fcr, int8_t n, int8_t k);
+
+gf16_poly rs16_codec_encode(const rs16_codec* c, gf16_poly raw);
+
+gf16_poly rs16_codec_decode(const rs16_codec* c, gf16_poly recv, int16_t e_pos);
+
+gf16_poly rs16_codec_get_errata(const rs16_codec* c, gf16_poly recv, int16_t e_pos);
+
+gf16_elem rs16_codec_mul(const rs16_codec* c, gf16_elem a, gf16_elem b);
+
+gf16_elem rs16_codec_div(const rs16_codec* c, gf16_elem a, gf16_elem b);
+
+gf16_poly rs16_codec_poly_scale(const rs16_codec* c, gf16_poly p, gf16_elem x);
+
+gf16_poly rs16_codec_poly_mul(const rs16_codec* c, gf16_poly p, gf16_poly q);
+
+gf16_elem rs16_codec_poly_eval(const rs16_codec* c, gf16_poly p, gf16_idx p_sz, gf16_elem x);
+
+gf16_poly rs16_codec_poly_mod(const rs16_codec* c, gf16_poly p, gf16_idx p_sz, gf16_poly q, gf16_idx q_sz);
+
+#endif // RS_GF16_CODEC_H
@@ -0,0 +1,47 @@
+#ifndef RS_GF16_FEC_H
+#define RS_GF16_FEC_H
+
+// packet level erasure code built out of rs16 code words, for links that lose whole packets rather than symbols
+//
+// data_cnt data packets of len bytes get parity_cnt parity packets of the same length, data_cnt + parity_cnt no more
+//  than 15. Every nibble column across the packets, ie the low or high nibble of byte b of each packet, is one
+//  systematic rs16 code word with parity packet j as term j and data packet i as term parity_cnt + i, the same
+//  layout rs16_encode_systematic() gives. Lost packets are given as a mask of those terms, same as e_pos, and any
+//  parity_cnt of them can be rebuilt.
+//
+// nothing is decoded one code word at a time though, the code is linear so every parity packet is a fixed
+//  combination of the data packets and encoding is parity_cnt * data_cnt gf16_region_mul_add() calls over whole
+//  packets. Recovery picks data_cnt packets that arrived, inverts the matrix taking the data to them and applies
+//  the rows for the lost data packets the same way. Inverting is by far the slowest part so the inverses are cached
+//  in the context by which packets they start from, a link that keeps losing the same packets pays for it once.
+//  The cache makes rs16_fec_recover() modify the context, so each thread needs its own
+
+#include <stdint.h>
+#include "gf16.h"
+
+#define RS16_FEC_CACHE 64	// cached inverses, direct mapped so must be a power of 2
+
+typedef struct
+{
+	int16_t key;		// positions the rows rebuild from, -1 for an empty slot
+	int8_t row_cnt;
+	int8_t src[GF16_MAX];	// those positions in increasing order, data_cnt of them
+	int8_t dst[GF16_MAX];	// data packet rebuilt by each row
+	gf16_elem coef[GF16_MAX][GF16_MAX];	// coef[r][s] is the factor on position src[s] for packet dst[r]
+} rs16_fec_inv;
+
+typedef struct
+{
+	int8_t data_cnt;
+	int8_t parity_cnt;
+	gf16_elem enc[GF16_MAX][GF16_MAX];	// enc[j][i] is the factor on data packet i in parity packet j
+	rs16_fec_inv cache[RS16_FEC_CACHE];
+} rs16_fec;
+
+int8_t rs16_fec_init(rs16_fec* f, int8_t data_cnt, int8_t parity_cnt);
+
+void rs16_fec_encode(const rs16_fec* f, const uint8_t* const* data, uint8_t* const* parity, int32_t len);
+
+int8_t rs16_fec_recover(rs16_fec* f, uint8_t* const* data, const uint8_t* const* parity, int16_t lost, int32_t len);
+
+#endif // RS_GF16_FEC_H
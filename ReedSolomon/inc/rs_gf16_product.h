@@ -0,0 +1,41 @@
+#ifndef RS_GF16_PRODUCT_H
+#define RS_GF16_PRODUCT_H
+
+// 2 dimensional product code built out of rs16 code words, for payloads bigger than a single 15 symbol word and
+//  bursts longer than one word can correct
+//
+// the grid is col_n rows of row_n symbols, each row packed into a gf16_poly the same as any other rs16 code word.
+//  Every row is a code word with row_chk check symbols and every column, read with row i as symbol i, is a code
+//  word with col_chk check symbols, so the lowest col_chk rows are checks on the columns and the data is the top
+//  col_n - col_chk rows minus their row_chk check symbols. The codes are linear so the checks on checks agree
+//  whichever way round they're worked out.
+//
+// decoding alternates a pass over all the rows with a pass over all the columns. Rows that fail to decode become
+//  erasures in every column and columns that fail become erasures in every row through the usual e_pos, so a burst
+//  that wipes out up to col_chk whole rows still comes back. Each pass computes the syndromes of every line in one
+//  batch first and only the lines that aren't already code words go through the rest of the decoder. Those
+//  syndromes come from rs16_get_syndromes_table(), whose table rs16_product_init() makes sure is built, so a
+//  line's syndromes are just 1 lookup and xor per symbol
+
+#include <stdint.h>
+#include "gf16.h"
+
+typedef struct
+{
+	int8_t row_n;	// symbols per row, up to GF16_MAX
+	int8_t row_chk;
+	int8_t col_n;	// rows in the grid, ie symbols per column
+	int8_t col_chk;
+} rs16_product;
+
+int8_t rs16_product_init(rs16_product* p, int8_t row_n, int8_t row_chk, int8_t col_n, int8_t col_chk);
+
+void rs16_product_encode(const rs16_product* p, const gf16_poly* data, gf16_poly* grid);
+
+int8_t rs16_product_decode(const rs16_product* p, gf16_poly* grid, const int16_t* e_pos, int8_t max_iter);
+
+void rs16_product_get_data(const rs16_product* p, const gf16_poly* grid, gf16_poly* data);
+
+void rs16_product_transpose(const gf16_poly* in, int8_t in_cnt, int8_t in_n, gf16_poly* out);
+
+#endif // RS_GF16_PRODUCT_H
@@ -0,0 +1,52 @@
+#ifndef RS_GF256_H
+#define RS_GF256_H
+
+// BCH view, systematic encoding Reed Solomon using 8 bit symbols
+// defined to use first consecutive root, c = 1 same as rs_gf16.h
+//
+// code words are byte arrays with term i at index i, so the check symbols are cw[0] through cw[chk_syms - 1]
+//  and the data follows, same order as the packed versions. Any n up to 255 works, shortened codes simply
+//  have fewer terms. Position masks are 4 uint64 words with bit i of word i / 64 for term i.
+//
+// everything that depends on n and chk_syms is precomputed by rs256_codec_init() in nibble split form so the
+//  encode, syndrome and Chien search inner loops are a pair of table shuffles per symbol
+
+#include <stdint.h>
+#include "gf256.h"
+
+#define RS256_MAX_N 255
+#define RS256_MAX_CHK 32				// 2 SSE vectors worth of check symbols
+#define RS256_MAX_ERRS RS256_MAX_CHK / 2
+#define RS256_POS_WORDS 4				// uint64 words in a position mask
+
+// failure returns, matching the sentinels of the packed versions in meaning
+#define RS256_FAIL_ERASURES -1	// more erasures than check symbols
+#define RS256_FAIL_ORDER -2		// error locator order beyond the Singleton Bound
+#define RS256_FAIL_ROOTS -3		// not enough or too many roots
+
+typedef struct
+{
+	gf256_elem enc_lo[RS256_MAX_N][RS256_MAX_CHK];	// x^(chk_syms + j) mod g for data term j, low nibbles
+	gf256_elem enc_hi[RS256_MAX_N][RS256_MAX_CHK];	// and high nibbles
+	gf256_elem synd_lo[RS256_MAX_N][RS256_MAX_CHK];	// alpha^((1 + s) * i) for received term i and syndrome s
+	gf256_elem synd_hi[RS256_MAX_N][RS256_MAX_CHK];
+	gf256_elem chien_lo[RS256_MAX_ERRS + 1][RS256_MAX_N + 1];	// alpha^(-p * t) for locator term t at position p
+	gf256_elem chien_hi[RS256_MAX_ERRS + 1][RS256_MAX_N + 1];
+	gf256_elem g_poly[RS256_MAX_CHK + 1];
+	int16_t n;
+	int16_t k;
+	int8_t chk_syms;
+	int8_t chk_vecs;	// 16 byte vectors needed to hold chk_syms terms
+} rs256_codec;
+
+int8_t rs256_codec_init(rs256_codec* c, int16_t n, int8_t chk_syms);
+
+void rs256_encode_systematic(const rs256_codec* c, const gf256_elem* raw, gf256_elem* cw);
+
+void rs256_get_syndromes(const rs256_codec* c, const gf256_elem* recv, gf256_elem* synd);
+
+int16_t rs256_get_errata(const rs256_codec* c, const gf256_elem* recv, const uint64_t* e_pos, gf256_elem* errata);
+
+int16_t rs256_decode_systematic(const rs256_codec* c, const gf256_elem* recv, const uint64_t* e_pos, gf256_elem* raw);
+
+#endif // RS_GF256_H
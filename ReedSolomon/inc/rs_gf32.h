@@ -0,0 +1,20 @@
+#ifndef RS_GF32_H
+#define RS_GF32_H
+
+// BCH view, systematic encoding Reed Solomon using 5 bit symbols
+// defined to use first consecutive root, c = 1 for slightly simplified decoding
+//
+// same pipeline as rs_gf16.h but with multi-word packed polynomials, so r_len is in TERMS and position masks
+//  are uint32 since a block is 31 symbols. Failures are flagged in the unused top nibble of the last word,
+//  0xE for too many errors, 0xF for a root count mismatch, and an all ones errata for too many erasures
+
+#include <stdint.h>
+#include "gf32.h"
+
+gf32_poly rs32_encode_systematic(gf32_poly raw, int8_t chk_syms);
+
+gf32_poly rs32_decode_systematic(gf32_poly recv, gf32_idx r_len, int8_t chk_syms, uint32_t e_pos, uint32_t tx_pos);
+
+gf32_poly rs32_get_errata(gf32_poly recv, gf32_idx r_len, int8_t chk_syms, uint32_t e_pos, uint32_t tx_pos);
+
+#endif // RS_GF32_H
@@ -0,0 +1,20 @@
+#ifndef RS_GF64_H
+#define RS_GF64_H
+
+// BCH view, systematic encoding Reed Solomon using 6 bit symbols
+// defined to use first consecutive root, c = 1 for slightly simplified decoding
+//
+// same pipeline as rs_gf16.h but with multi-word packed polynomials, so r_len is in TERMS and position masks
+//  are uint64 since a block is 63 symbols. Failures are flagged in the unused top nibble of the last word,
+//  0xE for too many errors, 0xF for a root count mismatch, and an all ones errata for too many erasures
+
+#include <stdint.h>
+#include "gf64.h"
+
+gf64_poly rs64_encode_systematic(gf64_poly raw, int8_t chk_syms);
+
+gf64_poly rs64_decode_systematic(gf64_poly recv, gf64_idx r_len, int8_t chk_syms, uint64_t e_pos, uint64_t tx_pos);
+
+gf64_poly rs64_get_errata(gf64_poly recv, gf64_idx r_len, int8_t chk_syms, uint64_t e_pos, uint64_t tx_pos);
+
+#endif // RS_GF64_H
@@ -7,10 +7,46 @@
 #include <stdint.h>
 #include "gf8.h"
 
+extern const gf8_poly rs8_G_polys[];	// generator polynomials indexed by number of check symbols
+
 gf8_poly rs8_encode_systematic(gf8_poly raw, int8_t chk_syms);
 
 gf8_poly rs8_decode_systematic(gf8_poly recv, gf8_idx r_sz, int8_t chk_syms, int8_t e_pos, int8_t tx_pos);
 
 gf8_poly rs8_get_errata(gf8_poly recv, gf8_idx r_sz, int8_t chk_syms, int8_t e_pos, int8_t tx_pos);
 
+gf8_poly rs8_get_syndromes(gf8_poly p, gf8_idx p_sz, int8_t nsyms);
+
+gf8_poly rs8_get_errata_synd(gf8_poly synd, int8_t chk_syms, int8_t e_pos, int8_t tx_pos);
+
+gf8_poly rs8_get_erasure_locator(int8_t erase_pos);
+
+gf8_poly rs8_get_erasure_locator_mask(int8_t erase_pos);
+
+gf8_poly rs8_get_erasure_locator_list(const int8_t* erase_list, int8_t erase_cnt);
+
+gf8_poly rs8_get_errata_evaluator(gf8_poly synd, gf8_idx chk_sz, gf8_poly errata_loc);
+
+gf8_poly rs8_get_errata_magnitude(gf8_poly errata_eval, gf8_idx chk_sz, gf8_poly errata_loc, int8_t errata_pos);
+
+// incremental redundancy: a code word with chk_syms check symbols can't be upgraded to more by just sending extra
+//  symbols, the remainder for the bigger generator changes every check symbol, and symbols appended to a word
+//  that's already a code word for the first chk_syms roots would have to be 0 for it to stay one for the new roots.
+//  So it goes the other way round: words are encoded once with the most check symbols that could ever be sent,
+//  max_chk, and the first transmission leaves out the lowest max_chk - chk_syms of them. The receiver decodes it
+//  with those as erasures, which corrects exactly as much as a plain chk_syms code, and on failure asks for more.
+//  rs8_ir_extend() gives the next missing symbols, which go below what's been received so far,
+//  ie recv = recv << extra_syms*GF8_SYM_SZ | extra with e_pos and tx_pos shifted up by extra_syms to match
+//  rs8_ir_extend() re-encodes the data in sent with all max_chk check symbols and keeps the ones asked for, so it
+//  costs a full encode however few it returns. The remainder for the smaller generators doesn't give the lower
+//  check symbols, so there's nothing cheaper short of per-symbol parity tables, and a sender that keeps the
+//  rs8_encode_systematic() word at max_chk around can just shift the next symbols out of that instead
+gf8_poly rs8_ir_encode(gf8_poly raw, int8_t chk_syms, int8_t max_chk);
+
+gf8_poly rs8_ir_extend(gf8_poly sent, int8_t chk_syms, int8_t max_chk, int8_t extra_syms);
+
+gf8_poly rs8_ir_get_errata(gf8_poly recv, gf8_idx r_sz, int8_t chk_syms, int8_t max_chk, int8_t e_pos, int8_t tx_pos);
+
+gf8_poly rs8_ir_decode(gf8_poly recv, gf8_idx r_sz, int8_t chk_syms, int8_t max_chk, int8_t e_pos, int8_t tx_pos);
+
 #endif // RS_GF8_H
\ No newline at end of file
@@ -0,0 +1,56 @@
+#ifndef RS_GF8_CACHE_H
+#define RS_GF8_CACHE_H
+
+// memoization in front of the rs8 decoder for when the same received word keeps coming back, eg a marker that's
+//  read again every frame with the same symbols corrupted
+//
+// rs8_cache is a small set associative cache keyed by everything the decoder result depends on, ie the received
+//  word, r_sz, chk_syms, e_pos and tx_pos. It caches the errata, so failures come back with the same sentinels
+//  rs8_get_errata() returns. The caller owns it, there's no heap allocation, and sets and ways can be overridden
+//  at compile time, RS8_CACHE_WAYS=1 makes it direct mapped.
+//
+// rs8_full_table goes the other way and holds the errata for every possible 21 bit received word for one
+//  chk_syms and tx_pos, so it never misses for words without erasures. At 8MB it's meant to be static or heap
+//  allocated by the caller, and filling it runs the decoder 2^21 times
+
+#include <stdint.h>
+#include "gf8.h"
+
+#ifndef RS8_CACHE_SETS
+#define RS8_CACHE_SETS 64	// must be a power of 2
+#endif
+#ifndef RS8_CACHE_WAYS
+#define RS8_CACHE_WAYS 4
+#endif
+
+#define RS8_FULL_ENTRIES (1 << 21)	// every possible received word
+
+typedef struct
+{
+	uint64_t key[RS8_CACHE_SETS][RS8_CACHE_WAYS];	// 0 marks an empty way, valid keys always have the top bit set
+	gf8_poly errata[RS8_CACHE_SETS][RS8_CACHE_WAYS];
+	uint8_t victim[RS8_CACHE_SETS];					// next way to replace in each set, round robin
+	uint64_t hits;
+	uint64_t misses;
+} rs8_cache;
+
+typedef struct
+{
+	int8_t chk_syms;
+	int8_t tx_pos;
+	gf8_poly errata[RS8_FULL_ENTRIES];
+} rs8_full_table;
+
+void rs8_cache_init(rs8_cache* c);
+
+gf8_poly rs8_cache_get_errata(rs8_cache* c, gf8_poly recv, gf8_idx r_sz, int8_t chk_syms, int8_t e_pos, int8_t tx_pos);
+
+gf8_poly rs8_cache_decode_systematic(rs8_cache* c, gf8_poly recv, gf8_idx r_sz, int8_t chk_syms, int8_t e_pos, int8_t tx_pos);
+
+void rs8_full_table_init(rs8_full_table* t, int8_t chk_syms, int8_t tx_pos);
+
+gf8_poly rs8_full_table_get_errata(const rs8_full_table* t, gf8_poly recv, int8_t e_pos);
+
+gf8_poly rs8_full_table_decode_systematic(const rs8_full_table* t, gf8_poly recv, int8_t e_pos);
+
+#endif // RS_GF8_CACHE_H
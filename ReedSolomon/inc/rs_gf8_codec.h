@@ -0,0 +1,60 @@
+#ifndef RS_GF8_CODEC_H
+#define RS_GF8_CODEC_H
+
+// Configurable BCH view, systematic encoding Reed Solomon using 3 bit symbols
+//
+// Unlike rs_gf8.h which is hard wired to primitive polynomial 1011, fcr = 1 and the full 7 symbol block,
+//  everything here is derived once by rs8_codec_init() from the primitive polynomial, first consecutive root,
+//  and the shortened code length n and data length k, then passed by const pointer to every call.
+//  Packed polynomials keep the same layout as gf8.h and the shortened padding terms (n and above) are never
+//  evaluated or searched, they're simply folded away by the masks held in the codec.
+
+#include <stdint.h>
+#include "gf8.h"
+
+#define RS8_CODEC_EXP_ENTRIES 3 * GF8_MAX	// 3 periods so log sums from Forney never need a modulo
+#define RS8_CODEC_RED_MAX 2 * GF8_SYM_SZ - 2	// max number of distinct shifts needed to fold overflow back into a term
+
+typedef struct
+{
+	gf8_elem exp[RS8_CODEC_EXP_ENTRIES];	// exp table for the chosen primitive polynomial, repeated to avoid modulo ops
+	gf8_elem log[1 + GF8_MAX];				// log_0 undefined so dummy -1 included to simplify indexing
+	gf8_poly red_mask[RS8_CODEC_RED_MAX];	// overflow bits that fold back down into their term by a right shift of red_shift
+	int8_t red_shift[RS8_CODEC_RED_MAX];
+	int8_t red_cnt;							// number of valid mask/shift pairs, 2 for 1011
+	gf8_elem synd_root[GF8_MAX];			// alpha^(fcr + i) for syndrome i
+	gf8_elem root_inv[GF8_MAX];				// X(p)^-1 = alpha^-p for codeword position p, the Chien/Forney eval points
+	gf8_elem forney_log[GF8_MAX];			// log of the X(p)^(1-fcr) term of Forney, all 0 when fcr = 1
+	gf8_poly g_poly;						// generator polynomial, prod(x - alpha^(fcr + i)) for i in [0, chk_syms)
+	gf8_poly msg_mask;						// valid data bits before shifting into place
+	gf8_poly prime;
+	gf8_idx n_sz;							// sizes in BITS not symbols, same as everywhere else
+	gf8_idx chk_sz;
+	int8_t tx_pos;							// set bits for the transmitted positions, ie everything below n
+	int8_t fcr;
+	int8_t n;
+	int8_t k;
+	int8_t chk_syms;
+} rs8_codec;
+
+int8_t rs8_codec_init(rs8_codec* c, gf8_poly prime, int8_t fcr, int8_t n, int8_t k);
+
+gf8_poly rs8_codec_encode(const rs8_codec* c, gf8_poly raw);
+
+gf8_poly rs8_codec_decode(const rs8_codec* c, gf8_poly recv, int8_t e_pos);
+
+gf8_poly rs8_codec_get_errata(const rs8_codec* c, gf8_poly recv, int8_t e_pos);
+
+gf8_elem rs8_codec_mul(const rs8_codec* c, gf8_elem a, gf8_elem b);
+
+gf8_elem rs8_codec_div(const rs8_codec* c, gf8_elem a, gf8_elem b);
+
+gf8_poly rs8_codec_poly_scale(const rs8_codec* c, gf8_poly p, gf8_elem x);
+
+gf8_poly rs8_codec_poly_mul(const rs8_codec* c, gf8_poly p, gf8_poly q);
+
+gf8_elem rs8_codec_poly_eval(const rs8_codec* c, gf8_poly p, gf8_idx p_sz, gf8_elem x);
+
+gf8_poly rs8_codec_poly_mod(const rs8_codec* c, gf8_poly p, gf8_idx p_sz, gf8_poly q, gf8_idx q_sz);
+
+#endif // RS_GF8_CODEC_H
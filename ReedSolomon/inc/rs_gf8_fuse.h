@@ -0,0 +1,29 @@
+#ifndef RS_GF8_FUSE_H
+#define RS_GF8_FUSE_H
+
+// multi-read fusion for rs8, for when the same code word is read several times, eg a marker tracked over
+//  consecutive frames or seen by several cameras
+//
+// decoding every read on its own and voting on the results costs a decode per read and can only ever recover a
+//  word that at least one read could. Fusing first takes a symbol wise majority over the reads, a symbol at least
+//  half the reads disagree on or that every read has erased becomes an erasure, and decodes the fused word once.
+//  Errors that only show up in a minority of reads are voted out before the decoder sees them and the ones that
+//  can't be voted out are erasures, which cost half as much correction as errors, so words where no single read is
+//  decodable often still come back. Only when the fused decode fails are the reads decoded one at a time, and the
+//  data most of the successful ones agree on is returned.
+
+#include <stdint.h>
+#include "gf8.h"
+
+#define RS8_FUSE_MAX_READS 16	// reads past this many are ignored
+
+// rs8_fuse_decode() returns
+#define RS8_FUSE_FUSED 0	// the fused word decoded
+#define RS8_FUSE_SINGLE 1	// the fused word didn't, but at least one read on its own did
+#define RS8_FUSE_FAILED -1	// nothing decoded
+
+gf8_poly rs8_fuse_reads(const gf8_poly* recv, const int8_t* e_pos, int8_t cnt, gf8_idx r_sz, int8_t* fused_e_pos);
+
+int8_t rs8_fuse_decode(const gf8_poly* recv, const int8_t* e_pos, int8_t cnt, gf8_idx r_sz, int8_t chk_syms, int8_t tx_pos, gf8_poly* raw);
+
+#endif // RS_GF8_FUSE_H
@@ -0,0 +1,34 @@
+#ifndef RS_GF8_ML_H
+#define RS_GF8_ML_H
+
+// maximum likelihood (nearest code word) decoding for short rs8 codes, eg fiducial markers
+//
+// with only a few data symbols the whole code book is small enough to compare the received word against every
+//  code word, which finds the nearest one by symbol Hamming distance even past half the minimum distance where
+//  rs8_get_errata() gives up. Erased symbols are left out of the distance. The second best distance comes back
+//  too, best == second means the read is ambiguous and the margin between them is a confidence measure
+//
+// the code book holds every code word of rs8_encode_systematic() for data_syms data symbols and chk_syms check
+//  symbols, shortened if they add up to less than 7, indexed by its raw data
+
+#include <stdint.h>
+#include "gf8.h"
+
+#define RS8_ML_MAX_DATA_SYMS 4
+#define RS8_ML_MAX_CW (1 << (RS8_ML_MAX_DATA_SYMS * GF8_SYM_SZ))
+
+typedef struct
+{
+	int8_t chk_syms;
+	int8_t data_syms;
+	int32_t cw_cnt;
+	gf8_poly cw[RS8_ML_MAX_CW];
+} rs8_ml_codebook;
+
+int8_t rs8_ml_init(rs8_ml_codebook* cb, int8_t chk_syms, int8_t data_syms);
+
+int8_t rs8_ml_distance(gf8_poly a, gf8_poly b, int8_t e_pos);
+
+gf8_poly rs8_ml_decode(const rs8_ml_codebook* cb, gf8_poly recv, int8_t e_pos, int8_t* best_dist, int8_t* second_dist);
+
+#endif // RS_GF8_ML_H
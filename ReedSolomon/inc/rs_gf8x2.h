@@ -0,0 +1,21 @@
+#ifndef RS_GF8X2_H
+#define RS_GF8X2_H
+
+// 2 rs8 code words at a time, one per lane of a gf8x2_poly, see gf8x2.h for the layout
+//  both lanes share chk_syms but are otherwise independent, results are lane for lane identical to rs_gf8.h
+//
+// e_pos and tx_pos hold lane 0 in the low byte and lane 1 in the high byte, and each lane of the errata
+//  holds the same value rs8_get_errata() would return for it, including the failure sentinels
+
+#include <stdint.h>
+#include "gf8x2.h"
+
+gf8x2_poly rs8x2_encode_systematic(gf8x2_poly raw, int8_t chk_syms);
+
+gf8x2_poly rs8x2_get_syndromes(gf8x2_poly recv, int8_t chk_syms);
+
+gf8x2_poly rs8x2_get_errata(gf8x2_poly recv, int8_t chk_syms, uint16_t e_pos, uint16_t tx_pos);
+
+gf8x2_poly rs8x2_decode_systematic(gf8x2_poly recv, int8_t chk_syms, uint16_t e_pos, uint16_t tx_pos);
+
+#endif // RS_GF8X2_H
@@ -0,0 +1,74 @@
+#ifndef RS_PROFILE_H
+#define RS_PROFILE_H
+
+// optional per stage cycle counts for the rs8 and rs16 decoders
+//
+// build with -DRS_PROFILE (make PROFILE=1) and every rs*_get_errata() call records how long each stage of the
+//  decoder took into a histogram belonging to the calling thread. Without it the hooks in the decoders compile
+//  to nothing and the snapshot below always comes back empty, so the API can stay in place in callers.
+//
+// histograms are log2 bucketed, bucket b counts stages that took [2^(b-1), 2^b) cycles with bucket 0 being exactly 0.
+//  cycles are from the TSC on x86, which ticks at a fixed reference rate rather than the core clock, and ns elsewhere.
+//  stages that were skipped, eg the Chien search when there were no errors left to find, record nothing,
+//  so the counts per stage also give the split between the different paths through the decoder
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define RS_PROF_BUCKETS 64
+
+typedef enum
+{
+	RS_PROF_RS8,
+	RS_PROF_RS16,
+	RS_PROF_CODES
+} rs_prof_code;
+
+typedef enum
+{
+	RS_STAGE_SYNDROMES,		// rs*_get_syndromes()
+	RS_STAGE_ERASURE_LOC,	// erasure locator plus the Forney syndromes
+	RS_STAGE_BERLEKAMP,		// rs*_get_error_locator()
+	RS_STAGE_CHIEN,			// rs*_get_error_pos()
+	RS_STAGE_FORNEY,		// combining the errata and rs*_get_errata_magnitude()
+	RS_STAGE_TOTAL,			// the whole rs*_get_errata() call, including early outs
+	RS_STAGE_CNT
+} rs_prof_stage;
+
+typedef struct
+{
+	uint64_t count;
+	uint64_t cycles;	// sum over all counted calls
+	uint64_t hist[RS_PROF_BUCKETS];
+} rs_prof_hist;
+
+// sum over every thread that has ever recorded anything, including ones that have since exited
+typedef struct
+{
+	rs_prof_hist stage[RS_PROF_CODES][RS_STAGE_CNT];
+} rs_profile_snapshot;
+
+uint64_t rs_profile_now(void);
+
+void rs_profile_record(rs_prof_code code, rs_prof_stage stage, uint64_t cycles);
+
+void rs_profile_snapshot_get(rs_profile_snapshot* snap);
+
+void rs_profile_reset(void);
+
+uint64_t rs_profile_percentile(const rs_prof_hist* h, double pct);
+
+const char* rs_profile_stage_name(rs_prof_stage stage);
+
+void rs_profile_export_json(FILE* f, const rs_profile_snapshot* snap);
+
+#ifdef RS_PROFILE
+// RS_PROF_START(t) declares a stage timer, each RS_PROF_STAGE() then records the time since the previous one on it
+#define RS_PROF_START(t) uint64_t t = rs_profile_now()
+#define RS_PROF_STAGE(code, stage, t) do { uint64_t t##_now = rs_profile_now(); rs_profile_record(code, stage, t##_now - t); t = t##_now; } while (0)
+#else
+#define RS_PROF_START(t)
+#define RS_PROF_STAGE(code, stage, t)
+#endif
+
+#endif // RS_PROFILE_H
@@ -0,0 +1,113 @@
+#ifndef RS_SERVICE_H
+#define RS_SERVICE_H
+
+// local decode service, one daemon batching the rs8 and rs16 work of every process on the host
+//
+// processes that only ever have a few words at a time to encode or decode never fill rs_batch_get_errata()'s
+//  buckets or more than one core. The daemon owns a shared memory segment, /dev/shm/tiny_ecc.NAME, with a ring of
+//  requests and results for each connected client. Clients copy requests into their ring and bump a doorbell.
+//  The daemon gathers whatever every client has pending into one batch of up to RS_SERVICE_BATCH requests, splits
+//  it over its worker threads, each pinned to its own CPU, and publishes each client's completed count. Waiting on
+//  either side is a futex on a word in the segment, and a submit only costs the client a wake syscall when the
+//  daemon is actually asleep, so a busy daemon just keeps taking rounds without entering the kernel.
+//
+// every ring is single producer single consumer, one client process and the daemon, so a client handle must not be
+//  shared between threads without a lock. Results come back in request order: the errata for RS_SERVICE_ERRATA,
+//  exactly what rs_batch_get_errata() gives, or the code word for RS_SERVICE_ENCODE. Requests with an unknown op,
+//  code or chk_syms get -1 without being run. A slot whose process has died is taken over by the next client to
+//  connect.
+
+#include <stdint.h>
+#include <pthread.h>
+
+#define RS_SERVICE_MAGIC "TINYSVC"
+#define RS_SERVICE_VERSION 1
+#define RS_SERVICE_LINE 64			// cache line size, the counters each side writes are kept on separate lines
+#define RS_SERVICE_CLIENTS 16		// client slots in the segment
+#define RS_SERVICE_RING 1024		// requests in flight per client, a power of 2
+#define RS_SERVICE_BATCH 4096		// requests the daemon takes per round across all clients
+#define RS_SERVICE_MAX_WORKERS 64
+#define RS_SERVICE_POLL_MS 100		// how often a sleeping side wakes up to check the other is still alive
+
+typedef enum
+{
+	RS_SERVICE_ENCODE,	// word is the raw data, result is rs*_encode_systematic()
+	RS_SERVICE_ERRATA	// word is the received word, result is the errata same as rs_batch_get_errata()
+} rs_service_op;
+
+typedef struct
+{
+	int64_t word;
+	int8_t op;			// rs_service_op
+	int8_t code;		// rs_batch_code
+	int8_t chk_syms;
+	int16_t e_pos;
+	int16_t tx_pos;
+} rs_service_req;
+
+typedef struct
+{
+	uint32_t claimed;	// set by the client that owns the slot
+	int32_t pid;		// of that client
+	_Alignas(RS_SERVICE_LINE) uint32_t head;	// requests submitted, only written by the client
+	_Alignas(RS_SERVICE_LINE) uint32_t done;	// requests completed, only written by the daemon, the client sleeps on it
+	uint32_t waiting;	// the client is asleep on done and needs a wake
+	_Alignas(RS_SERVICE_LINE) rs_service_req req[RS_SERVICE_RING];
+	int64_t res[RS_SERVICE_RING];
+} rs_service_slot;
+
+typedef struct
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t size;		// of this struct, a daemon from a different build gets rejected
+	int32_t daemon_pid;
+	_Alignas(RS_SERVICE_LINE) uint32_t doorbell;	// bumped by every submit, the daemon sleeps on it
+	uint32_t sleeping;	// the daemon is asleep on the doorbell and needs a wake
+	rs_service_slot slot[RS_SERVICE_CLIENTS];
+} rs_service_shm;
+
+typedef struct
+{
+	rs_service_shm* shm;
+	rs_service_slot* slot;
+} rs_service_client;
+
+typedef struct rs_service rs_service;
+
+typedef struct
+{
+	rs_service* s;
+	int8_t idx;
+	int16_t cpu;	// -1 for not pinned
+	pthread_t thread;
+} rs_service_worker;
+
+struct rs_service
+{
+	rs_service_shm* shm;
+	char path[64];
+	int8_t worker_cnt;
+	volatile int8_t stop;
+	rs_service_worker worker[RS_SERVICE_MAX_WORKERS];
+	pthread_barrier_t round_start;
+	pthread_barrier_t round_end;
+	// the current round, request i came from slot batch_slot[i] at ring position batch_pos[i]
+	int32_t batch_cnt;
+	int8_t batch_slot[RS_SERVICE_BATCH];
+	uint16_t batch_pos[RS_SERVICE_BATCH];
+	uint32_t taken[RS_SERVICE_CLIENTS];	// requests of each slot in this or earlier rounds
+	int8_t next_slot;	// where gathering starts, rotated so no client always goes first
+};
+
+int8_t rs_service_start(rs_service* s, const char* name, int8_t workers, const int16_t* cpus, int8_t cpu_cnt);
+
+void rs_service_stop(rs_service* s);
+
+int8_t rs_service_connect(rs_service_client* c, const char* name);
+
+int8_t rs_service_call(rs_service_client* c, const rs_service_req* req, int64_t* res, int32_t cnt);
+
+void rs_service_disconnect(rs_service_client* c);
+
+#endif // RS_SERVICE_H
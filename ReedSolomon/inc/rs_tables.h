@@ -0,0 +1,81 @@
+#ifndef RS_TABLES_H
+#define RS_TABLES_H
+
+// precomputed table files, written by apps/gen_LUTs.c and mapped read-only at startup so short lived tools page
+//  tables in instead of rebuilding them, and every process using the same file shares the same physical pages
+//
+// a file is a header, a directory of sections and then the sections themselves, each starting on a 64 byte
+//  boundary so they can be used in place by the SIMD paths. The header has a format version, the sizes of the
+//  structs that get used in place so a file from a different build or ABI gets rejected rather than misread,
+//  and a checksum over everything after it.
+//
+// sections are found by id and a parameter, eg the rs8 full decode table for some chk_syms and tx_pos. Tables
+//  the library keeps in fixed globals (GF(256) products, Golay) get copied out of the mapping since they're
+//  small, the big ones are used straight from it
+
+#include <stdint.h>
+#include "rs_gf8_cache.h"
+
+#define RS_TABLES_MAGIC "TINYECC"
+#define RS_TABLES_VERSION 1
+#define RS_TABLES_ALIGN 64
+
+typedef enum
+{
+	RS_TABLE_GF256_MUL = 1,	// gf256_mul_lo then gf256_mul_hi
+	RS_TABLE_GOLAY24 = 2,	// golay24_chk then golay24_errata
+	RS_TABLE_RS8_FULL = 3	// an rs8_full_table, param is chk_syms | tx_pos << 8
+} rs_table_id;
+
+typedef struct
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t endian;		// 0x01020304 as written
+	uint32_t rs8_full_sz;	// sizeof(rs8_full_table) in the build that wrote it
+	uint32_t section_cnt;
+	uint64_t file_sz;
+	uint64_t checksum;		// of everything after the header
+} rs_tables_header;
+
+typedef struct
+{
+	uint32_t id;
+	uint32_t param;
+	uint64_t offset;	// from the start of the file
+	uint64_t size;
+} rs_tables_section;
+
+// one section to write
+typedef struct
+{
+	rs_table_id id;
+	uint32_t param;
+	const void* data;
+	uint64_t size;
+} rs_table_src;
+
+typedef struct
+{
+	const uint8_t* base;
+	uint64_t size;
+	int8_t mapped;	// 0 if the file was read into memory instead
+} rs_tables;
+
+uint64_t rs_tables_checksum(const void* data, uint64_t size);
+
+int8_t rs_tables_write(const char* path, const rs_table_src* src, uint32_t cnt);
+
+int8_t rs_tables_open(rs_tables* t, const char* path, int8_t verify);
+
+void rs_tables_close(rs_tables* t);
+
+const void* rs_tables_find(const rs_tables* t, rs_table_id id, uint32_t param, uint64_t* size);
+
+int8_t rs_tables_load_gf256(const rs_tables* t);
+
+int8_t rs_tables_load_golay24(const rs_tables* t);
+
+const rs8_full_table* rs_tables_rs8_full(const rs_tables* t, int8_t chk_syms, int8_t tx_pos);
+
+#endif // RS_TABLES_H
@@ -0,0 +1,60 @@
+#ifndef RS_TELEMETRY_H
+#define RS_TELEMETRY_H
+
+// optional decode outcome counters for the rs8 and rs16 decoders, for watching channel health without every
+//  caller having to pick apart the sentinel return values itself
+//
+// build with -DRS_TELEMETRY (make TELEMETRY=1) and every decode through rs*_get_errata_synd(), so also
+//  rs*_get_errata(), rs*_decode_systematic() and the rs8x2 versions, counts its outcome in a block of counters
+//  owned by the calling thread. Blocks are cache line aligned and padded so threads never share a line, and
+//  totals are only summed when asked for. Without the flag the hooks compile to nothing and the snapshot is empty
+
+#include <stdint.h>
+
+#define RS_TELEM_MAX_CNT 16	// enough for every errata count of either code, rs16 code words are 15 symbols
+
+typedef enum
+{
+	RS_TELEM_RS8,
+	RS_TELEM_RS16,
+	RS_TELEM_CODES
+} rs_telem_code;
+
+typedef enum
+{
+	RS_OUT_CLEAN,			// syndromes were all 0
+	RS_OUT_CORRECTED,		// errata found and returned, see errors[] and erasures[] for how many
+	RS_OUT_ERASE_OVERFLOW,	// more erasures than check symbols, the -1 return
+	RS_OUT_BM_ORDER,		// error locator order beyond what the check symbols can correct, the 0xE (rs16) or 02 (rs8) return
+	RS_OUT_ROOT_MISMATCH,	// error locator didn't have as many roots as its order, the 0xF (rs16) or 03 (rs8) return
+	RS_OUT_CNT
+} rs_telem_outcome;
+
+typedef struct
+{
+	uint64_t decodes;
+	uint64_t outcome[RS_OUT_CNT];
+	uint64_t errors[RS_TELEM_MAX_CNT];		// corrected decodes by how many errors they fixed
+	uint64_t erasures[RS_TELEM_MAX_CNT];	// corrected decodes by how many erasures they were given
+} rs_telem_counts;
+
+typedef struct
+{
+	rs_telem_counts code[RS_TELEM_CODES];
+} rs_telemetry_snapshot;
+
+void rs_telemetry_record(rs_telem_code code, rs_telem_outcome outcome, int8_t errors, int8_t erasures);
+
+void rs_telemetry_snapshot_get(rs_telemetry_snapshot* snap);
+
+void rs_telemetry_reset(void);
+
+const char* rs_telemetry_outcome_name(rs_telem_outcome outcome);
+
+#ifdef RS_TELEMETRY
+#define RS_TELEM(code, outcome, errors, erasures) rs_telemetry_record(code, outcome, errors, erasures)
+#else
+#define RS_TELEM(code, outcome, errors, erasures) do { } while (0)
+#endif
+
+#endif // RS_TELEMETRY_H
@@ -0,0 +1,76 @@
+#ifndef RS_TUNE_H
+#define RS_TUNE_H
+
+// per host autotuning of the rs8 and rs16 encode and syndrome stages
+//
+// which implementation is fastest depends on the machine and on the shape of the code, a table lookup per data
+//  symbol beats dividing by the generator once there are enough check symbols to make the division long, and one
+//  lookup per received symbol for every syndrome at once beats evaluating each syndrome separately the same way.
+//  So every (field, chk_syms) shape gets its own choice for both stages, and the rs*_tuned_*() calls dispatch on it.
+//
+// rs_tune_run() times every variant of both stages for every shape on this machine and keeps the fastest,
+//  rs_tune_save() writes the choices out as a small text file and rs_tune_init() loads one back at startup so only
+//  the first run on a host pays for the timing. Until something is loaded or tuned the choices are the same code
+//  paths as the plain rs*_encode_systematic() and rs*_get_syndromes() calls.
+//
+// the decoder past the syndromes and the variants that only exist as whole builds, NO_LUT and the VARIANTS defines,
+//  aren't covered since only one of each is compiled into any given build, apps/bench_variants.c compares those.
+//  Tuning and loading write the global choices so neither is safe while other threads are using the tuned calls
+
+#include <stdint.h>
+#include <stdio.h>
+#include "gf8.h"
+#include "gf16.h"
+
+#define RS_TUNE_MAGIC "tiny_ecc_tune"
+#define RS_TUNE_VERSION 1
+
+typedef enum
+{
+	RS_TUNE_ENC_MOD,	// remainder by the generator with gf*_poly_mod(), what rs*_encode_systematic() does
+	RS_TUNE_ENC_TABLE,	// check symbols of every data symbol value at every position, xored together
+	RS_TUNE_ENC_CNT
+} rs_tune_enc;
+
+typedef enum
+{
+	RS_TUNE_SYND_HORNER,	// gf*_poly_eval_horner() once per syndrome
+	RS_TUNE_SYND_MOD,		// gf*_poly_eval_mod() once per syndrome
+	RS_TUNE_SYND_TABLE,		// every syndrome of every symbol value at every position, xored together
+	RS_TUNE_SYND_CNT
+} rs_tune_synd;
+
+typedef struct
+{
+	int8_t enc;		// rs_tune_enc
+	int8_t synd;	// rs_tune_synd
+} rs_tune_choice;
+
+extern rs_tune_choice rs8_tune[1 + GF8_MAX];	// indexed by chk_syms
+extern rs_tune_choice rs16_tune[1 + GF16_MAX];
+
+int8_t rs_tune_init(const char* path);
+
+void rs_tune_run(FILE* log);
+
+int8_t rs_tune_save(const char* path);
+
+int8_t rs_tune_load(const char* path);
+
+gf8_poly rs8_tuned_encode(gf8_poly raw, int8_t chk_syms);
+
+gf8_poly rs8_tuned_get_syndromes(gf8_poly recv, gf8_idx r_sz, int8_t chk_syms);
+
+gf8_poly rs8_tuned_get_errata(gf8_poly recv, gf8_idx r_sz, int8_t chk_syms, int8_t e_pos, int8_t tx_pos);
+
+gf8_poly rs8_tuned_decode(gf8_poly recv, gf8_idx r_sz, int8_t chk_syms, int8_t e_pos, int8_t tx_pos);
+
+gf16_poly rs16_tuned_encode(gf16_poly raw, int8_t chk_syms);
+
+gf16_poly rs16_tuned_get_syndromes(gf16_poly recv, gf16_idx r_sz, int8_t chk_syms);
+
+gf16_poly rs16_tuned_get_errata(gf16_poly recv, gf16_idx r_sz, int8_t chk_syms, int16_t e_pos, int16_t tx_pos);
+
+gf16_poly rs16_tuned_decode(gf16_poly recv, gf16_idx r_sz, int8_t chk_syms, int16_t e_pos, int16_t tx_pos);
+
+#endif // RS_TUNE_H
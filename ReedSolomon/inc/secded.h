@@ -0,0 +1,42 @@
+#ifndef SECDED_H
+#define SECDED_H
+
+// extended Hamming SECDED codes, (72,64) over uint64 and (39,32) over uint32, for in memory records
+//
+// the check bits live in a separate byte next to the data, bits 0 through 6 (0 through 5 for the 32 bit code) are
+//  the Hamming check bits and the next bit up is the parity of the data and those check bits together. Check bit j
+//  is the parity of the data bits whose position in the Hamming code word has bit j set, so it's just a masked
+//  popcount, and the (39,32) code is the (72,64) one shortened to the low 32 data bits so they share the masks.
+//
+// decoding corrects the data and check byte in place and classifies each word as clean, single bit corrected
+//  (including errors in the check byte itself) or a double bit error that can only be detected. The scrub
+//  functions do the same over whole buffers, computing the check bits 8 words at a time with AVX-512 VPOPCNTDQ or
+//  4 with AVX2 when available and only falling back to the scalar decoder for the words that don't match, with
+//  the outcome of every word reported in bitmaps.
+
+#include <stdint.h>
+
+#define SECDED_CLEAN 0
+#define SECDED_CORRECTED 1
+#define SECDED_DOUBLE -1	// 2 bit errors (or more that happen to look like it), data left as is
+
+#define SECDED64_CHK_BITS 7
+#define SECDED32_CHK_BITS 6
+
+extern const uint64_t secded_masks[SECDED64_CHK_BITS];	// data bits covered by each check bit
+
+uint8_t secded64_get_chk(uint64_t data);
+
+uint8_t secded32_get_chk(uint32_t data);
+
+int8_t secded64_decode(uint64_t* data, uint8_t* chk);
+
+int8_t secded32_decode(uint32_t* data, uint8_t* chk);
+
+void secded64_encode_batch(const uint64_t* data, uint8_t* chk, int32_t n);
+
+int32_t secded64_scrub(uint64_t* data, uint8_t* chk, int32_t n, uint64_t* corrected, uint64_t* failed);
+
+int32_t secded32_scrub(uint32_t* data, uint8_t* chk, int32_t n, uint64_t* corrected, uint64_t* failed);
+
+#endif // SECDED_H
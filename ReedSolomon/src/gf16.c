@@ -1,4 +1,9 @@
 #include "gf16.h"
+#include <pthread.h>
+
+#if defined(__AVX2__) || defined(__SSSE3__)
+#include <immintrin.h>
+#endif
 
 #define PRIME_GF16 0b10011	// the prime polynomial for GF(16), x^4 + x^1 + 1
 // masks that isolate out the term overflow from the result in the mul and scale functions
@@ -11,6 +16,7 @@
 // mask to isolate just the odd terms for the formal derivative
 #define GF16_ODD   0xF0F0F0F0F0F0F0F0
 
+#ifndef GF16_NO_LUT
 const gf16_elem gf16_exp[GF16_EXP_ENTRIES] = {	// length not a multiple of 2 so duplicate entries + offset needed for easy wraparound of negatives
 	0x1, 0x2, 0x4, 0x8, 0x3, 0x6, 0xC, 0xB, 0x5, 0xA, 0x7, 0xE, 0xF, 0xD, 0x9,
 	0x1, 0x2, 0x4, 0x8, 0x3, 0x6, 0xC, 0xB, 0x5, 0xA, 0x7, 0xE, 0xF, 0xD, 0x9};
@@ -19,6 +25,7 @@ const gf16_elem* gf16_exp_div = gf16_exp + GF16_MAX;
 
 const gf16_elem gf16_log[1 + GF16_MAX] = {	// log_0 undefined so dummy -1 included to simplify indexing
 	-1, 0x0, 0x1, 0x4, 0x2, 0x8, 0x5, 0xA, 0x3, 0xE, 0x9, 0x7, 0x6, 0xD, 0xB, 0xC};
+#endif // GF16_NO_LUT
 
 // simplified galois field multiply by 2 used for generating the Look Up Tables
 gf16_elem gf16_mul2_noLUT(gf16_elem x)
@@ -30,6 +37,71 @@ gf16_elem gf16_mul2_noLUT(gf16_elem x)
 	return x;
 }
 
+#ifdef GF16_NO_LUT
+// every inverse packed as 4 bit entries in a single immediate, entry x is x^-1 with the 0 entry as a dummy
+#define GF16_INV_PACKED 0x834A5C2F67BDE910
+// and 2^i packed the same way, ie the exp table without the duplicate entries
+#define GF16_EXP_PACKED 0x09DFE7A5BC638421
+
+// shift and reduce multiply, the carryless product is at most 7 bits and x^4 = x + 1 folds the top 3 bits
+//  back down in a single step since (x + 1) * x^2 still fits in 4 bits
+gf16_elem gf16_mul(gf16_elem a, gf16_elem b)
+{
+	int16_t r, of;
+	r = a & -(b & 1);
+	r ^= (a << 1) & -((b >> 1) & 1);
+	r ^= (a << 2) & -((b >> 2) & 1);
+	r ^= (a << 3) & -((b >> 3) & 1);
+
+	of = r >> GF16_SYM_SZ;
+	return (r ^ of ^ (of << 1)) & GF16_MAX;
+}
+
+// no exponentiation chain needed, the whole inverse table fits in a register sized constant
+gf16_elem gf16_inverse(gf16_elem x)
+{
+	return (GF16_INV_PACKED >> (GF16_SYM_SZ * x)) & GF16_MAX;
+}
+
+gf16_elem gf16_div(gf16_elem a, gf16_elem b)
+{
+	if (b == 0)
+		return -1;	// divide by 0 error, normal operation should never get here
+
+	return gf16_mul(a, gf16_inverse(b));
+}
+
+// square and multiply, the power is taken mod 15 first so negative powers work as well. 0 to any power but 0 is 0,
+//  checked before the mod since 0^15 would otherwise come out as 0^0
+gf16_elem gf16_pow(gf16_elem x, int8_t power)
+{
+	if (x == 0)
+		return power == 0;
+
+	power %= GF16_MAX;
+	if (power < 0)
+		power += GF16_MAX;
+
+	gf16_elem y = 1;
+	for (; power; power >>= 1)
+	{
+		if (power & 1)
+			y = gf16_mul(y, x);
+		x = gf16_mul(x, x);
+	}
+
+	return y;
+}
+
+// power is assumed to be in the range of 0 to GF16_EXP_ENTRIES -1 same as the LUT version
+gf16_elem gf16_2pow(int8_t power)
+{
+	if (power >= GF16_MAX)
+		power -= GF16_MAX;
+
+	return (GF16_EXP_PACKED >> (GF16_SYM_SZ * power)) & GF16_MAX;
+}
+#else
 gf16_elem gf16_div(gf16_elem a, gf16_elem b)
 {
 	if (b == 0)
@@ -48,9 +120,13 @@ gf16_elem gf16_mul(gf16_elem a, gf16_elem b)
 	return gf16_exp[gf16_log[a] + gf16_log[b]];
 }
 
+// 0 has no log so it's handled the same as the table-less version
 gf16_elem gf16_pow(gf16_elem x, int8_t power)
 {
-	return gf16_exp[(gf16_log[x] * power) % GF16_EXP_ENTRIES];
+	if (x == 0)
+		return power == 0;
+
+	return gf16_exp_div[(gf16_log[x] * power) % GF16_MAX];	// remainder is within +-GF16_MAX so negative powers work through the div offset
 }
 
 // slight optimization since most calls use x = 2 which evaluates to 1
@@ -64,6 +140,7 @@ gf16_elem gf16_inverse(gf16_elem x)
 {
 	return gf16_exp_div[-gf16_log[x]];	// negative indices are valid in C so long as there's valid data there
 }
+#endif // GF16_NO_LUT
 
 // prior to reduction, term can extend up to 2 bits above symbol due to shifting
 // this function is customized to GF(16) with prime polynomial 10011
@@ -72,9 +149,11 @@ gf16_poly gf16_poly_reduce(gf16_poly p, gf16_poly of)
 	return p ^ (of >> 3) ^ (of >> 4);
 }
 
-// optimized for fewer memory accesses
-// TODO: check if multiplies are faster, currently assuming that single shifts and conditional assignment are better
-gf16_poly gf16_poly_scale(gf16_poly p, gf16_elem x)
+// the variants below are all compiled so apps/bench_variants.c can compare them on the same inputs, the defines
+//  only pick which one the library itself uses
+
+// optimized for fewer memory accesses, shifts and conditional assignment
+gf16_poly gf16_poly_scale_select(gf16_poly p, gf16_elem x)
 {
 	gf16_poly r0, r1, r2, r3, of;
 	r0 = (x & 1) ? p : 0;
@@ -91,11 +170,34 @@ gf16_poly gf16_poly_scale(gf16_poly p, gf16_elem x)
 	return gf16_poly_reduce(r0, of);
 }
 
-// TODO: consider converting to a loop
+// multiplies by the isolated bits of x instead of selecting, same as gf16_poly_mul() does per term
+gf16_poly gf16_poly_scale_mul(gf16_poly p, gf16_elem x)
+{
+	gf16_poly r0, r1, r2, r3, of;
+	r0 = (x & 1) * p;
+	r1 = (x & 2) * p;
+	r2 = (x & 4) * p;
+	r3 = (x & 8) * p;
+
+	of = (r1 & GF16_R1_OF) ^ (r2 & GF16_R2_OF) ^ (r3 & GF16_R3_OF);
+	r0 ^= (r1 & GF16_R1_R0) ^ (r2 & GF16_R2_R0) ^ (r3 & GF16_R3_R0);
+
+	return gf16_poly_reduce(r0, of);
+}
+
+gf16_poly gf16_poly_scale(gf16_poly p, gf16_elem x)
+{
+#ifdef GF16_SCALE_MUL
+	return gf16_poly_scale_mul(p, x);
+#else
+	return gf16_poly_scale_select(p, x);
+#endif
+}
+
 // Assumes that result can never be longer than 15 terms, and the shorter polynomial is in q
 //  currently assuming the second multiplier is no more than 13 terms, this is just enough for
 //  Reed Solomon with a max of 14 check symbols with specific optimizations
-gf16_poly gf16_poly_mul(gf16_poly p, gf16_poly q)
+gf16_poly gf16_poly_mul_unrolled(gf16_poly p, gf16_poly q)
 {
 	gf16_poly r0, r1, r2, r3, of;
 	// term 0
@@ -170,6 +272,32 @@ gf16_poly gf16_poly_mul(gf16_poly p, gf16_poly q)
 	return gf16_poly_reduce(r0, of);
 }
 
+// same as gf16_poly_mul_unrolled() as a loop over the terms of q
+gf16_poly gf16_poly_mul_loop(gf16_poly p, gf16_poly q)
+{
+	gf16_poly r0 = 0, r1 = 0, r2 = 0, r3 = 0, of;
+	for (gf16_idx i = 0; i < 13 * GF16_SYM_SZ; i += GF16_SYM_SZ)
+	{
+		r0 ^= (q & ((gf16_poly)1 << i)) * p;
+		r1 ^= (q & ((gf16_poly)2 << i)) * p;
+		r2 ^= (q & ((gf16_poly)4 << i)) * p;
+		r3 ^= (q & ((gf16_poly)8 << i)) * p;
+	}
+	of = (r1 & GF16_R1_OF) ^ (r2 & GF16_R2_OF) ^ (r3 & GF16_R3_OF);
+	r0 ^= (r1 & GF16_R1_R0) ^ (r2 & GF16_R2_R0) ^ (r3 & GF16_R3_R0);
+
+	return gf16_poly_reduce(r0, of);
+}
+
+gf16_poly gf16_poly_mul(gf16_poly p, gf16_poly q)
+{
+#ifdef GF16_MUL_LOOP
+	return gf16_poly_mul_loop(p, q);
+#else
+	return gf16_poly_mul_unrolled(p, q);
+#endif
+}
+
 // squeezes one more term out of poly_mul with the assumption that term 0 of q is always 1
 gf16_poly gf16_poly_mul_q0_monic(gf16_poly p, gf16_poly q)
 {
@@ -196,23 +324,48 @@ gf16_poly gf16_poly_mod(gf16_poly p, gf16_idx p_sz, gf16_poly q, gf16_idx q_sz)
 	return p;
 }
 
-// optimized version of div for binomial divisor/single eval point
-// TODO: check if this is actually more efficient at this size
-gf16_elem gf16_poly_eval(gf16_poly p, gf16_idx p_sz, gf16_elem x)
+// optimized version of div for binomial divisor/single eval point, Horner's method on the log/exp tables
+gf16_elem gf16_poly_eval_horner(gf16_poly p, gf16_idx p_sz, gf16_elem x)
 {
 	p_sz -= GF16_SYM_SZ;
-	gf16_elem y = p >> p_sz;
+	gf16_elem y = (p >> p_sz) & GF16_MAX;	// anything above the top term is ignored
+#ifndef GF16_NO_LUT
 	gf16_elem logx = gf16_log[x];
+#endif
 	for (p_sz -= GF16_SYM_SZ; p_sz >= 0; p_sz -= GF16_SYM_SZ)
 	{
+#ifdef GF16_NO_LUT
+		y = gf16_mul(y, x);
+#else
 		if (y)
 			y = gf16_exp[gf16_log[y] + logx];
+#endif
 
 		y ^= ((p >> p_sz) & GF16_MAX);
 	}
 	return y;
 }
 
+// the remainder of p / (x - a) is p(a), gf16_poly_mod() multiplies the dividend by x first so term 0 is split
+//  off and the rest divided, p(a) = p0 + a * (p / x)(a)
+gf16_elem gf16_poly_eval_mod(gf16_poly p, gf16_idx p_sz, gf16_elem x)
+{
+	if (p_sz <= GF16_SYM_SZ)
+		return p & GF16_MAX;
+
+	gf16_poly binomial = ((gf16_poly)1 << GF16_SYM_SZ) | x;
+	return (p & GF16_MAX) ^ gf16_poly_mod(p >> GF16_SYM_SZ, p_sz - GF16_SYM_SZ, binomial, 2 * GF16_SYM_SZ);
+}
+
+gf16_elem gf16_poly_eval(gf16_poly p, gf16_idx p_sz, gf16_elem x)
+{
+#ifdef GF16_EVAL_MOD
+	return gf16_poly_eval_mod(p, p_sz, x);
+#else
+	return gf16_poly_eval_horner(p, p_sz, x);
+#endif
+}
+
 // formal derivative of characteristic 2 keeps only the odd polynomials and reduces the degree by 1 step
 gf16_poly gf16_poly_formal_derivative(gf16_poly p)
 {
@@ -235,4 +388,98 @@ gf16_idx gf16_poly_get_size(gf16_poly p)
 		p_sz += GF16_SYM_SZ;
 
 	return p_sz;
+}
+
+uint8_t gf16_region_lo[1 + GF16_MAX][16];
+uint8_t gf16_region_hi[1 + GF16_MAX][16];
+
+static pthread_once_t gf16_region_once = PTHREAD_ONCE_INIT;
+
+static void gf16_region_build(void)
+{
+	for (int8_t c = 0; c <= GF16_MAX; ++c)
+	{
+		for (int8_t x = 0; x < 16; ++x)
+		{
+			gf16_region_lo[c][x] = gf16_mul(c, x);
+			gf16_region_hi[c][x] = gf16_mul(c, x) << GF16_SYM_SZ;
+		}
+	}
+}
+
+// 512 bytes total so they're generated rather than stored, goes through gf16_mul() so it's the log/exp tables
+//  unless built with NO_LUT. Safe to call more than once and from several threads at once, rs16_fec_init() calls
+//  it so FEC users never need to
+void gf16_region_init(void)
+{
+	pthread_once(&gf16_region_once, gf16_region_build);
+}
+
+// dst = c * src on both nibbles of every byte
+void gf16_region_scale(uint8_t* dst, const uint8_t* src, gf16_elem c, int32_t len)
+{
+	int32_t i = 0;
+#if defined(__AVX2__)
+	const __m256i tlo = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)gf16_region_lo[c]));
+	const __m256i thi = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)gf16_region_hi[c]));
+	const __m256i nib = _mm256_set1_epi8(0x0F);
+	for (; i + 32 <= len; i += 32)
+	{
+		__m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+		__m256i lo = _mm256_shuffle_epi8(tlo, _mm256_and_si256(v, nib));
+		__m256i hi = _mm256_shuffle_epi8(thi, _mm256_and_si256(_mm256_srli_epi64(v, 4), nib));
+		_mm256_storeu_si256((__m256i*)(dst + i), _mm256_xor_si256(lo, hi));
+	}
+#endif
+#if defined(__SSSE3__)
+	const __m128i tlo16 = _mm_loadu_si128((const __m128i*)gf16_region_lo[c]);
+	const __m128i thi16 = _mm_loadu_si128((const __m128i*)gf16_region_hi[c]);
+	const __m128i nib16 = _mm_set1_epi8(0x0F);
+	for (; i + 16 <= len; i += 16)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+		__m128i lo = _mm_shuffle_epi8(tlo16, _mm_and_si128(v, nib16));
+		__m128i hi = _mm_shuffle_epi8(thi16, _mm_and_si128(_mm_srli_epi64(v, 4), nib16));
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_xor_si128(lo, hi));
+	}
+#endif
+	for (; i < len; ++i)
+		dst[i] = gf16_region_lo[c][src[i] & 0xF] ^ gf16_region_hi[c][src[i] >> 4];
+}
+
+// dst ^= c * src, the multiply-accumulate the packet encoder and recovery are built from
+void gf16_region_mul_add(uint8_t* dst, const uint8_t* src, gf16_elem c, int32_t len)
+{
+	if (c == 0)
+		return;
+
+	int32_t i = 0;
+#if defined(__AVX2__)
+	const __m256i tlo = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)gf16_region_lo[c]));
+	const __m256i thi = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)gf16_region_hi[c]));
+	const __m256i nib = _mm256_set1_epi8(0x0F);
+	for (; i + 32 <= len; i += 32)
+	{
+		__m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+		__m256i lo = _mm256_shuffle_epi8(tlo, _mm256_and_si256(v, nib));
+		__m256i hi = _mm256_shuffle_epi8(thi, _mm256_and_si256(_mm256_srli_epi64(v, 4), nib));
+		__m256i d = _mm256_loadu_si256((const __m256i*)(dst + i));
+		_mm256_storeu_si256((__m256i*)(dst + i), _mm256_xor_si256(d, _mm256_xor_si256(lo, hi)));
+	}
+#endif
+#if defined(__SSSE3__)
+	const __m128i tlo16 = _mm_loadu_si128((const __m128i*)gf16_region_lo[c]);
+	const __m128i thi16 = _mm_loadu_si128((const __m128i*)gf16_region_hi[c]);
+	const __m128i nib16 = _mm_set1_epi8(0x0F);
+	for (; i + 16 <= len; i += 16)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+		__m128i lo = _mm_shuffle_epi8(tlo16, _mm_and_si128(v, nib16));
+		__m128i hi = _mm_shuffle_epi8(thi16, _mm_and_si128(_mm_srli_epi64(v, 4), nib16));
+		__m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_xor_si128(d, _mm_xor_si128(lo, hi)));
+	}
+#endif
+	for (; i < len; ++i)
+		dst[i] ^= gf16_region_lo[c][src[i] & 0xF] ^ gf16_region_hi[c][src[i] >> 4];
 }
\ No newline at end of file
@@ -0,0 +1,254 @@
+#include "gf32.h"
+
+#define PRIME_GF32 0b100101	// the prime polynomial for GF(32), x^5 + x^2 + 1
+// masks that isolate out the term overflow from the result in the scale function, the top 4 bits of each
+//  word are the overflow of its highest term
+#define GF32_R1_OF 0x1084210842108420
+#define GF32_R2_OF 0x318C6318C6318C60
+#define GF32_R3_OF 0x739CE739CE739CE0
+#define GF32_R4_OF 0xF7BDEF7BDEF7BDE0
+#define GF32_R1_R0 ~GF32_R1_OF
+#define GF32_R2_R0 ~GF32_R2_OF
+#define GF32_R3_R0 ~GF32_R3_OF
+#define GF32_R4_R0 ~GF32_R4_OF
+// overflow bit 3 is the only one whose fold overflows again, so it gets folded by its own residue
+#define GF32_OF_LO GF32_R3_OF
+#define GF32_OF_HI (GF32_R4_OF ^ GF32_R3_OF)
+// mask to isolate just the odd terms for the formal derivative, words start on even terms so it's the same for all
+#define GF32_ODD  0x0F83E0F83E0F83E0
+#define GF32_WORD 0x0FFFFFFFFFFFFFFF	// valid term bits of a word
+
+const gf32_elem gf32_exp[GF32_EXP_ENTRIES] = {	// length not a multiple of 2 so duplicate entries + offset needed for easy wraparound of negatives
+	0x01, 0x02, 0x04, 0x08, 0x10, 0x05, 0x0A, 0x14, 0x0D, 0x1A, 0x11, 0x07, 0x0E, 0x1C, 0x1D, 0x1F,
+	0x1B, 0x13, 0x03, 0x06, 0x0C, 0x18, 0x15, 0x0F, 0x1E, 0x19, 0x17, 0x0B, 0x16, 0x09, 0x12,
+	0x01, 0x02, 0x04, 0x08, 0x10, 0x05, 0x0A, 0x14, 0x0D, 0x1A, 0x11, 0x07, 0x0E, 0x1C, 0x1D, 0x1F,
+	0x1B, 0x13, 0x03, 0x06, 0x0C, 0x18, 0x15, 0x0F, 0x1E, 0x19, 0x17, 0x0B, 0x16, 0x09, 0x12};
+
+const gf32_elem* gf32_exp_div = gf32_exp + GF32_MAX;
+
+const gf32_elem gf32_log[1 + GF32_MAX] = {	// log_0 undefined so dummy -1 included to simplify indexing
+	-1, 0x00, 0x01, 0x12, 0x02, 0x05, 0x13, 0x0B, 0x03, 0x1D, 0x06, 0x1B, 0x14, 0x08, 0x0C, 0x17,
+	0x04, 0x0A, 0x1E, 0x11, 0x07, 0x16, 0x1C, 0x1A, 0x15, 0x19, 0x09, 0x10, 0x0D, 0x0E, 0x18, 0x0F};
+
+// simplified galois field multiply by 2 used for generating the Look Up Tables
+gf32_elem gf32_mul2_noLUT(gf32_elem x)
+{
+	x <<= 1;
+	if (x > GF32_MAX)	// if it's not within the bounds of the Galois Field, reduce by the primitive polynomial
+		x ^= PRIME_GF32;
+
+	return x;
+}
+
+gf32_elem gf32_div(gf32_elem a, gf32_elem b)
+{
+	if (b == 0)
+		return -1;	// divide by 0 error, normal operation should never get here
+	if (a == 0)
+		return 0;
+
+	return gf32_exp_div[gf32_log[a] - gf32_log[b]];	// negative indices are valid in C so long as there's valid data there
+}
+
+gf32_elem gf32_mul(gf32_elem a, gf32_elem b)
+{
+	if (a == 0 || b == 0)
+		return 0;
+
+	return gf32_exp[gf32_log[a] + gf32_log[b]];
+}
+
+gf32_elem gf32_pow(gf32_elem x, int8_t power)
+{
+	return gf32_exp[(gf32_log[x] * power) % GF32_MAX];
+}
+
+// power is assumed to be in the range of 0 to GF32_EXP_ENTRIES -1
+gf32_elem gf32_2pow(int8_t power)
+{
+	return gf32_exp[power];
+}
+
+gf32_elem gf32_inverse(gf32_elem x)
+{
+	return gf32_exp_div[-gf32_log[x]];	// negative indices are valid in C so long as there's valid data there
+}
+
+gf32_elem gf32_poly_get_term(gf32_poly p, gf32_idx i)
+{
+	return (p.w[i / GF32_WORD_TERMS] >> (GF32_SYM_SZ * (i % GF32_WORD_TERMS))) & GF32_MAX;
+}
+
+// multiplies by x^n, terms shifted past the last word are dropped
+gf32_poly gf32_poly_shift_up(gf32_poly p, gf32_idx n)
+{
+	gf32_poly r;
+	int8_t ws = n / GF32_WORD_TERMS;
+	int8_t bs = GF32_SYM_SZ * (n % GF32_WORD_TERMS);
+	for (int8_t i = GF32_WORDS - 1; i >= 0; --i)
+	{
+		uint64_t lo = (i - ws >= 0) ? p.w[i - ws] : 0;
+		uint64_t carry = (bs && i - ws - 1 >= 0) ? p.w[i - ws - 1] >> (GF32_SYM_SZ * GF32_WORD_TERMS - bs) : 0;
+		r.w[i] = ((lo << bs) & GF32_WORD) | carry;
+	}
+
+	return r;
+}
+
+// divides by x^n discarding the remainder
+gf32_poly gf32_poly_shift_down(gf32_poly p, gf32_idx n)
+{
+	gf32_poly r;
+	int8_t ws = n / GF32_WORD_TERMS;
+	int8_t bs = GF32_SYM_SZ * (n % GF32_WORD_TERMS);
+	for (int8_t i = 0; i < GF32_WORDS; ++i)
+	{
+		uint64_t hi = (i + ws < GF32_WORDS) ? p.w[i + ws] : 0;
+		uint64_t carry = (bs && i + ws + 1 < GF32_WORDS) ? p.w[i + ws + 1] << (GF32_SYM_SZ * GF32_WORD_TERMS - bs) : 0;
+		r.w[i] = (hi >> bs) | (carry & GF32_WORD);
+	}
+
+	return r;
+}
+
+// keeps only the lowest p_len terms, ie p mod x^p_len
+gf32_poly gf32_poly_truncate(gf32_poly p, gf32_idx p_len)
+{
+	for (int8_t i = 0; i < GF32_WORDS; ++i)
+	{
+		gf32_idx keep = p_len - i * GF32_WORD_TERMS;
+		if (keep <= 0)
+			p.w[i] = 0;
+		else if (keep < GF32_WORD_TERMS)
+			p.w[i] &= ((uint64_t)1 << (GF32_SYM_SZ * keep)) - 1;
+	}
+
+	return p;
+}
+
+gf32_poly gf32_poly_add(gf32_poly p, gf32_poly q)
+{
+	for (int8_t i = 0; i < GF32_WORDS; ++i)
+		p.w[i] ^= q.w[i];
+
+	return p;
+}
+
+int8_t gf32_poly_is_zero(gf32_poly p)
+{
+	uint64_t acc = 0;
+	for (int8_t i = 0; i < GF32_WORDS; ++i)
+		acc |= p.w[i];
+
+	return acc == 0;
+}
+
+// prior to reduction, term can extend up to 4 bits above symbol due to shifting
+// this function is customized to GF(32) with prime polynomial 100101, x^5..x^7 fold straight back down by
+//  x^2 + 1 but x^8 folds to x^3 + x^2 + 1 so overflow bit 3 can't share the shift by 3
+uint64_t gf32_word_reduce(uint64_t p, uint64_t of)
+{
+	return p ^ (of >> 5) ^ ((of & GF32_OF_LO) >> 3) ^ ((of & GF32_OF_HI) >> 6) ^ ((of & GF32_OF_HI) >> 8);
+}
+
+// same as gf16_poly_scale() on a single word
+uint64_t gf32_word_scale(uint64_t p, gf32_elem x)
+{
+	uint64_t r0, r1, r2, r3, r4, of;
+	r0 = (x & 1) ? p : 0;
+	p <<= 1;
+	r1 = (x & 2) ? p : 0;
+	p <<= 1;
+	r2 = (x & 4) ? p : 0;
+	p <<= 1;
+	r3 = (x & 8) ? p : 0;
+	p <<= 1;
+	r4 = (x & 16) ? p : 0;
+
+	of = (r1 & GF32_R1_OF) ^ (r2 & GF32_R2_OF) ^ (r3 & GF32_R3_OF) ^ (r4 & GF32_R4_OF);
+	r0 ^= (r1 & GF32_R1_R0) ^ (r2 & GF32_R2_R0) ^ (r3 & GF32_R3_R0) ^ (r4 & GF32_R4_R0);
+
+	return gf32_word_reduce(r0, of);
+}
+
+// every word is scaled independently, no term crosses a word boundary so there's nothing to carry
+gf32_poly gf32_poly_scale(gf32_poly p, gf32_elem x)
+{
+	for (int8_t i = 0; i < GF32_WORDS; ++i)
+		p.w[i] = gf32_word_scale(p.w[i], x);
+
+	return p;
+}
+
+// Horner's method over the terms of q, terms of the product beyond the last word are dropped
+//  so this also works for products that only need to be correct mod x^n
+gf32_poly gf32_poly_mul(gf32_poly p, gf32_poly q)
+{
+	gf32_poly r = {{0}};
+	for (gf32_idx i = gf32_poly_get_size(q) - 1; i >= 0; --i)
+	{
+		r = gf32_poly_shift_up(r, 1);
+		gf32_elem t = gf32_poly_get_term(q, i);
+		if (t)
+			r = gf32_poly_add(r, gf32_poly_scale(p, t));
+	}
+
+	return r;
+}
+
+// p is dividend, q is divisor and must be monic, p_len and q_len are size in TERMS
+// same as gf16_poly_mod() p is implicitly multiplied by x^(q_len - 1) first, so this gives the check symbols
+//  of a systematic encode directly, only the remainder is returned since the quotient is never used
+gf32_poly gf32_poly_mod(gf32_poly p, gf32_idx p_len, gf32_poly q, gf32_idx q_len)
+{
+	p = gf32_poly_shift_up(p, q_len - 1);
+	q = gf32_poly_shift_up(q, p_len - 1);
+	for (gf32_idx i = p_len + q_len - 2; i >= q_len - 1; --i)
+	{
+		gf32_elem t = gf32_poly_get_term(p, i);
+		if (t)
+			p = gf32_poly_add(p, gf32_poly_scale(q, t));
+		q = gf32_poly_shift_down(q, 1);
+	}
+
+	return p;
+}
+
+gf32_elem gf32_poly_eval(gf32_poly p, gf32_idx p_len, gf32_elem x)
+{
+	gf32_elem y = gf32_poly_get_term(p, p_len - 1);
+	gf32_elem logx = gf32_log[x];
+	for (gf32_idx i = p_len - 2; i >= 0; --i)
+	{
+		if (y)
+			y = gf32_exp[gf32_log[y] + logx];
+
+		y ^= gf32_poly_get_term(p, i);
+	}
+	return y;
+}
+
+// formal derivative of characteristic 2 keeps only the odd polynomials and reduces the degree by 1 step
+gf32_poly gf32_poly_formal_derivative(gf32_poly p)
+{
+	for (int8_t i = 0; i < GF32_WORDS; ++i)
+		p.w[i] &= GF32_ODD;
+
+	return gf32_poly_shift_down(p, 1);
+}
+
+int8_t gf32_poly_get_order(gf32_poly p)
+{
+	return gf32_poly_get_size(p) - 1;
+}
+
+gf32_idx gf32_poly_get_size(gf32_poly p)
+{
+	for (int8_t i = GF32_WORDS - 1; i >= 0; --i)
+	{
+		if (p.w[i])
+			return i * GF32_WORD_TERMS + (64 - __builtin_clzll(p.w[i]) + GF32_SYM_SZ - 1) / GF32_SYM_SZ;
+	}
+
+	return 0;
+}
@@ -0,0 +1,262 @@
+#include "gf64.h"
+
+#define PRIME_GF64 0b1000011	// the prime polynomial for GF(64), x^6 + x^1 + 1
+// masks that isolate out the term overflow from the result in the scale function, the top 5 used bits of each
+//  word are the overflow of its highest term
+#define GF64_R1_OF 0x0041041041041040
+#define GF64_R2_OF 0x00C30C30C30C30C0
+#define GF64_R3_OF 0x01C71C71C71C71C0
+#define GF64_R4_OF 0x03CF3CF3CF3CF3C0
+#define GF64_R5_OF 0x07DF7DF7DF7DF7C0
+#define GF64_R1_R0 ~GF64_R1_OF
+#define GF64_R2_R0 ~GF64_R2_OF
+#define GF64_R3_R0 ~GF64_R3_OF
+#define GF64_R4_R0 ~GF64_R4_OF
+#define GF64_R5_R0 ~GF64_R5_OF
+// masks to isolate just the odd terms for the formal derivative, words hold an odd number of terms so
+//  every other word starts on an odd term
+#define GF64_ODD  0x0000FC0FC0FC0FC0
+#define GF64_EVEN 0x003F03F03F03F03F
+#define GF64_WORD 0x003FFFFFFFFFFFFF	// valid term bits of a word
+
+const gf64_elem gf64_exp[GF64_EXP_ENTRIES] = {	// length not a multiple of 2 so duplicate entries + offset needed for easy wraparound of negatives
+	0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x03, 0x06, 0x0C, 0x18, 0x30, 0x23, 0x05, 0x0A, 0x14, 0x28,
+	0x13, 0x26, 0x0F, 0x1E, 0x3C, 0x3B, 0x35, 0x29, 0x11, 0x22, 0x07, 0x0E, 0x1C, 0x38, 0x33, 0x25,
+	0x09, 0x12, 0x24, 0x0B, 0x16, 0x2C, 0x1B, 0x36, 0x2F, 0x1D, 0x3A, 0x37, 0x2D, 0x19, 0x32, 0x27,
+	0x0D, 0x1A, 0x34, 0x2B, 0x15, 0x2A, 0x17, 0x2E, 0x1F, 0x3E, 0x3F, 0x3D, 0x39, 0x31, 0x21,
+	0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x03, 0x06, 0x0C, 0x18, 0x30, 0x23, 0x05, 0x0A, 0x14, 0x28,
+	0x13, 0x26, 0x0F, 0x1E, 0x3C, 0x3B, 0x35, 0x29, 0x11, 0x22, 0x07, 0x0E, 0x1C, 0x38, 0x33, 0x25,
+	0x09, 0x12, 0x24, 0x0B, 0x16, 0x2C, 0x1B, 0x36, 0x2F, 0x1D, 0x3A, 0x37, 0x2D, 0x19, 0x32, 0x27,
+	0x0D, 0x1A, 0x34, 0x2B, 0x15, 0x2A, 0x17, 0x2E, 0x1F, 0x3E, 0x3F, 0x3D, 0x39, 0x31, 0x21};
+
+const gf64_elem* gf64_exp_div = gf64_exp + GF64_MAX;
+
+const gf64_elem gf64_log[1 + GF64_MAX] = {	// log_0 undefined so dummy -1 included to simplify indexing
+	-1, 0x00, 0x01, 0x06, 0x02, 0x0C, 0x07, 0x1A, 0x03, 0x20, 0x0D, 0x23, 0x08, 0x30, 0x1B, 0x12,
+	0x04, 0x18, 0x21, 0x10, 0x0E, 0x34, 0x24, 0x36, 0x09, 0x2D, 0x31, 0x26, 0x1C, 0x29, 0x13, 0x38,
+	0x05, 0x3E, 0x19, 0x0B, 0x22, 0x1F, 0x11, 0x2F, 0x0F, 0x17, 0x35, 0x33, 0x25, 0x2C, 0x37, 0x28,
+	0x0A, 0x3D, 0x2E, 0x1E, 0x32, 0x16, 0x27, 0x2B, 0x1D, 0x3C, 0x2A, 0x15, 0x14, 0x3B, 0x39, 0x3A};
+
+// simplified galois field multiply by 2 used for generating the Look Up Tables
+gf64_elem gf64_mul2_noLUT(gf64_elem x)
+{
+	x <<= 1;
+	if (x > GF64_MAX)	// if it's not within the bounds of the Galois Field, reduce by the primitive polynomial
+		x ^= PRIME_GF64;
+
+	return x;
+}
+
+gf64_elem gf64_div(gf64_elem a, gf64_elem b)
+{
+	if (b == 0)
+		return -1;	// divide by 0 error, normal operation should never get here
+	if (a == 0)
+		return 0;
+
+	return gf64_exp_div[gf64_log[a] - gf64_log[b]];	// negative indices are valid in C so long as there's valid data there
+}
+
+gf64_elem gf64_mul(gf64_elem a, gf64_elem b)
+{
+	if (a == 0 || b == 0)
+		return 0;
+
+	return gf64_exp[gf64_log[a] + gf64_log[b]];
+}
+
+gf64_elem gf64_pow(gf64_elem x, int8_t power)
+{
+	return gf64_exp[(gf64_log[x] * power) % GF64_MAX];
+}
+
+// power is assumed to be in the range of 0 to GF64_EXP_ENTRIES -1
+gf64_elem gf64_2pow(int8_t power)
+{
+	return gf64_exp[power];
+}
+
+gf64_elem gf64_inverse(gf64_elem x)
+{
+	return gf64_exp_div[-gf64_log[x]];	// negative indices are valid in C so long as there's valid data there
+}
+
+gf64_elem gf64_poly_get_term(gf64_poly p, gf64_idx i)
+{
+	return (p.w[i / GF64_WORD_TERMS] >> (GF64_SYM_SZ * (i % GF64_WORD_TERMS))) & GF64_MAX;
+}
+
+// multiplies by x^n, terms shifted past the last word are dropped
+gf64_poly gf64_poly_shift_up(gf64_poly p, gf64_idx n)
+{
+	gf64_poly r;
+	int8_t ws = n / GF64_WORD_TERMS;
+	int8_t bs = GF64_SYM_SZ * (n % GF64_WORD_TERMS);
+	for (int8_t i = GF64_WORDS - 1; i >= 0; --i)
+	{
+		uint64_t lo = (i - ws >= 0) ? p.w[i - ws] : 0;
+		uint64_t carry = (bs && i - ws - 1 >= 0) ? p.w[i - ws - 1] >> (GF64_SYM_SZ * GF64_WORD_TERMS - bs) : 0;
+		r.w[i] = ((lo << bs) & GF64_WORD) | carry;
+	}
+
+	return r;
+}
+
+// divides by x^n discarding the remainder
+gf64_poly gf64_poly_shift_down(gf64_poly p, gf64_idx n)
+{
+	gf64_poly r;
+	int8_t ws = n / GF64_WORD_TERMS;
+	int8_t bs = GF64_SYM_SZ * (n % GF64_WORD_TERMS);
+	for (int8_t i = 0; i < GF64_WORDS; ++i)
+	{
+		uint64_t hi = (i + ws < GF64_WORDS) ? p.w[i + ws] : 0;
+		uint64_t carry = (bs && i + ws + 1 < GF64_WORDS) ? p.w[i + ws + 1] << (GF64_SYM_SZ * GF64_WORD_TERMS - bs) : 0;
+		r.w[i] = (hi >> bs) | (carry & GF64_WORD);
+	}
+
+	return r;
+}
+
+// keeps only the lowest p_len terms, ie p mod x^p_len
+gf64_poly gf64_poly_truncate(gf64_poly p, gf64_idx p_len)
+{
+	for (int8_t i = 0; i < GF64_WORDS; ++i)
+	{
+		gf64_idx keep = p_len - i * GF64_WORD_TERMS;
+		if (keep <= 0)
+			p.w[i] = 0;
+		else if (keep < GF64_WORD_TERMS)
+			p.w[i] &= ((uint64_t)1 << (GF64_SYM_SZ * keep)) - 1;
+	}
+
+	return p;
+}
+
+gf64_poly gf64_poly_add(gf64_poly p, gf64_poly q)
+{
+	for (int8_t i = 0; i < GF64_WORDS; ++i)
+		p.w[i] ^= q.w[i];
+
+	return p;
+}
+
+int8_t gf64_poly_is_zero(gf64_poly p)
+{
+	uint64_t acc = 0;
+	for (int8_t i = 0; i < GF64_WORDS; ++i)
+		acc |= p.w[i];
+
+	return acc == 0;
+}
+
+// prior to reduction, term can extend up to 5 bits above symbol due to shifting
+// this function is customized to GF(64) with prime polynomial 1000011
+uint64_t gf64_word_reduce(uint64_t p, uint64_t of)
+{
+	return p ^ (of >> 5) ^ (of >> 6);
+}
+
+// same as gf16_poly_scale() on a single word
+uint64_t gf64_word_scale(uint64_t p, gf64_elem x)
+{
+	uint64_t r0, r1, r2, r3, r4, r5, of;
+	r0 = (x & 1) ? p : 0;
+	p <<= 1;
+	r1 = (x & 2) ? p : 0;
+	p <<= 1;
+	r2 = (x & 4) ? p : 0;
+	p <<= 1;
+	r3 = (x & 8) ? p : 0;
+	p <<= 1;
+	r4 = (x & 16) ? p : 0;
+	p <<= 1;
+	r5 = (x & 32) ? p : 0;
+
+	of = (r1 & GF64_R1_OF) ^ (r2 & GF64_R2_OF) ^ (r3 & GF64_R3_OF) ^ (r4 & GF64_R4_OF) ^ (r5 & GF64_R5_OF);
+	r0 ^= (r1 & GF64_R1_R0) ^ (r2 & GF64_R2_R0) ^ (r3 & GF64_R3_R0) ^ (r4 & GF64_R4_R0) ^ (r5 & GF64_R5_R0);
+
+	return gf64_word_reduce(r0, of);
+}
+
+// every word is scaled independently, no term crosses a word boundary so there's nothing to carry
+gf64_poly gf64_poly_scale(gf64_poly p, gf64_elem x)
+{
+	for (int8_t i = 0; i < GF64_WORDS; ++i)
+		p.w[i] = gf64_word_scale(p.w[i], x);
+
+	return p;
+}
+
+// Horner's method over the terms of q, terms of the product beyond the last word are dropped
+//  so this also works for products that only need to be correct mod x^n
+gf64_poly gf64_poly_mul(gf64_poly p, gf64_poly q)
+{
+	gf64_poly r = {{0}};
+	for (gf64_idx i = gf64_poly_get_size(q) - 1; i >= 0; --i)
+	{
+		r = gf64_poly_shift_up(r, 1);
+		gf64_elem t = gf64_poly_get_term(q, i);
+		if (t)
+			r = gf64_poly_add(r, gf64_poly_scale(p, t));
+	}
+
+	return r;
+}
+
+// p is dividend, q is divisor and must be monic, p_len and q_len are size in TERMS
+// same as gf16_poly_mod() p is implicitly multiplied by x^(q_len - 1) first, so this gives the check symbols
+//  of a systematic encode directly, only the remainder is returned since the quotient is never used
+gf64_poly gf64_poly_mod(gf64_poly p, gf64_idx p_len, gf64_poly q, gf64_idx q_len)
+{
+	p = gf64_poly_shift_up(p, q_len - 1);
+	q = gf64_poly_shift_up(q, p_len - 1);
+	for (gf64_idx i = p_len + q_len - 2; i >= q_len - 1; --i)
+	{
+		gf64_elem t = gf64_poly_get_term(p, i);
+		if (t)
+			p = gf64_poly_add(p, gf64_poly_scale(q, t));
+		q = gf64_poly_shift_down(q, 1);
+	}
+
+	return p;
+}
+
+gf64_elem gf64_poly_eval(gf64_poly p, gf64_idx p_len, gf64_elem x)
+{
+	gf64_elem y = gf64_poly_get_term(p, p_len - 1);
+	gf64_elem logx = gf64_log[x];
+	for (gf64_idx i = p_len - 2; i >= 0; --i)
+	{
+		if (y)
+			y = gf64_exp[gf64_log[y] + logx];
+
+		y ^= gf64_poly_get_term(p, i);
+	}
+	return y;
+}
+
+// formal derivative of characteristic 2 keeps only the odd polynomials and reduces the degree by 1 step
+gf64_poly gf64_poly_formal_derivative(gf64_poly p)
+{
+	for (int8_t i = 0; i < GF64_WORDS; ++i)
+		p.w[i] &= (i & 1) ? GF64_EVEN : GF64_ODD;
+
+	return gf64_poly_shift_down(p, 1);
+}
+
+int8_t gf64_poly_get_order(gf64_poly p)
+{
+	return gf64_poly_get_size(p) - 1;
+}
+
+gf64_idx gf64_poly_get_size(gf64_poly p)
+{
+	for (int8_t i = GF64_WORDS - 1; i >= 0; --i)
+	{
+		if (p.w[i])
+			return i * GF64_WORD_TERMS + (64 - __builtin_clzll(p.w[i]) + GF64_SYM_SZ - 1) / GF64_SYM_SZ;
+	}
+
+	return 0;
+}
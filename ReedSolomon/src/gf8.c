@@ -9,6 +9,7 @@
 // mask to isolate just the odd terms for the formal derivative
 #define GF8_ODD   007070707070
 
+#ifndef GF8_NO_LUT
 const gf8_elem gf8_exp[GF8_EXP_ENTRIES] = {	// length not a multiple of 2 so duplicate entries + offset needed for easy wraparound of negatives
 	1, 2, 4, 3, 6, 7, 5,
 	1, 2, 4, 3, 6, 7, 5};
@@ -17,6 +18,7 @@ const gf8_elem* gf8_exp_div = gf8_exp + GF8_MAX;
 
 const gf8_elem gf8_log[8] = {	// log_0 undefined so dummy -1 included to simplify indexing
 	-1, 0, 1, 3, 2, 6, 4, 5};
+#endif // GF8_NO_LUT
 
 // simplified galois field multiply by 2 used for generating the Look Up Tables
 gf8_elem gf8_mul2_noLUT(gf8_elem x)
@@ -28,6 +30,70 @@ gf8_elem gf8_mul2_noLUT(gf8_elem x)
 	return x;
 }
 
+#ifdef GF8_NO_LUT
+// every inverse packed as octal entries in a single immediate, entry x is x^-1 with the 0 entry as a dummy
+#define GF8_INV_PACKED 043276510
+// and 2^i packed the same way, ie the exp table without the duplicate entries
+#define GF8_EXP_PACKED 05763421
+
+// shift and reduce multiply, the carryless product is at most 5 bits and x^3 = x + 1 folds the top 2 bits
+//  back down in a single step
+gf8_elem gf8_mul(gf8_elem a, gf8_elem b)
+{
+	int16_t r, of;
+	r = a & -(b & 1);
+	r ^= (a << 1) & -((b >> 1) & 1);
+	r ^= (a << 2) & -((b >> 2) & 1);
+
+	of = r >> GF8_SYM_SZ;
+	return (r ^ of ^ (of << 1)) & GF8_MAX;
+}
+
+// the same packing as a gf8_poly, so this is just reading a term out of a constant
+gf8_elem gf8_inverse(gf8_elem x)
+{
+	return (GF8_INV_PACKED >> (GF8_SYM_SZ * x)) & GF8_MAX;
+}
+
+gf8_elem gf8_div(gf8_elem a, gf8_elem b)
+{
+	if (b == 0)
+		return -1;	// divide by 0 error, normal operation should never get here
+
+	return gf8_mul(a, gf8_inverse(b));
+}
+
+// square and multiply, the power is taken mod 7 first so negative powers work as well. 0 to any power but 0 is 0,
+//  checked before the mod since 0^7 would otherwise come out as 0^0
+gf8_elem gf8_pow(gf8_elem x, int8_t power)
+{
+	if (x == 0)
+		return power == 0;
+
+	power %= GF8_MAX;
+	if (power < 0)
+		power += GF8_MAX;
+
+	gf8_elem y = 1;
+	for (; power; power >>= 1)
+	{
+		if (power & 1)
+			y = gf8_mul(y, x);
+		x = gf8_mul(x, x);
+	}
+
+	return y;
+}
+
+// power is assumed to be in the range of 0 to GF8_EXP_ENTRIES -1 same as the LUT version
+gf8_elem gf8_2pow(int8_t power)
+{
+	if (power >= GF8_MAX)
+		power -= GF8_MAX;
+
+	return (GF8_EXP_PACKED >> (GF8_SYM_SZ * power)) & GF8_MAX;
+}
+#else
 gf8_elem gf8_div(gf8_elem a, gf8_elem b)
 {
 	if (b == 0)
@@ -46,9 +112,13 @@ gf8_elem gf8_mul(gf8_elem a, gf8_elem b)
 	return gf8_exp[gf8_log[a] + gf8_log[b]];
 }
 
+// 0 has no log so it's handled the same as the table-less version
 gf8_elem gf8_pow(gf8_elem x, int8_t power)
 {
-	return gf8_exp[(gf8_log[x] * power) % GF8_EXP_ENTRIES];
+	if (x == 0)
+		return power == 0;
+
+	return gf8_exp_div[(gf8_log[x] * power) % GF8_MAX];	// remainder is within +-GF8_MAX so negative powers work through the div offset
 }
 
 // slight optimization since most calls use x = 2 which evaluates to 1
@@ -62,6 +132,7 @@ gf8_elem gf8_inverse(gf8_elem x)
 {
 	return gf8_exp_div[-gf8_log[x]];	// negative indices are valid in C so long as there's valid data there
 }
+#endif // GF8_NO_LUT
 
 // prior to reduction, term can extend up to 2 bits above symbol due to shifting
 // this function is customized to GF(8) with prime polynomial 1011
@@ -70,9 +141,11 @@ gf8_poly gf8_poly_reduce(gf8_poly p, gf8_poly of)
 	return p ^ (of >> 2) ^ (of >> 3);
 }
 
-// optimized for fewer memory accesses
-// TODO: check if multiplies are faster, currently assuming that single shifts and conditional assignment are better
-gf8_poly gf8_poly_scale(gf8_poly p, gf8_elem x)
+// the variants below are all compiled so apps/bench_variants.c can compare them on the same inputs, the defines
+//  only pick which one the library itself uses
+
+// optimized for fewer memory accesses, shifts and conditional assignment
+gf8_poly gf8_poly_scale_select(gf8_poly p, gf8_elem x)
 {
 	gf8_poly r0, r1, r2, of;
 	r0 = (x & 1) ? p : 0;
@@ -87,10 +160,33 @@ gf8_poly gf8_poly_scale(gf8_poly p, gf8_elem x)
 	return gf8_poly_reduce(r0, of);
 }
 
+// multiplies by the isolated bits of x instead of selecting, same as gf8_poly_mul() does per term
+gf8_poly gf8_poly_scale_mul(gf8_poly p, gf8_elem x)
+{
+	gf8_poly r0, r1, r2, of;
+	r0 = (x & 1) * p;
+	r1 = (x & 2) * p;
+	r2 = (x & 4) * p;
+
+	of = (r1 & GF8_R1_OF) ^ (r2 & GF8_R2_OF);
+	r0 ^= (r1 & GF8_R1_R0) ^ (r2 & GF8_R2_R0);
+
+	return gf8_poly_reduce(r0, of);
+}
+
+gf8_poly gf8_poly_scale(gf8_poly p, gf8_elem x)
+{
+#ifdef GF8_SCALE_MUL
+	return gf8_poly_scale_mul(p, x);
+#else
+	return gf8_poly_scale_select(p, x);
+#endif
+}
+
 // Assumes that result can never be longer than 10 terms, and the shorter polynomial is in q
 //  currently assuming the second multiplier is no more than 5 terms, this is just enough for
 //  Reed Solomon with a max of 6 check symbols with specific optimizations
-gf8_poly gf8_poly_mul(gf8_poly p, gf8_poly q)
+gf8_poly gf8_poly_mul_unrolled(gf8_poly p, gf8_poly q)
 {
 	gf8_poly r0, r1, r2, of;
 	// term 0
@@ -124,6 +220,31 @@ gf8_poly gf8_poly_mul(gf8_poly p, gf8_poly q)
 	return gf8_poly_reduce(r0, of);
 }
 
+// same as gf8_poly_mul_unrolled() as a loop over the terms of q
+gf8_poly gf8_poly_mul_loop(gf8_poly p, gf8_poly q)
+{
+	gf8_poly r0 = 0, r1 = 0, r2 = 0, of;
+	for (gf8_idx i = 0; i < 5 * GF8_SYM_SZ; i += GF8_SYM_SZ)
+	{
+		r0 ^= (q & (1 << i)) * p;
+		r1 ^= (q & (2 << i)) * p;
+		r2 ^= (q & (4 << i)) * p;
+	}
+	of = (r1 & GF8_R1_OF) ^ (r2 & GF8_R2_OF);
+	r0 ^= (r1 & GF8_R1_R0) ^ (r2 & GF8_R2_R0);
+
+	return gf8_poly_reduce(r0, of);
+}
+
+gf8_poly gf8_poly_mul(gf8_poly p, gf8_poly q)
+{
+#ifdef GF8_MUL_LOOP
+	return gf8_poly_mul_loop(p, q);
+#else
+	return gf8_poly_mul_unrolled(p, q);
+#endif
+}
+
 // squeezes one more term out of poly_mul with the assumption that term 0 of q is always 1
 gf8_poly gf8_poly_mul_q0_monic(gf8_poly p, gf8_poly q)
 {
@@ -150,23 +271,48 @@ gf8_poly gf8_poly_mod(gf8_poly p, gf8_idx p_sz, gf8_poly q, gf8_idx q_sz)
 	return p;
 }
 
-// optimized version of div for binomial divisor/single eval point
-// TODO: check if this is actually more efficient at this size
-gf8_elem gf8_poly_eval(gf8_poly p, gf8_idx p_sz, gf8_elem x)
+// optimized version of div for binomial divisor/single eval point, Horner's method on the log/exp tables
+gf8_elem gf8_poly_eval_horner(gf8_poly p, gf8_idx p_sz, gf8_elem x)
 {
 	p_sz -= GF8_SYM_SZ;
-	gf8_elem y = p >> p_sz;
+	gf8_elem y = (p >> p_sz) & GF8_MAX;	// anything above the top term is ignored
+#ifndef GF8_NO_LUT
 	gf8_elem logx = gf8_log[x];
+#endif
 	for (p_sz -= GF8_SYM_SZ; p_sz >= 0; p_sz -= GF8_SYM_SZ)
 	{
+#ifdef GF8_NO_LUT
+		y = gf8_mul(y, x);
+#else
 		if (y)
 			y = gf8_exp[gf8_log[y] + logx];
+#endif
 
 		y ^= ((p >> p_sz) & GF8_MAX);
 	}
 	return y;
 }
 
+// the remainder of p / (x - a) is p(a), gf8_poly_mod() multiplies the dividend by x first so term 0 is split
+//  off and the rest divided, p(a) = p0 + a * (p / x)(a)
+gf8_elem gf8_poly_eval_mod(gf8_poly p, gf8_idx p_sz, gf8_elem x)
+{
+	if (p_sz <= GF8_SYM_SZ)
+		return p & GF8_MAX;
+
+	gf8_poly binomial = ((gf8_poly)1 << GF8_SYM_SZ) | x;
+	return (p & GF8_MAX) ^ gf8_poly_mod(p >> GF8_SYM_SZ, p_sz - GF8_SYM_SZ, binomial, 2 * GF8_SYM_SZ);
+}
+
+gf8_elem gf8_poly_eval(gf8_poly p, gf8_idx p_sz, gf8_elem x)
+{
+#ifdef GF8_EVAL_MOD
+	return gf8_poly_eval_mod(p, p_sz, x);
+#else
+	return gf8_poly_eval_horner(p, p_sz, x);
+#endif
+}
+
 // formal derivative of characteristic 2 keeps only the odd polynomials and reduces the degree by 1 step
 gf8_poly gf8_poly_formal_derivative(gf8_poly p)
 {
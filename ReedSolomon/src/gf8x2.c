@@ -0,0 +1,73 @@
+#include "gf8x2.h"
+
+// the single lane masks from gf8.c repeated in both lanes, they all fit within 32 bits
+#define GF8X2_R1_OF (011111111110ULL * GF8X2_LANE_LO)
+#define GF8X2_R2_OF (033333333330ULL * GF8X2_LANE_LO)
+#define GF8X2_R1_R0 (006666666666ULL * GF8X2_LANE_LO)
+#define GF8X2_R2_R0 (004444444444ULL * GF8X2_LANE_LO)
+#define GF8X2_TERM_LO (001111111111ULL * GF8X2_LANE_LO)	// bit 0 of every term in both lanes
+
+gf8x2_poly gf8x2_pack(gf8_poly lane0, gf8_poly lane1)
+{
+	return ((uint32_t)lane0) | ((gf8x2_poly)(uint32_t)lane1 << GF8X2_LANE_SZ);
+}
+
+gf8_poly gf8x2_get_lane(gf8x2_poly p, int8_t lane)
+{
+	return (gf8_poly)(uint32_t)(p >> (lane * GF8X2_LANE_SZ));
+}
+
+// same as gf8_poly_reduce(), the overflow bits are never below bit 3 of a lane so nothing is shifted into the lane below
+static gf8x2_poly gf8x2_poly_reduce(gf8x2_poly p, gf8x2_poly of)
+{
+	return p ^ (of >> 2) ^ (of >> 3);
+}
+
+// same as gf8_poly_scale() except each lane can be scaled by a different element, so the conditional
+//  selects become masks built from each lane's bits of x
+gf8x2_poly gf8x2_poly_scale(gf8x2_poly p, gf8x2_poly x)
+{
+	gf8x2_poly r0, r1, r2, of;
+	r0 = p & (((x >> 0) & GF8X2_LANE_LO) * GF8X2_LANE);
+	p <<= 1;
+	r1 = p & (((x >> 1) & GF8X2_LANE_LO) * GF8X2_LANE);
+	p <<= 1;
+	r2 = p & (((x >> 2) & GF8X2_LANE_LO) * GF8X2_LANE);
+
+	of = (r1 & GF8X2_R1_OF) ^ (r2 & GF8X2_R2_OF);
+	r0 ^= (r1 & GF8X2_R1_R0) ^ (r2 & GF8X2_R2_R0);
+
+	return gf8x2_poly_reduce(r0, of);
+}
+
+// term by term product, term i of the result is term i of p times term i of q
+//  the same as scale but with the select masks built per term instead of per lane
+gf8x2_poly gf8x2_poly_mul_terms(gf8x2_poly p, gf8x2_poly q)
+{
+	gf8x2_poly r0, r1, r2, of;
+	r0 = p & (((q >> 0) & GF8X2_TERM_LO) * GF8_MAX);
+	r1 = (p & (((q >> 1) & GF8X2_TERM_LO) * GF8_MAX)) << 1;
+	r2 = (p & (((q >> 2) & GF8X2_TERM_LO) * GF8_MAX)) << 2;
+
+	of = (r1 & GF8X2_R1_OF) ^ (r2 & GF8X2_R2_OF);
+	r0 ^= (r1 & GF8X2_R1_R0) ^ (r2 & GF8X2_R2_R0);
+
+	return gf8x2_poly_reduce(r0, of);
+}
+
+// same as gf8_poly_mod() on both lanes at once, q must be the same monic divisor in both lanes but each lane
+//  of p is reduced by its own leading terms. p_sz should cover the larger of the 2 lanes
+gf8x2_poly gf8x2_poly_mod(gf8x2_poly p, gf8_idx p_sz, gf8x2_poly q, gf8_idx q_sz)
+{
+	p_sz -= GF8_SYM_SZ;
+	q_sz -= GF8_SYM_SZ;
+	p <<= q_sz;
+	q <<= p_sz;
+	for (gf8_idx i = p_sz + q_sz; i >= q_sz; i -= GF8_SYM_SZ)
+	{
+		p ^= gf8x2_poly_scale(q, (p >> i) & (GF8_MAX * GF8X2_LANE_LO));
+		q >>= GF8_SYM_SZ;
+	}
+
+	return p;
+}
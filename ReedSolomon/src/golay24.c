@@ -0,0 +1,173 @@
+// extended binary Golay (24,12) code, see golay24.h
+#include "golay24.h"
+#include <pthread.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#define GOLAY23_G 0xC75	// x^11 + x^10 + x^6 + x^5 + x^4 + x^2 + 1, generator of the cyclic (23,12) Golay code
+
+uint16_t golay24_chk[1 + GOLAY24_DATA_MASK + 1];
+uint32_t golay24_errata[1 + GOLAY24_DATA_MASK];
+
+// check bits straight from the polynomial division, only used to build the table
+uint16_t golay24_get_chk_noLUT(uint16_t data)
+{
+	uint32_t r = (uint32_t)data << 11;
+	for (int8_t i = 22; i >= 11; --i)
+	{
+		if (r & (1 << i))
+			r ^= GOLAY23_G << (i - 11);
+	}
+	r <<= 1;
+	r |= __builtin_parity(((uint32_t)data << 12) | r);	// extend to even weight
+
+	return r;
+}
+
+static pthread_once_t golay24_once = PTHREAD_ONCE_INIT;
+static _Thread_local const uint8_t* golay24_from = NULL;	// set by golay24_init_from() around its pthread_once()
+
+// pthread_once() runs this on the thread that calls it, so golay24_from is that caller's tables if it has any
+static void golay24_build(void)
+{
+	if (golay24_from)
+	{
+		memcpy(golay24_chk, golay24_from, sizeof(golay24_chk));
+		memcpy(golay24_errata, golay24_from + sizeof(golay24_chk), sizeof(golay24_errata));
+		return;
+	}
+
+	for (int16_t d = 0; d <= GOLAY24_DATA_MASK; ++d)
+		golay24_chk[d] = golay24_get_chk_noLUT(d);
+
+	for (int16_t s = 0; s <= GOLAY24_DATA_MASK; ++s)
+		golay24_errata[s] = GOLAY24_FAIL;
+
+	// every pattern of 0 to 3 bit errors lands on its own syndrome since the minimum distance is 8
+	golay24_errata[0] = 0;
+	for (int8_t a = 0; a < 24; ++a)
+	{
+		uint32_t ea = 1UL << a;
+		golay24_errata[golay24_get_syndrome(ea)] = ea | 1UL << 24;
+		for (int8_t b = a + 1; b < 24; ++b)
+		{
+			uint32_t eb = ea | 1UL << b;
+			golay24_errata[golay24_get_syndrome(eb)] = eb | 2UL << 24;
+			for (int8_t c = b + 1; c < 24; ++c)
+			{
+				uint32_t ec = eb | 1UL << c;
+				golay24_errata[golay24_get_syndrome(ec)] = ec | 3UL << 24;
+			}
+		}
+	}
+}
+
+// safe to call more than once and from several threads at once
+void golay24_init(void)
+{
+	pthread_once(&golay24_once, golay24_build);
+}
+
+// same as golay24_init() but copies the tables from tables, golay24_chk then golay24_errata, instead of building
+//  them, eg from a table file. Does nothing if they've already been built or loaded
+void golay24_init_from(const void* tables)
+{
+	golay24_from = tables;
+	pthread_once(&golay24_once, golay24_build);
+	golay24_from = NULL;
+}
+
+golay24_word golay24_encode(uint16_t data)
+{
+	data &= GOLAY24_DATA_MASK;
+	return ((golay24_word)data << GOLAY24_DATA_BITS) | golay24_chk[data];
+}
+
+uint16_t golay24_get_syndrome(golay24_word recv)
+{
+	return (recv & GOLAY24_DATA_MASK) ^ golay24_chk[(recv >> GOLAY24_DATA_BITS) & GOLAY24_DATA_MASK];
+}
+
+// error pattern with the number of bit errors in the top byte, or GOLAY24_FAIL
+uint32_t golay24_get_errata(golay24_word recv)
+{
+	return golay24_errata[golay24_get_syndrome(recv)];
+}
+
+// returns the 12 data bits or -1 if there were 4 errors, err_cnt gets the number of bits corrected if not NULL
+int16_t golay24_decode(golay24_word recv, int8_t* err_cnt)
+{
+	uint32_t errata = golay24_get_errata(recv);
+	if (err_cnt)
+		*err_cnt = errata >> 24;
+	if (errata == GOLAY24_FAIL)
+		return -1;
+
+	return ((recv ^ errata) >> GOLAY24_DATA_BITS) & GOLAY24_DATA_MASK;
+}
+
+void golay24_encode_batch(const uint16_t* data, golay24_word* cw, int32_t n)
+{
+	int32_t i = 0;
+#if defined(__AVX2__)
+	const __m256i data_mask = _mm256_set1_epi32(GOLAY24_DATA_MASK);
+	for (; i + 8 <= n; i += 8)
+	{
+		__m256i d = _mm256_and_si256(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(data + i))), data_mask);
+		__m256i chk = _mm256_and_si256(_mm256_i32gather_epi32((const int*)golay24_chk, d, 2), data_mask);	// 2 byte stride, top half is the next entry
+		_mm256_storeu_si256((__m256i*)(cw + i), _mm256_or_si256(_mm256_slli_epi32(d, GOLAY24_DATA_BITS), chk));
+	}
+#endif
+	for (; i < n; ++i)
+		cw[i] = golay24_encode(data[i]);
+}
+
+// data gets the corrected data bits of each word, left as received for uncorrectable ones, and err_cnt (if not
+//  NULL) the number of bits corrected or -1. Returns the number of uncorrectable words
+int32_t golay24_decode_batch(const golay24_word* recv, uint16_t* data, int8_t* err_cnt, int32_t n)
+{
+	int32_t fails = 0;
+	int32_t i = 0;
+#if defined(__AVX2__)
+	const __m256i data_mask = _mm256_set1_epi32(GOLAY24_DATA_MASK);
+	const __m256i fail = _mm256_set1_epi32(GOLAY24_FAIL);
+	const __m256i pattern_mask = _mm256_set1_epi32(GOLAY24_MASK);
+	// picks the low 16 bits of each 32 bit lane for the data and the top byte for the counts
+	const __m256i pack_data = _mm256_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1,
+		0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1);
+	const __m256i pack_cnt = _mm256_setr_epi8(3, 7, 11, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		3, 7, 11, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+	for (; i + 8 <= n; i += 8)
+	{
+		__m256i r = _mm256_loadu_si256((const __m256i*)(recv + i));
+		__m256i d = _mm256_and_si256(_mm256_srli_epi32(r, GOLAY24_DATA_BITS), data_mask);
+		__m256i chk = _mm256_i32gather_epi32((const int*)golay24_chk, d, 2);
+		__m256i synd = _mm256_and_si256(_mm256_xor_si256(r, chk), data_mask);
+		__m256i errata = _mm256_i32gather_epi32((const int*)golay24_errata, synd, 4);
+		__m256i out = _mm256_and_si256(_mm256_srli_epi32(_mm256_xor_si256(r, _mm256_and_si256(errata, pattern_mask)), GOLAY24_DATA_BITS), data_mask);
+
+		__m256i packed = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(out, pack_data), 0x08);	// qwords 0 and 2 to the bottom
+		_mm_storeu_si128((__m128i*)(data + i), _mm256_castsi256_si128(packed));
+		fails += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(errata, fail))));
+		if (err_cnt)
+		{
+			__m256i cnt = _mm256_shuffle_epi8(errata, pack_cnt);
+			uint64_t cnt8 = (uint32_t)_mm256_extract_epi32(cnt, 0) | (uint64_t)(uint32_t)_mm256_extract_epi32(cnt, 4) << 32;
+			memcpy(err_cnt + i, &cnt8, sizeof(cnt8));
+		}
+	}
+#endif
+	for (; i < n; ++i)
+	{
+		uint32_t errata = golay24_get_errata(recv[i]);
+		fails += errata == GOLAY24_FAIL;
+		data[i] = (((recv[i] ^ errata) & GOLAY24_MASK) >> GOLAY24_DATA_BITS) & GOLAY24_DATA_MASK;
+		if (err_cnt)
+			err_cnt[i] = errata >> 24;
+	}
+
+	return fails;
+}
@@ -0,0 +1,162 @@
+// shape bucketed batch decoding for mixed rs8 and rs16 traffic, see rs_batch.h
+#include "rs_batch.h"
+#include "rs_gf8.h"
+#include "rs_gf8x2.h"
+#include "rs_gf16.h"
+#include "rs_telemetry.h"
+
+#define RS_BATCH_SHAPES (RS_BATCH_CODES * (1 + GF16_MAX))	// a group for every code and chk_syms pair
+
+#define RS_BATCH_RS8_MASK 07777777	// the 7 symbols of an rs8 word, anything above is ignored like rs8_get_errata() does
+
+// safe to call more than once and from several threads at once, rs_batch_get_errata() calls it itself so this
+//  only moves building the rs16 syndrome table out of the first call
+void rs_batch_init(void)
+{
+	rs16_synd_lut_init();
+}
+
+// the first stage for a single rs8 word, leaves the Forney syndromes and erasure locator in eval and loc for the
+//  erasure bucket
+static rs_batch_bucket rs8_batch_classify(gf8_poly synd, int8_t chk_syms, int8_t e_pos, int64_t* eval, int64_t* loc)
+{
+	int8_t erase_cnt = __builtin_popcount((uint8_t)e_pos);
+	if (erase_cnt > chk_syms)
+	{
+		RS_TELEM(RS_TELEM_RS8, RS_OUT_ERASE_OVERFLOW, 0, erase_cnt);
+		return RS_BUCKET_FAILED;
+	}
+	if (!synd)
+	{
+		RS_TELEM(RS_TELEM_RS8, RS_OUT_CLEAN, 0, 0);	// counted here since clean words never reach the scalar decoder
+		return RS_BUCKET_CLEAN;
+	}
+	if (!e_pos)
+		return RS_BUCKET_ERRORS;
+
+	*loc = rs8_get_erasure_locator(e_pos);
+	*eval = rs8_get_errata_evaluator(synd, chk_syms * GF8_SYM_SZ, *loc);
+	return (*eval >> erase_cnt * GF8_SYM_SZ) ? RS_BUCKET_ERRORS : RS_BUCKET_ERASURE;
+}
+
+static rs_batch_bucket rs16_batch_classify(gf16_poly synd, int8_t chk_syms, int16_t e_pos, int64_t* eval, int64_t* loc)
+{
+	int8_t erase_cnt = __builtin_popcount((uint16_t)e_pos);
+	if (erase_cnt > chk_syms)
+	{
+		RS_TELEM(RS_TELEM_RS16, RS_OUT_ERASE_OVERFLOW, 0, erase_cnt);
+		return RS_BUCKET_FAILED;
+	}
+	if (!synd)
+	{
+		RS_TELEM(RS_TELEM_RS16, RS_OUT_CLEAN, 0, 0);
+		return RS_BUCKET_CLEAN;
+	}
+	if (!e_pos)
+		return RS_BUCKET_ERRORS;
+
+	*loc = rs16_get_erasure_locator(e_pos);
+	*eval = rs16_get_errata_evaluator(synd, chk_syms * GF16_SYM_SZ, *loc);
+	return (*eval >> erase_cnt * GF16_SYM_SZ) ? RS_BUCKET_ERRORS : RS_BUCKET_ERASURE;
+}
+
+static void rs_batch_chunk(const rs_batch_req* req, int64_t* errata, int16_t cnt, int32_t* bucket_cnt)
+{
+	int16_t start[RS_BATCH_SHAPES + 1] = {0};
+	int16_t order[RS_BATCH_MAX];
+
+	// counting sort by shape so each group shares its field and chk_syms
+	for (int16_t i = 0; i < cnt; ++i)
+		++start[req[i].code * (1 + GF16_MAX) + req[i].chk_syms + 1];
+	for (int16_t s = 0; s < RS_BATCH_SHAPES; ++s)
+		start[s + 1] += start[s];
+	int16_t fill[RS_BATCH_SHAPES];
+	for (int16_t s = 0; s < RS_BATCH_SHAPES; ++s)
+		fill[s] = start[s];
+	for (int16_t i = 0; i < cnt; ++i)
+		order[fill[req[i].code * (1 + GF16_MAX) + req[i].chk_syms]++] = i;
+
+	// the first stage, syndromes per group then the bucket of every word. Only the erasure and error buckets need
+	//  anything more so only they are kept, with whatever the first stage already worked out for them
+	int16_t bucket[RS_BUCKET_CNT][RS_BATCH_MAX];
+	int16_t bucket_len[RS_BUCKET_CNT] = {0};
+	int64_t synd[RS_BATCH_MAX], eval[RS_BATCH_MAX], loc[RS_BATCH_MAX];
+	for (int16_t s = 0; s < RS_BATCH_SHAPES; ++s)
+	{
+		int8_t chk_syms = s % (1 + GF16_MAX);
+		int16_t g = start[s];
+		if (s < 1 + GF16_MAX)
+		{
+			gf8_poly mask = (1 << chk_syms * GF8_SYM_SZ) - 1;
+			for (; g < start[s + 1]; g += 2)
+			{
+				// an odd word out goes in lane 0 alongside a 0, which costs the same as doing it on its own
+				int16_t a = order[g], b = g + 1 < start[s + 1] ? order[g + 1] : -1;
+				gf8x2_poly pair = rs8x2_get_syndromes(gf8x2_pack(req[a].recv & RS_BATCH_RS8_MASK,
+					b < 0 ? 0 : req[b].recv & RS_BATCH_RS8_MASK), chk_syms);
+				synd[a] = gf8x2_get_lane(pair, 0) & mask;
+				if (b >= 0)
+					synd[b] = gf8x2_get_lane(pair, 1) & mask;
+			}
+			for (g = start[s]; g < start[s + 1]; ++g)
+			{
+				int16_t i = order[g];
+				rs_batch_bucket k = rs8_batch_classify(synd[i], chk_syms, req[i].e_pos, &eval[i], &loc[i]);
+				bucket[k][bucket_len[k]++] = i;
+			}
+		}
+		else
+		{
+			for (; g < start[s + 1]; ++g)
+			{
+				int16_t i = order[g];
+				synd[i] = rs16_get_syndromes_table(req[i].recv, GF16_MAX * GF16_SYM_SZ, chk_syms);
+				rs_batch_bucket k = rs16_batch_classify(synd[i], chk_syms, req[i].e_pos, &eval[i], &loc[i]);
+				bucket[k][bucket_len[k]++] = i;
+			}
+		}
+	}
+
+	for (int16_t j = 0; j < bucket_len[RS_BUCKET_CLEAN]; ++j)
+		errata[bucket[RS_BUCKET_CLEAN][j]] = 0;
+	for (int16_t j = 0; j < bucket_len[RS_BUCKET_FAILED]; ++j)
+		errata[bucket[RS_BUCKET_FAILED][j]] = -1;
+
+	for (int16_t j = 0; j < bucket_len[RS_BUCKET_ERASURE]; ++j)
+	{
+		int16_t i = bucket[RS_BUCKET_ERASURE][j];
+		if (req[i].code == RS_BATCH_RS8)
+		{
+			errata[i] = rs8_get_errata_magnitude(eval[i], req[i].chk_syms * GF8_SYM_SZ, loc[i], req[i].e_pos);
+			RS_TELEM(RS_TELEM_RS8, RS_OUT_CORRECTED, 0, __builtin_popcount((uint8_t)req[i].e_pos));
+		}
+		else
+		{
+			errata[i] = rs16_get_errata_magnitude(eval[i], req[i].chk_syms * GF16_SYM_SZ, loc[i], req[i].e_pos);
+			RS_TELEM(RS_TELEM_RS16, RS_OUT_CORRECTED, 0, __builtin_popcount((uint16_t)req[i].e_pos));
+		}
+	}
+
+	for (int16_t j = 0; j < bucket_len[RS_BUCKET_ERRORS]; ++j)
+	{
+		int16_t i = bucket[RS_BUCKET_ERRORS][j];
+		if (req[i].code == RS_BATCH_RS8)
+			errata[i] = rs8_get_errata_synd(synd[i], req[i].chk_syms, req[i].e_pos, req[i].tx_pos);
+		else
+			errata[i] = rs16_get_errata_synd(synd[i], req[i].chk_syms, req[i].e_pos, req[i].tx_pos);
+	}
+
+	if (bucket_cnt)
+	{
+		for (int8_t k = 0; k < RS_BUCKET_CNT; ++k)
+			bucket_cnt[k] += bucket_len[k];
+	}
+}
+
+// errata[i] gets the result for req[i], bucket_cnt can be NULL or RS_BUCKET_CNT counters that get added to
+void rs_batch_get_errata(const rs_batch_req* req, int64_t* errata, int32_t cnt, int32_t* bucket_cnt)
+{
+	rs16_synd_lut_init();
+	for (int32_t base = 0; base < cnt; base += RS_BATCH_MAX)
+		rs_batch_chunk(req + base, errata + base, cnt - base < RS_BATCH_MAX ? cnt - base : RS_BATCH_MAX, bucket_cnt);
+}
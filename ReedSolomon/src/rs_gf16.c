@@ -1,5 +1,8 @@
 // BCH view, systematic encoding Reed Solomon using 3 bit symbols
 #include "rs_gf16.h"
+#include <pthread.h>
+#include "rs_profile.h"
+#include "rs_telemetry.h"
 
 #define RS16_BLOCK_MASK 0xFFFFFFFFFFFFFFF // mask that represents the valid symbol positions
 
@@ -43,17 +46,47 @@ gf16_poly rs16_get_syndromes(gf16_poly p, gf16_idx p_sz, int8_t nsyms)
 	for (; nsyms > 0; --nsyms)	// accumulation done in descending index order
 	{	// which syndromes are used is effected by fcr so if you change that it must be changed here too
 		synd <<= GF16_SYM_SZ;
-		synd |= gf16_poly_eval(p, p_sz, gf16_exp[nsyms]);
+		synd |= gf16_poly_eval(p, p_sz, gf16_2pow(nsyms));
 	}
 
 	return synd;
 }
 
+gf16_poly rs16_synd_lut[GF16_MAX][1 + GF16_MAX];
+
+static pthread_once_t rs16_synd_lut_once = PTHREAD_ONCE_INIT;
+
+static void rs16_synd_lut_build(void)
+{
+	for (int8_t i = 0; i < GF16_MAX; ++i)
+	{
+		for (int8_t v = 0; v <= GF16_MAX; ++v)
+			rs16_synd_lut[i][v] = rs16_get_syndromes((gf16_poly)v << (i * GF16_SYM_SZ), GF16_MAX * GF16_SYM_SZ, GF16_MAX);
+	}
+}
+
+// safe to call more than once and from several threads at once
+void rs16_synd_lut_init(void)
+{
+	pthread_once(&rs16_synd_lut_once, rs16_synd_lut_build);
+}
+
+// same result as rs16_get_syndromes() by summing one table entry per nonzero symbol, anything above p_sz is
+//  ignored the same way so it never reads past the last position. Needs rs16_synd_lut_init() first
+gf16_poly rs16_get_syndromes_table(gf16_poly p, gf16_idx p_sz, int8_t nsyms)
+{
+	gf16_poly synd = 0;
+	p &= RS16_BLOCK_MASK >> (GF16_MAX * GF16_SYM_SZ - p_sz);
+	for (int8_t i = 0; p; ++i, p >>= GF16_SYM_SZ)
+		synd ^= rs16_synd_lut[i][p & GF16_MAX];
+
+	return synd & (((gf16_poly)1 << (nsyms * GF16_SYM_SZ)) - 1);
+}
+
 // erase_pos is encoded such that a set bit indicates the corresponding degree term is erased or in error
 //  might not be faster than listing indices but is a bit more transparent and since the field is small
-//  should have relatively little impact.
-// TODO: verify this ^
-gf16_poly rs16_get_erasure_locator(int16_t erase_pos)
+//  should have relatively little impact. The list version below is there to check this, see apps/bench_variants.c
+gf16_poly rs16_get_erasure_locator_mask(int16_t erase_pos)
 {
 	gf16_poly erase_loc = 1;	// the errata locator polynomial
 	for (int8_t i = 0; i < GF16_MAX; ++i)
@@ -62,7 +95,7 @@ gf16_poly rs16_get_erasure_locator(int16_t erase_pos)
 		{
 			// faster equivalent of gf16_poly_mul() for a monic binomial in the form (ax - 1)
 			// using this form of the roots simplifies later calculations since we know term 0 is a 1
-			erase_loc ^= gf16_poly_scale(erase_loc, gf16_exp[i]) << GF16_SYM_SZ;
+			erase_loc ^= gf16_poly_scale(erase_loc, gf16_2pow(i)) << GF16_SYM_SZ;
 		}
 		erase_pos >>= 1;
 	}
@@ -70,6 +103,29 @@ gf16_poly rs16_get_erasure_locator(int16_t erase_pos)
 	return erase_loc;
 }
 
+// same locator from a list of erased term indices
+gf16_poly rs16_get_erasure_locator_list(const int8_t* erase_list, int8_t erase_cnt)
+{
+	gf16_poly erase_loc = 1;
+	for (int8_t i = 0; i < erase_cnt; ++i)
+		erase_loc ^= gf16_poly_scale(erase_loc, gf16_2pow(erase_list[i])) << GF16_SYM_SZ;
+
+	return erase_loc;
+}
+
+gf16_poly rs16_get_erasure_locator(int16_t erase_pos)
+{
+#ifdef RS16_ERASE_LIST
+	int8_t erase_list[GF16_MAX];
+	int8_t erase_cnt = 0;
+	for (uint16_t e = erase_pos & 0x7FFF; e; e &= e - 1)	// only visits the set bits
+		erase_list[erase_cnt++] = __builtin_ctz(e);
+	return rs16_get_erasure_locator_list(erase_list, erase_cnt);
+#else
+	return rs16_get_erasure_locator_mask(erase_pos);
+#endif
+}
+
 // this can also be used to get the Forney Syndromes
 gf16_poly rs16_get_errata_evaluator(gf16_poly synd, gf16_idx chk_sz, gf16_poly errata_loc)
 {
@@ -104,7 +160,7 @@ gf16_poly rs16_get_errata_magnitude(gf16_poly errata_eval, gf16_idx chk_sz, gf16
 
 		if (errata_pos & 0x8000)
 		{
-			root = gf16_exp[i];
+			root = gf16_2pow(i);
 			ee_res = gf16_poly_eval(errata_eval, chk_sz, root);
 			lp_res = gf16_poly_eval(errata_loc_prime, chk_sz, root);	// chk_sz is guaranteed to be at least as big as errata_loc_prime's actual size
 			errata_mag |= gf16_div(ee_res, lp_res);	// TODO: if converting to position list form, consider adding a pairwise divide function to gf16.c
@@ -157,6 +213,12 @@ gf16_poly rs16_get_error_locator(gf16_poly synd, gf16_idx s_sz)
 		delay += GF16_SYM_SZ;
 	}
 
+	// fewer terms than L means no error pattern the remaining syndromes can describe fits them, eg a lone nonzero
+	//  first syndrome cancels back down to 1. 0 isn't a valid locator, they all have term 0 = 1, so it's returned
+	//  for rs16_get_errata_synd() to report instead of going on to "correct" 0 errors
+	if (gf16_poly_get_size(error_loc) != error_sz + GF16_SYM_SZ)
+		return 0;
+
 	return error_loc;
 }
 
@@ -170,8 +232,8 @@ int16_t rs16_get_error_pos(gf16_poly error_loc, int16_t mask_pos)
 	{
 		error_pos <<= 1;
 		mask_pos <<= 1;
-		if (mask_pos & 0b10000000)	// skips non-received symbols, not strictly required but potentially beneficial since poly eval is relatively expensive
-			error_pos |= !gf16_poly_eval(error_loc, 21, gf16_exp[i]);	// for non-C coders, this means that when it evaluates to 0 we get back a True which is equivalent to 1
+		if (mask_pos & 0x8000)	// skips non-received symbols, not strictly required but potentially beneficial since poly eval is relatively expensive
+			error_pos |= !gf16_poly_eval(error_loc, 60, gf16_2pow(i));	// for non-C coders, this means that when it evaluates to 0 we get back a True which is equivalent to 1
 	}
 
 	return error_pos;
@@ -179,35 +241,65 @@ int16_t rs16_get_error_pos(gf16_poly error_loc, int16_t mask_pos)
 
 // tx_pos inludes set bits for only the valid positions for errors to occur, ie not in untransmitted padding symbols
 gf16_poly rs16_get_errata(gf16_poly recv, gf16_idx r_sz, int8_t chk_syms, int16_t e_pos, int16_t tx_pos)
+{
+	RS_PROF_START(total);
+	RS_PROF_START(t);
+	gf16_poly synd = rs16_get_syndromes(recv, r_sz, chk_syms);
+	RS_PROF_STAGE(RS_PROF_RS16, RS_STAGE_SYNDROMES, t);
+	gf16_poly errata = rs16_get_errata_synd(synd, chk_syms, e_pos, tx_pos);
+	RS_PROF_STAGE(RS_PROF_RS16, RS_STAGE_TOTAL, total);
+	return errata;
+}
+
+// same as rs16_get_errata() but starting from already calculated syndromes
+gf16_poly rs16_get_errata_synd(gf16_poly synd, int8_t chk_syms, int16_t e_pos, int16_t tx_pos)
 {
 	int8_t erase_cnt = __builtin_popcount(e_pos);
 	if (erase_cnt > chk_syms)	// if the number of erasures is greater than the number of check symbols,
+	{
+		RS_TELEM(RS_TELEM_RS16, RS_OUT_ERASE_OVERFLOW, 0, erase_cnt);
 		return -1;	// it's already beyond the Singleton Bound and can't be uniquely decoded so we return an error value
+	}
 
-	gf16_poly e_eval = rs16_get_syndromes(recv, r_sz, chk_syms);
+	gf16_poly e_eval = synd;
 
 	if (e_eval == 0) // no errors
+	{
+		RS_TELEM(RS_TELEM_RS16, RS_OUT_CLEAN, 0, 0);
 		return 0;
+	}
 
 	gf16_idx chk_sz = chk_syms * GF16_SYM_SZ;
 	gf16_poly e_loc = 1;
+	RS_PROF_START(t);	// only stages that actually run get recorded, see rs_profile.h
 
 	if (e_pos) // this check isn't required but shortcuts excess calculations when no erasures specified
 	{
 		e_loc = rs16_get_erasure_locator(e_pos);
 		e_eval = rs16_get_errata_evaluator(e_eval, chk_sz, e_loc);	// compute Forney syndromes
+		RS_PROF_STAGE(RS_PROF_RS16, RS_STAGE_ERASURE_LOC, t);
 	}
 
 	if (erase_cnt != chk_syms)	// skip checking for errors if the maximum number of erasures occurred as we no longer have enough extra data
 	{
-		gf16_poly error_loc = rs16_get_error_locator(e_eval, chk_sz);	// may be smaller than chk_sz but under most conditions this is correct
+		// the first erase_cnt Forney syndromes are consumed by the erasures, only the rest say anything about the errors
+		gf16_idx erase_sz = erase_cnt * GF16_SYM_SZ;
+		gf16_poly error_loc = rs16_get_error_locator(e_eval >> erase_sz, chk_sz - erase_sz);
 		int8_t error_loc_order = gf16_poly_get_order(error_loc);
-		if (2 * error_loc_order > chk_syms - erase_cnt)	// check that the number of errors isn't beyond the Singleton Bound
+		RS_PROF_STAGE(RS_PROF_RS16, RS_STAGE_BERLEKAMP, t);
+		if (!error_loc || 2 * error_loc_order > chk_syms - erase_cnt)	// check that the number of errors isn't beyond the Singleton Bound
+		{
+			RS_TELEM(RS_TELEM_RS16, RS_OUT_BM_ORDER, 0, erase_cnt);
 			return 0xE000000000000000 | error_loc;
+		}
 		int16_t error_pos = rs16_get_error_pos(error_loc, tx_pos & (~e_pos));
 		int8_t error_cnt = __builtin_popcount(error_pos);
+		RS_PROF_STAGE(RS_PROF_RS16, RS_STAGE_CHIEN, t);
 		if (error_cnt != error_loc_order)
+		{
+			RS_TELEM(RS_TELEM_RS16, RS_OUT_ROOT_MISMATCH, 0, erase_cnt);
 			return 0xF000000000000000 | error_pos;	// not enough or too many roots
+		}
 
 		// combine the error and erasure position, locator, and evaluator to the errata versions of themselves
 		e_pos |= error_pos;
@@ -215,10 +307,56 @@ gf16_poly rs16_get_errata(gf16_poly recv, gf16_idx r_sz, int8_t chk_syms, int16_
 		e_eval = rs16_get_errata_evaluator(e_eval, chk_sz, error_loc);
 	}
 
-	return rs16_get_errata_magnitude(e_eval, chk_sz, e_loc, e_pos);
+	gf16_poly errata_mag = rs16_get_errata_magnitude(e_eval, chk_sz, e_loc, e_pos);
+	RS_PROF_STAGE(RS_PROF_RS16, RS_STAGE_FORNEY, t);
+	RS_TELEM(RS_TELEM_RS16, RS_OUT_CORRECTED, __builtin_popcount(e_pos) - erase_cnt, erase_cnt);
+	return errata_mag;
 }
 
 gf16_poly rs16_decode_systematic(gf16_poly recv, gf16_idx r_sz, int8_t chk_syms, int16_t e_pos, int16_t tx_pos)
 {
 	return (recv ^ rs16_get_errata(recv, r_sz, chk_syms, e_pos, tx_pos)) >> chk_syms*GF16_SYM_SZ;
+}
+
+// incremental redundancy, hybrid ARQ style, see rs_gf16.h
+// first transmission, the data plus the top chk_syms of max_chk check symbols, -1 if that shape doesn't fit
+gf16_poly rs16_ir_encode(gf16_poly raw, int8_t chk_syms, int8_t max_chk)
+{
+	if (chk_syms < 0 || chk_syms > max_chk || max_chk >= GF16_MAX)
+		return -1;
+	return rs16_encode_systematic(raw, max_chk) >> (max_chk - chk_syms) * GF16_SYM_SZ;
+}
+
+// the next extra_syms check symbols to send for a word that has chk_syms so far, in the low bits ready to be
+//  appended below it. The data is already in the word so this doesn't need the caller to keep the original around,
+//  at the cost of a full encode. -1 if the symbols asked for aren't all among the max_chk, which can't be confused
+//  with a result since those only fill the low extra_syms symbols
+gf16_poly rs16_ir_extend(gf16_poly sent, int8_t chk_syms, int8_t max_chk, int8_t extra_syms)
+{
+	if (chk_syms < 0 || extra_syms < 1 || chk_syms + extra_syms > max_chk || max_chk >= GF16_MAX)
+		return -1;
+	gf16_poly cw = rs16_encode_systematic(sent >> chk_syms * GF16_SYM_SZ, max_chk);
+	cw >>= (max_chk - chk_syms - extra_syms) * GF16_SYM_SZ;	// drop the ones that still aren't being sent
+	return cw & ((1LL << extra_syms * GF16_SYM_SZ) - 1);
+}
+
+// errata for a word received with chk_syms of the max_chk check symbols, in the same layout as recv. The missing
+//  check symbols are put back below it as erasures so e_pos, tx_pos and the result all stay relative to recv,
+//  failures come back as the same sentinels as rs16_get_errata()
+gf16_poly rs16_ir_get_errata(gf16_poly recv, gf16_idx r_sz, int8_t chk_syms, int8_t max_chk, int16_t e_pos, int16_t tx_pos)
+{
+	int8_t missing = max_chk - chk_syms;
+	int16_t missing_pos = (1 << missing) - 1;
+	gf16_idx missing_sz = missing * GF16_SYM_SZ;
+	gf16_poly errata = rs16_get_errata(recv << missing_sz, r_sz + missing_sz, max_chk, ((e_pos << missing) | missing_pos) & 0x7FFF,
+		((tx_pos << missing) | missing_pos) & 0x7FFF);
+	if ((uint64_t)errata >> 60)	// every failure sentinel has bits set above the code word
+		return errata;
+
+	return errata >> missing_sz;
+}
+
+gf16_poly rs16_ir_decode(gf16_poly recv, gf16_idx r_sz, int8_t chk_syms, int8_t max_chk, int16_t e_pos, int16_t tx_pos)
+{
+	return (recv ^ rs16_ir_get_errata(recv, r_sz, chk_syms, max_chk, e_pos, tx_pos)) >> chk_syms*GF16_SYM_SZ;
 }
\ No newline at end of file
@@ -0,0 +1,368 @@
+// Configurable BCH view, systematic encoding Reed Solomon using 4 bit symbols
+#include "rs_gf16_codec.h"
+
+// masks that isolate out the term overflow from the result in the mul and scale functions,
+//  these only depend on the symbol size so they're shared with gf16.c
+#define RS16C_R1_OF 0x1111111111111111
+#define RS16C_R2_OF 0x3333333333333333
+#define RS16C_R3_OF 0x7777777777777777
+#define RS16C_R1_R0 ~RS16C_R1_OF
+#define RS16C_R2_R0 ~RS16C_R2_OF
+#define RS16C_R3_R0 ~RS16C_R3_OF
+#define RS16C_ODD   0xF0F0F0F0F0F0F0F0
+
+// builds every table and constant the encoder and decoder need so that none of it has to be worked out per call
+//  returns 0 on success or -1 if the polynomial isn't primitive or the code parameters don't fit in a gf16_poly
+int8_t rs16_codec_init(rs16_codec* c, gf16_poly prime, int8_t fcr, int8_t n, int8_t k)
+{
+	if ((prime >> GF16_SYM_SZ) != 1)	// must be exactly degree 4
+		return -1;
+	if (n > GF16_MAX || k < 1 || n - k < 1 || n - k > 14)	// generator must fit with its overflow
+		return -1;
+
+	// exp and log tables, primitive element 2 must cycle through every non-zero element exactly once
+	gf16_elem x = 1;
+	c->log[0] = -1;
+	for (int8_t i = 0; i < GF16_MAX; ++i)
+	{
+		if (x == 0 || (x == 1 && i != 0))	// hit 0 or cycled early so the polynomial isn't primitive
+			return -1;
+		c->exp[i] = x;
+		c->log[x] = i;
+		x <<= 1;
+		if (x > GF16_MAX)
+			x ^= prime;
+	}
+	if (x != 1)	// a reducible polynomial never gets back to 1 at all
+		return -1;
+	for (int8_t i = GF16_MAX; i < RS16_CODEC_EXP_ENTRIES; ++i)
+		c->exp[i] = c->exp[i - GF16_MAX];
+
+	// the overflow of a term j bits above the symbol is x^(4 + j) mod prime which gets folded back into the
+	//  term below it, every set bit b of that residue means shifting overflow bit j right by 4 + j - b,
+	//  grouping those by shift amount gives the fewest mask/shift pairs, ie 2 full width shifts for 10011
+	gf16_poly shift_mask[RS16_CODEC_RED_MAX + 1] = {0};
+	for (int8_t j = 0; j < GF16_SYM_SZ - 1; ++j)
+	{
+		int64_t res = 1 << (GF16_SYM_SZ + j);
+		for (int8_t b = GF16_SYM_SZ + j; b >= GF16_SYM_SZ; --b)
+		{
+			if (res & (1 << b))
+				res ^= prime << (b - GF16_SYM_SZ);
+		}
+
+		uint64_t lane_mask = 0;	// bit j of every term's overflow, ie bit j of every term but the lowest
+		for (int8_t t = GF16_SYM_SZ + j; t < 64; t += GF16_SYM_SZ)
+			lane_mask |= (uint64_t)1 << t;
+
+		for (int8_t b = 0; b < GF16_SYM_SZ; ++b)
+		{
+			if (res & (1 << b))
+				shift_mask[GF16_SYM_SZ + j - b] |= lane_mask;
+		}
+	}
+	c->red_cnt = 0;
+	for (int8_t s = RS16_CODEC_RED_MAX; s > 0; --s)
+	{
+		if (shift_mask[s])
+		{
+			c->red_mask[c->red_cnt] = shift_mask[s];
+			c->red_shift[c->red_cnt] = s;
+			++c->red_cnt;
+		}
+	}
+
+	fcr %= GF16_MAX;
+	if (fcr < 0)
+		fcr += GF16_MAX;
+
+	c->prime = prime;
+	c->fcr = fcr;
+	c->n = n;
+	c->k = k;
+	c->chk_syms = n - k;
+	c->n_sz = n * GF16_SYM_SZ;
+	c->chk_sz = c->chk_syms * GF16_SYM_SZ;
+	c->tx_pos = (1 << n) - 1;
+	c->msg_mask = (1LL << (k * GF16_SYM_SZ)) - 1;
+
+	for (int8_t i = 0; i < GF16_MAX; ++i)
+	{
+		c->synd_root[i] = c->exp[fcr + i];
+		c->root_inv[i] = c->exp[GF16_MAX - i];
+		c->forney_log[i] = (i * (GF16_MAX + 1 - fcr)) % GF16_MAX;	// (1 - fcr) kept non-negative mod 15
+	}
+
+	// generator, multiplying by each monic binomial (x - alpha^(fcr + i)) in turn same as gen_LUTs does
+	c->g_poly = 1;
+	for (int8_t i = 0; i < c->chk_syms; ++i)
+		c->g_poly = rs16_codec_poly_scale(c, c->g_poly, c->synd_root[i]) ^ (c->g_poly << GF16_SYM_SZ);
+
+	return 0;
+}
+
+gf16_elem rs16_codec_mul(const rs16_codec* c, gf16_elem a, gf16_elem b)
+{
+	if (a == 0 || b == 0)
+		return 0;
+
+	return c->exp[c->log[a] + c->log[b]];
+}
+
+gf16_elem rs16_codec_div(const rs16_codec* c, gf16_elem a, gf16_elem b)
+{
+	if (b == 0)
+		return -1;	// divide by 0 error, normal operation should never get here
+	if (a == 0)
+		return 0;
+
+	return c->exp[GF16_MAX + c->log[a] - c->log[b]];
+}
+
+// generic version of gf16_poly_reduce(), folds each group of overflow bits back down by its precomputed shift
+gf16_poly rs16_codec_poly_reduce(const rs16_codec* c, gf16_poly p, gf16_poly of)
+{
+	for (int8_t i = 0; i < c->red_cnt; ++i)
+		p ^= (uint64_t)(of & c->red_mask[i]) >> c->red_shift[i];
+
+	return p;
+}
+
+gf16_poly rs16_codec_poly_scale(const rs16_codec* c, gf16_poly p, gf16_elem x)
+{
+	gf16_poly r0, r1, r2, r3, of;
+	r0 = (x & 1) ? p : 0;
+	p <<= 1;
+	r1 = (x & 2) ? p : 0;
+	p <<= 1;
+	r2 = (x & 4) ? p : 0;
+	p <<= 1;
+	r3 = (x & 8) ? p : 0;
+
+	of = (r1 & RS16C_R1_OF) ^ (r2 & RS16C_R2_OF) ^ (r3 & RS16C_R3_OF);
+	r0 ^= (r1 & RS16C_R1_R0) ^ (r2 & RS16C_R2_R0) ^ (r3 & RS16C_R3_R0);
+
+	return rs16_codec_poly_reduce(c, r0, of);
+}
+
+// same limits as gf16_poly_mul(), no more than 13 terms in q, written as a loop since the compiler unrolls it anyway
+gf16_poly rs16_codec_poly_mul(const rs16_codec* c, gf16_poly p, gf16_poly q)
+{
+	gf16_poly r0, r1, r2, r3, of;
+	r0 = r1 = r2 = r3 = 0;
+	for (gf16_idx i = 0; i < 13 * GF16_SYM_SZ; i += GF16_SYM_SZ)
+	{
+		r0 ^= (q & (1LL << i)) * p;
+		r1 ^= (q & (2LL << i)) * p;
+		r2 ^= (q & (4LL << i)) * p;
+		r3 ^= (q & (8LL << i)) * p;
+	}
+
+	of = (r1 & RS16C_R1_OF) ^ (r2 & RS16C_R2_OF) ^ (r3 & RS16C_R3_OF);
+	r0 ^= (r1 & RS16C_R1_R0) ^ (r2 & RS16C_R2_R0) ^ (r3 & RS16C_R3_R0);
+
+	return rs16_codec_poly_reduce(c, r0, of);
+}
+
+gf16_poly rs16_codec_poly_mul_q0_monic(const rs16_codec* c, gf16_poly p, gf16_poly q)
+{
+	return p ^ (rs16_codec_poly_mul(c, p, q >> GF16_SYM_SZ) << GF16_SYM_SZ);
+}
+
+// p is dividend, q is divisor, p_sz and q_sz are size in BITS not symbols
+gf16_poly rs16_codec_poly_mod(const rs16_codec* c, gf16_poly p, gf16_idx p_sz, gf16_poly q, gf16_idx q_sz)
+{
+	p_sz -= GF16_SYM_SZ;
+	q_sz -= GF16_SYM_SZ;
+	p <<= q_sz;
+	q <<= p_sz;
+	for (gf16_idx i = p_sz + q_sz; i >= q_sz; i -= GF16_SYM_SZ)
+	{
+		p ^= rs16_codec_poly_scale(c, q, (p >> i) & GF16_MAX);
+		q >>= GF16_SYM_SZ;
+	}
+
+	return p;
+}
+
+gf16_elem rs16_codec_poly_eval(const rs16_codec* c, gf16_poly p, gf16_idx p_sz, gf16_elem x)
+{
+	p_sz -= GF16_SYM_SZ;
+	gf16_elem y = (p >> p_sz) & GF16_MAX;	// anything above the top term is ignored
+	gf16_elem logx = c->log[x];
+	for (p_sz -= GF16_SYM_SZ; p_sz >= 0; p_sz -= GF16_SYM_SZ)
+	{
+		if (y)
+			y = c->exp[c->log[y] + logx];
+
+		y ^= ((p >> p_sz) & GF16_MAX);
+	}
+	return y;
+}
+
+// the data length is fixed by the codec so leading 0 data symbols don't need to be counted
+gf16_poly rs16_codec_encode(const rs16_codec* c, gf16_poly raw)
+{
+	raw &= c->msg_mask;
+	gf16_poly chk = rs16_codec_poly_mod(c, raw, c->k * GF16_SYM_SZ, c->g_poly, c->chk_sz + GF16_SYM_SZ);
+	return (raw << c->chk_sz) | chk;
+}
+
+// only the n transmitted terms are evaluated, the padding is all 0s and contributes nothing
+gf16_poly rs16_codec_get_syndromes(const rs16_codec* c, gf16_poly p)
+{
+	gf16_poly synd = 0;
+	for (int8_t i = c->chk_syms - 1; i >= 0; --i)
+	{
+		synd <<= GF16_SYM_SZ;
+		synd |= rs16_codec_poly_eval(c, p, c->n_sz, c->synd_root[i]);
+	}
+
+	return synd;
+}
+
+gf16_poly rs16_codec_get_erasure_locator(const rs16_codec* c, int16_t erase_pos)
+{
+	gf16_poly erase_loc = 1;
+	while (erase_pos)
+	{
+		int8_t i = __builtin_ctz(erase_pos);
+		erase_loc ^= rs16_codec_poly_scale(c, erase_loc, c->exp[i]) << GF16_SYM_SZ;
+		erase_pos &= erase_pos - 1;
+	}
+
+	return erase_loc;
+}
+
+gf16_poly rs16_codec_get_errata_evaluator(const rs16_codec* c, gf16_poly synd, gf16_poly errata_loc)
+{
+	gf16_poly errata_eval = rs16_codec_poly_mul_q0_monic(c, synd, errata_loc);
+	errata_eval &= (1LL << c->chk_sz) - 1;
+	return errata_eval;
+}
+
+// Forney algorithm, same as rs16_get_errata_magnitude() but keeps the X(i)^(1-c) term for arbitrary fcr
+//  and only visits the errata positions instead of the whole block
+gf16_poly rs16_codec_get_errata_magnitude(const rs16_codec* c, gf16_poly errata_eval, gf16_poly errata_loc, int16_t errata_pos)
+{
+	gf16_poly errata_loc_prime = (errata_loc & RS16C_ODD) >> GF16_SYM_SZ;
+	gf16_poly errata_mag = 0;
+	while (errata_pos)
+	{
+		int8_t i = __builtin_ctz(errata_pos);
+		gf16_elem root = c->root_inv[i];
+		gf16_elem ee_res = rs16_codec_poly_eval(c, errata_eval, c->chk_sz, root);
+		gf16_elem lp_res = rs16_codec_poly_eval(c, errata_loc_prime, c->chk_sz, root);
+		if (ee_res && lp_res)
+			errata_mag |= (gf16_poly)c->exp[c->log[ee_res] + GF16_MAX - c->log[lp_res] + c->forney_log[i]] << (i * GF16_SYM_SZ);
+
+		errata_pos &= errata_pos - 1;
+	}
+
+	return errata_mag;
+}
+
+// Berlekamp-Massey, see rs16_get_error_locator() for the naming
+gf16_poly rs16_codec_get_error_locator(const rs16_codec* c, gf16_poly synd, gf16_idx s_sz)
+{
+	gf16_poly error_loc, error_loc_last, error_loc_temp;
+	gf16_elem disc, disc_last;
+	gf16_idx delay, error_sz;
+
+	error_loc = 1;
+	error_loc_last = 1;
+	error_sz = 0;
+	delay = GF16_SYM_SZ;
+	disc_last = 1;
+
+	for (gf16_idx n = 0; n < s_sz; n += GF16_SYM_SZ)
+	{
+		disc = (synd >> n) & GF16_MAX;
+		for (gf16_idx i = GF16_SYM_SZ; i <= error_sz; i += GF16_SYM_SZ)
+		{
+			disc ^= rs16_codec_mul(c, (error_loc >> i) & GF16_MAX, (synd >> (n - i)) & GF16_MAX);
+		}
+
+		if (disc)
+		{
+			error_loc_temp = error_loc;
+			error_loc ^= (rs16_codec_poly_scale(c, error_loc_last, rs16_codec_div(c, disc, disc_last)) << delay);
+
+			if (2 * error_sz <= n)
+			{
+				error_loc_last = error_loc_temp;
+				error_sz = GF16_SYM_SZ + n - error_sz;
+				disc_last = disc;
+				delay = 0;
+			}
+		}
+		delay += GF16_SYM_SZ;
+	}
+
+	if (gf16_poly_get_size(error_loc) != error_sz + GF16_SYM_SZ)	// doesn't fit any pattern in reach, see rs16_get_error_locator()
+		return 0;
+
+	return error_loc;
+}
+
+// Chien search limited to the transmitted positions that aren't already known erasures
+int16_t rs16_codec_get_error_pos(const rs16_codec* c, gf16_poly error_loc, int16_t mask_pos)
+{
+	int16_t error_pos = 0;
+	while (mask_pos)
+	{
+		int8_t i = __builtin_ctz(mask_pos);
+		if (!rs16_codec_poly_eval(c, error_loc, c->chk_sz + GF16_SYM_SZ, c->root_inv[i]))
+			error_pos |= 1 << i;
+
+		mask_pos &= mask_pos - 1;
+	}
+
+	return error_pos;
+}
+
+// same return convention as rs16_get_errata(), including the failure sentinels
+gf16_poly rs16_codec_get_errata(const rs16_codec* c, gf16_poly recv, int16_t e_pos)
+{
+	e_pos &= c->tx_pos;	// erasures in the padding are meaningless
+	int8_t erase_cnt = __builtin_popcount(e_pos);
+	if (erase_cnt > c->chk_syms)
+		return -1;
+
+	gf16_poly e_eval = rs16_codec_get_syndromes(c, recv);
+
+	if (e_eval == 0)
+		return 0;
+
+	gf16_poly e_loc = 1;
+
+	if (e_pos)
+	{
+		e_loc = rs16_codec_get_erasure_locator(c, e_pos);
+		e_eval = rs16_codec_get_errata_evaluator(c, e_eval, e_loc);
+	}
+
+	if (erase_cnt != c->chk_syms)
+	{
+		gf16_idx erase_sz = erase_cnt * GF16_SYM_SZ;
+		gf16_poly error_loc = rs16_codec_get_error_locator(c, e_eval >> erase_sz, c->chk_sz - erase_sz);
+		int8_t error_loc_order = gf16_poly_get_order(error_loc);
+		if (!error_loc || 2 * error_loc_order > c->chk_syms - erase_cnt)
+			return 0xE000000000000000 | error_loc;
+		int16_t error_pos = rs16_codec_get_error_pos(c, error_loc, c->tx_pos & (~e_pos));
+		int8_t error_cnt = __builtin_popcount(error_pos);
+		if (error_cnt != error_loc_order)
+			return 0xF000000000000000 | error_pos;
+
+		e_pos |= error_pos;
+		e_loc = rs16_codec_poly_mul(c, e_loc, error_loc);
+		e_eval = rs16_codec_get_errata_evaluator(c, e_eval, error_loc);
+	}
+
+	return rs16_codec_get_errata_magnitude(c, e_eval, e_loc, e_pos);
+}
+
+gf16_poly rs16_codec_decode(const rs16_codec* c, gf16_poly recv, int16_t e_pos)
+{
+	return (recv ^ rs16_codec_get_errata(c, recv, e_pos)) >> c->chk_sz;
+}
@@ -0,0 +1,149 @@
+// packet level rs16 erasure code, see rs_gf16_fec.h
+#include "rs_gf16_fec.h"
+#include "rs_gf16.h"
+
+// returns 0 on success, -1 if the packets don't fit in an rs16 code word
+int8_t rs16_fec_init(rs16_fec* f, int8_t data_cnt, int8_t parity_cnt)
+{
+	if (data_cnt < 1 || parity_cnt < 1 || data_cnt + parity_cnt > GF16_MAX)
+		return -1;
+
+	gf16_region_init();
+	f->data_cnt = data_cnt;
+	f->parity_cnt = parity_cnt;
+
+	// encoding a single 1 in data term i gives the factor on data packet i in each check symbol
+	for (int8_t i = 0; i < data_cnt; ++i)
+	{
+		gf16_poly chk = rs16_encode_systematic((gf16_poly)1 << (i * GF16_SYM_SZ), parity_cnt);
+		for (int8_t j = 0; j < parity_cnt; ++j)
+			f->enc[j][i] = (chk >> (j * GF16_SYM_SZ)) & GF16_MAX;
+	}
+	for (int16_t c = 0; c < RS16_FEC_CACHE; ++c)
+		f->cache[c].key = -1;
+
+	return 0;
+}
+
+// data is data_cnt packets and parity gets parity_cnt, all len bytes
+void rs16_fec_encode(const rs16_fec* f, const uint8_t* const* data, uint8_t* const* parity, int32_t len)
+{
+	for (int8_t j = 0; j < f->parity_cnt; ++j)
+	{
+		gf16_region_scale(parity[j], data[0], f->enc[j][0], len);
+		for (int8_t i = 1; i < f->data_cnt; ++i)
+			gf16_region_mul_add(parity[j], data[i], f->enc[j][i], len);
+	}
+}
+
+// inverts the matrix taking the data to the packets at the positions in key and keeps the rows for the data packets
+//  that aren't among them. Gauss-Jordan on the matrix with the identity alongside, always invertible since rs16 is MDS
+static void rs16_fec_invert(const rs16_fec* f, int16_t key, rs16_fec_inv* inv)
+{
+	int8_t n = f->data_cnt;
+	gf16_elem a[GF16_MAX][GF16_MAX], b[GF16_MAX][GF16_MAX];
+
+	int8_t s = 0;
+	for (int8_t p = 0; p < f->parity_cnt + n; ++p)
+	{
+		if (!((key >> p) & 1))
+			continue;
+
+		inv->src[s] = p;
+		for (int8_t i = 0; i < n; ++i)
+		{
+			// a parity packet is its row of the encoding matrix, a data packet just itself
+			a[s][i] = p < f->parity_cnt ? f->enc[p][i] : (i == p - f->parity_cnt);
+			b[s][i] = (i == s);
+		}
+		++s;
+	}
+
+	for (int8_t c = 0; c < n; ++c)
+	{
+		int8_t piv = c;
+		while (!a[piv][c])
+			++piv;
+		for (int8_t i = 0; i < n; ++i)
+		{
+			gf16_elem t = a[c][i]; a[c][i] = a[piv][i]; a[piv][i] = t;
+			t = b[c][i]; b[c][i] = b[piv][i]; b[piv][i] = t;
+		}
+
+		gf16_elem scale = gf16_inverse(a[c][c]);
+		for (int8_t i = 0; i < n; ++i)
+		{
+			a[c][i] = gf16_mul(a[c][i], scale);
+			b[c][i] = gf16_mul(b[c][i], scale);
+		}
+		for (int8_t r = 0; r < n; ++r)
+		{
+			gf16_elem x = a[r][c];
+			if (r == c || !x)
+				continue;
+			for (int8_t i = 0; i < n; ++i)
+			{
+				a[r][i] ^= gf16_mul(a[c][i], x);
+				b[r][i] ^= gf16_mul(b[c][i], x);
+			}
+		}
+	}
+
+	// row i of the inverse gives data packet i from the packets in src
+	inv->row_cnt = 0;
+	for (int8_t i = 0; i < n; ++i)
+	{
+		if ((key >> (f->parity_cnt + i)) & 1)
+			continue;
+
+		inv->dst[inv->row_cnt] = i;
+		for (int8_t j = 0; j < n; ++j)
+			inv->coef[inv->row_cnt][j] = b[i][j];
+		++inv->row_cnt;
+	}
+	inv->key = key;
+}
+
+// rebuilds every lost data packet in place in data, lost parity packets are left alone since rs16_fec_encode()
+//  can remake them once the data is back. lost is a mask of code word terms the same as e_pos, parity packet j is
+//  bit j and data packet i is bit parity_cnt + i. Buffers for the lost packets just have to exist, their contents
+//  are ignored. Returns the number of data packets rebuilt or -1 if more packets were lost than there are parity
+int8_t rs16_fec_recover(rs16_fec* f, uint8_t* const* data, const uint8_t* const* parity, int16_t lost, int32_t len)
+{
+	int16_t parity_mask = (1 << f->parity_cnt) - 1;
+	int16_t data_mask = ((1 << f->data_cnt) - 1) << f->parity_cnt;
+	int8_t lost_data = __builtin_popcount(lost & data_mask);
+	if (!lost_data)
+		return 0;
+
+	// only as many parity packets as there are lost data packets are needed, the lowest ones that arrived
+	int16_t key = ~lost & data_mask;
+	int16_t spare = ~lost & parity_mask;
+	if (__builtin_popcount(spare) < lost_data)
+		return -1;
+	for (int8_t i = 0; i < lost_data; ++i)
+	{
+		key |= spare & -spare;
+		spare &= spare - 1;
+	}
+
+	rs16_fec_inv* inv = &f->cache[(key ^ (key >> 6) ^ (key >> 12)) & (RS16_FEC_CACHE - 1)];
+	if (inv->key != key)
+		rs16_fec_invert(f, key, inv);
+
+	const uint8_t* src[GF16_MAX];
+	for (int8_t s = 0; s < f->data_cnt; ++s)
+	{
+		int8_t p = inv->src[s];
+		src[s] = p < f->parity_cnt ? parity[p] : data[p - f->parity_cnt];
+	}
+	for (int8_t r = 0; r < inv->row_cnt; ++r)
+	{
+		uint8_t* dst = data[inv->dst[r]];
+		gf16_region_scale(dst, src[0], inv->coef[r][0], len);
+		for (int8_t s = 1; s < f->data_cnt; ++s)
+			gf16_region_mul_add(dst, src[s], inv->coef[r][s], len);
+	}
+
+	return lost_data;
+}
@@ -0,0 +1,171 @@
+// rs16 product codes, see rs_gf16_product.h
+#include "rs_gf16_product.h"
+#include "rs_gf16.h"
+
+// returns 0 on success, -1 if either code doesn't fit in an rs16 code word
+int8_t rs16_product_init(rs16_product* p, int8_t row_n, int8_t row_chk, int8_t col_n, int8_t col_chk)
+{
+	if (row_n > GF16_MAX || col_n > GF16_MAX || row_chk < 1 || col_chk < 1 || row_chk >= row_n || col_chk >= col_n)
+		return -1;
+
+	p->row_n = row_n;
+	p->row_chk = row_chk;
+	p->col_n = col_n;
+	p->col_chk = col_chk;
+
+	rs16_synd_lut_init();
+	return 0;
+}
+
+// out[j] gets symbol j of every in[i] as its symbol i, in_n symbols in each of the in_cnt words of in
+void rs16_product_transpose(const gf16_poly* in, int8_t in_cnt, int8_t in_n, gf16_poly* out)
+{
+	for (int8_t j = 0; j < in_n; ++j)
+		out[j] = 0;
+	for (int8_t i = 0; i < in_cnt; ++i)
+	{
+		gf16_poly w = in[i];
+		for (int8_t j = 0; j < in_n; ++j, w >>= GF16_SYM_SZ)
+			out[j] |= (w & GF16_MAX) << (i * GF16_SYM_SZ);
+	}
+}
+
+// same thing for erasure masks, bit j of in[i] becomes bit i of out[j]
+static void rs16_product_transpose_mask(const int16_t* in, int8_t in_cnt, int8_t in_n, int16_t* out)
+{
+	for (int8_t j = 0; j < in_n; ++j)
+		out[j] = 0;
+	for (int8_t i = 0; i < in_cnt; ++i)
+	{
+		for (int8_t j = 0; j < in_n; ++j)
+			out[j] |= ((in[i] >> j) & 1) << i;
+	}
+}
+
+// data is col_n - col_chk words of row_n - row_chk symbols, grid gets all col_n rows
+void rs16_product_encode(const rs16_product* p, const gf16_poly* data, gf16_poly* grid)
+{
+	gf16_poly cols[GF16_MAX];
+	int8_t data_rows = p->col_n - p->col_chk;
+
+	for (int8_t i = 0; i < data_rows; ++i)
+		grid[p->col_chk + i] = rs16_encode_systematic(data[i], p->row_chk);
+
+	// data rows are the top of every column so the column data is just the transposed data rows
+	rs16_product_transpose(grid + p->col_chk, data_rows, p->row_n, cols);
+	for (int8_t j = 0; j < p->row_n; ++j)
+		cols[j] = rs16_encode_systematic(cols[j], p->col_chk);
+
+	gf16_poly chk_rows[GF16_MAX];
+	rs16_product_transpose(cols, p->row_n, p->col_chk, chk_rows);
+	for (int8_t i = 0; i < p->col_chk; ++i)
+		grid[i] = chk_rows[i];
+}
+
+// how many symbols of p are nonzero, folds each symbol down into its lowest bit first
+static int8_t rs16_product_sym_cnt(gf16_poly p)
+{
+	p |= p >> 1;
+	p |= p >> 2;
+	return __builtin_popcountll(p & 0x111111111111111);
+}
+
+// decodes every one of the cnt lines of n symbols, erase holds the known erasures of each line and other_fail the
+//  lines that failed in the other direction, which are tried as extra erasures if there's room for all of them.
+//  Corrections of more than max_errs errors count as failures and aren't applied. Returns the lines that changed or
+//  failed, fail gets just the ones that failed, lines that decode get their erasures cleared
+static int16_t rs16_product_pass(gf16_poly* lines, int8_t cnt, int8_t n, int8_t chk, int16_t* erase,
+	int16_t other_fail, int8_t max_errs, int16_t* fail)
+{
+	gf16_poly synd[GF16_MAX];
+	int16_t tx_pos = (1 << n) - 1;
+	int16_t touched = 0;
+	*fail = 0;
+
+	for (int8_t i = 0; i < cnt; ++i)	// in one go so the loop stays tight, most lines are usually clean
+		synd[i] = rs16_get_syndromes_table(lines[i], n * GF16_SYM_SZ, chk);
+
+	for (int8_t i = 0; i < cnt; ++i)
+	{
+		if (!synd[i])
+		{
+			erase[i] = 0;
+			continue;
+		}
+
+		// all of the other direction's failures or none, erasing just some of them would use up check symbols
+		//  while the rest still count as errors
+		int16_t e_pos = erase[i] | other_fail;
+		if (__builtin_popcount(e_pos) > chk)
+			e_pos = erase[i];
+		gf16_poly errata = rs16_get_errata_synd(synd[i], chk, e_pos, tx_pos);
+		if (((uint64_t)errata >> 60) && e_pos != erase[i])	// every failure sentinel has bits set above the code word
+			errata = rs16_get_errata_synd(synd[i], chk, e_pos = erase[i], tx_pos);
+
+		gf16_poly errs = errata;
+		for (int8_t j = 0; j < n; ++j)	// corrected erasures don't count as errors
+		{
+			if ((e_pos >> j) & 1)
+				errs &= ~((gf16_poly)GF16_MAX << (j * GF16_SYM_SZ));
+		}
+
+		touched |= 1 << i;
+		if (((uint64_t)errata >> 60) || rs16_product_sym_cnt(errs) > max_errs)
+			*fail |= 1 << i;
+		else
+		{
+			lines[i] ^= errata;
+			erase[i] = 0;
+		}
+	}
+
+	return touched;
+}
+
+// e_pos is the known erasures in each row or NULL for none. Runs up to max_iter row then column passes, stopping
+//  once a column pass finds nothing left to do, and returns the number of rows and columns that still aren't code
+//  words, ie 0 once every row and column is one.
+//
+// the first row pass only corrects up to 1 less than it could, miscorrected rows are mostly ones that took every
+//  error it could correct, and a row that's failed becomes an erasure in every column while a miscorrected one
+//  just adds errors to them. A burst across several rows then leaves only failed rows for the columns to fill in
+int8_t rs16_product_decode(const rs16_product* p, gf16_poly* grid, const int16_t* e_pos, int8_t max_iter)
+{
+	gf16_poly cols[GF16_MAX];
+	int16_t row_e[GF16_MAX], col_e[GF16_MAX];
+	int16_t row_fail = 0, col_fail = 0;
+
+	for (int8_t i = 0; i < p->col_n; ++i)
+		row_e[i] = e_pos ? e_pos[i] : 0;
+
+	for (int8_t it = 0; it < max_iter; ++it)
+	{
+		int8_t max_errs = (it || p->row_chk < 2) ? p->row_chk : p->row_chk / 2 - 1;
+		rs16_product_pass(grid, p->col_n, p->row_n, p->row_chk, row_e, col_fail, max_errs, &row_fail);
+
+		rs16_product_transpose(grid, p->col_n, p->row_n, cols);
+		rs16_product_transpose_mask(row_e, p->col_n, p->row_n, col_e);
+		int16_t col_touched = rs16_product_pass(cols, p->row_n, p->col_n, p->col_chk, col_e, row_fail, p->col_chk, &col_fail);
+		if (!col_touched && !row_fail)
+			return 0;	// the column pass had nothing to fix, so the rows are all still code words too
+
+		rs16_product_transpose(cols, p->row_n, p->col_n, grid);
+		rs16_product_transpose_mask(col_e, p->row_n, p->col_n, row_e);
+	}
+
+	// out of passes, the last column pass may well have fixed everything so what's left has to be counted afresh
+	int8_t dirty = 0;
+	rs16_product_transpose(grid, p->col_n, p->row_n, cols);
+	for (int8_t i = 0; i < p->col_n; ++i)
+		dirty += rs16_get_syndromes_table(grid[i], p->row_n * GF16_SYM_SZ, p->row_chk) != 0;
+	for (int8_t j = 0; j < p->row_n; ++j)
+		dirty += rs16_get_syndromes_table(cols[j], p->col_n * GF16_SYM_SZ, p->col_chk) != 0;
+	return dirty;
+}
+
+// the data rows without their check symbols, same layout as rs16_product_encode() takes
+void rs16_product_get_data(const rs16_product* p, const gf16_poly* grid, gf16_poly* data)
+{
+	for (int8_t i = 0; i < p->col_n - p->col_chk; ++i)
+		data[i] = grid[p->col_chk + i] >> (p->row_chk * GF16_SYM_SZ);
+}
@@ -0,0 +1,344 @@
+// BCH view, systematic encoding Reed Solomon using 8 bit symbols
+#include "rs_gf256.h"
+
+#if defined(__SSSE3__)
+#include <immintrin.h>
+#endif
+
+// returns 0 on success or -1 if the code doesn't fit the precomputed table sizes
+int8_t rs256_codec_init(rs256_codec* c, int16_t n, int8_t chk_syms)
+{
+	if (n > RS256_MAX_N || chk_syms < 1 || chk_syms > RS256_MAX_CHK || chk_syms >= n)
+		return -1;
+
+	gf256_init();
+	c->n = n;
+	c->k = n - chk_syms;
+	c->chk_syms = chk_syms;
+	c->chk_vecs = (chk_syms + 15) / 16;
+
+	// generator, multiplying by each monic binomial (x - alpha^i) in turn
+	for (int8_t i = 0; i <= RS256_MAX_CHK; ++i)
+		c->g_poly[i] = 0;
+	c->g_poly[0] = 1;
+	for (int8_t i = 1; i <= chk_syms; ++i)
+	{
+		for (int8_t j = i; j > 0; --j)
+			c->g_poly[j] = c->g_poly[j - 1] ^ gf256_mul(c->g_poly[j], gf256_exp[i]);
+		c->g_poly[0] = gf256_mul(c->g_poly[0], gf256_exp[i]);
+	}
+
+	// x^(chk_syms + j) mod g, starting from x^chk_syms mod g which is just g without its leading 1
+	gf256_elem rem[RS256_MAX_CHK];
+	for (int8_t i = 0; i < chk_syms; ++i)
+		rem[i] = c->g_poly[i];
+	for (int16_t j = 0; j < RS256_MAX_N; ++j)
+	{
+		for (int8_t i = 0; i < RS256_MAX_CHK; ++i)
+		{
+			gf256_elem v = (i < chk_syms) ? rem[i] : 0;
+			c->enc_lo[j][i] = v & 0xF;
+			c->enc_hi[j][i] = v >> 4;
+		}
+		gf256_elem top = rem[chk_syms - 1];	// multiply by x and reduce the overflowing term back down
+		for (int8_t i = chk_syms - 1; i > 0; --i)
+			rem[i] = rem[i - 1] ^ gf256_mul(top, c->g_poly[i]);
+		rem[0] = gf256_mul(top, c->g_poly[0]);
+	}
+
+	for (int16_t i = 0; i < RS256_MAX_N; ++i)
+	{
+		for (int8_t s = 0; s < RS256_MAX_CHK; ++s)
+		{
+			gf256_elem v = (s < chk_syms) ? gf256_exp[((1 + s) * i) % GF256_MAX] : 0;
+			c->synd_lo[i][s] = v & 0xF;
+			c->synd_hi[i][s] = v >> 4;
+		}
+	}
+
+	for (int8_t t = 0; t <= RS256_MAX_ERRS; ++t)
+	{
+		for (int16_t p = 0; p <= RS256_MAX_N; ++p)
+		{
+			gf256_elem v = gf256_exp[(GF256_MAX - (p * t) % GF256_MAX) % GF256_MAX];
+			c->chien_lo[t][p] = v & 0xF;
+			c->chien_hi[t][p] = v >> 4;
+		}
+	}
+
+	return 0;
+}
+
+// acc ^= sum of coef[j] * v[j] over cnt vectors of chk_vecs * 16 terms, v given in nibble split form
+//  this is both the encoder (data times remainder rows) and the syndrome calculation (received times powers)
+void rs256_split_mul_acc(const rs256_codec* c, gf256_elem* acc, const gf256_elem* coef, int16_t cnt,
+	const gf256_elem (*v_lo)[RS256_MAX_CHK], const gf256_elem (*v_hi)[RS256_MAX_CHK])
+{
+#if defined(__SSSE3__)
+	__m128i a0 = _mm_setzero_si128();
+	__m128i a1 = _mm_setzero_si128();
+	if (c->chk_vecs == 1)
+	{
+		for (int16_t j = 0; j < cnt; ++j)
+		{
+			__m128i tlo = _mm_loadu_si128((const __m128i*)gf256_mul_lo[coef[j]]);
+			__m128i thi = _mm_loadu_si128((const __m128i*)gf256_mul_hi[coef[j]]);
+			a0 = _mm_xor_si128(a0, _mm_shuffle_epi8(tlo, _mm_loadu_si128((const __m128i*)v_lo[j])));
+			a0 = _mm_xor_si128(a0, _mm_shuffle_epi8(thi, _mm_loadu_si128((const __m128i*)v_hi[j])));
+		}
+	}
+	else
+	{
+		for (int16_t j = 0; j < cnt; ++j)
+		{
+			__m128i tlo = _mm_loadu_si128((const __m128i*)gf256_mul_lo[coef[j]]);
+			__m128i thi = _mm_loadu_si128((const __m128i*)gf256_mul_hi[coef[j]]);
+			a0 = _mm_xor_si128(a0, _mm_shuffle_epi8(tlo, _mm_loadu_si128((const __m128i*)v_lo[j])));
+			a0 = _mm_xor_si128(a0, _mm_shuffle_epi8(thi, _mm_loadu_si128((const __m128i*)v_hi[j])));
+			a1 = _mm_xor_si128(a1, _mm_shuffle_epi8(tlo, _mm_loadu_si128((const __m128i*)(v_lo[j] + 16))));
+			a1 = _mm_xor_si128(a1, _mm_shuffle_epi8(thi, _mm_loadu_si128((const __m128i*)(v_hi[j] + 16))));
+		}
+	}
+	_mm_storeu_si128((__m128i*)acc, _mm_xor_si128(_mm_loadu_si128((const __m128i*)acc), a0));
+	if (c->chk_vecs == 2)
+		_mm_storeu_si128((__m128i*)(acc + 16), _mm_xor_si128(_mm_loadu_si128((const __m128i*)(acc + 16)), a1));
+#else
+	// same split nibble lookups one term at a time
+	int8_t len = c->chk_vecs * 16;
+	for (int16_t j = 0; j < cnt; ++j)
+	{
+		const gf256_elem* tlo = gf256_mul_lo[coef[j]];
+		const gf256_elem* thi = gf256_mul_hi[coef[j]];
+		for (int8_t i = 0; i < len; ++i)
+			acc[i] ^= tlo[v_lo[j][i]] ^ thi[v_hi[j][i]];
+	}
+#endif
+}
+
+// raw holds k data terms lowest order first, cw gets the full n term code word
+void rs256_encode_systematic(const rs256_codec* c, const gf256_elem* raw, gf256_elem* cw)
+{
+	gf256_elem chk[RS256_MAX_CHK] = {0};
+	rs256_split_mul_acc(c, chk, raw, c->k, c->enc_lo, c->enc_hi);
+
+	for (int8_t i = 0; i < c->chk_syms; ++i)
+		cw[i] = chk[i];
+	for (int16_t j = 0; j < c->k; ++j)
+		cw[c->chk_syms + j] = raw[j];
+}
+
+// synd gets chk_syms terms, syndrome s is recv(alpha^(1 + s))
+void rs256_get_syndromes(const rs256_codec* c, const gf256_elem* recv, gf256_elem* synd)
+{
+	gf256_elem acc[RS256_MAX_CHK] = {0};
+	rs256_split_mul_acc(c, acc, recv, c->n, c->synd_lo, c->synd_hi);
+
+	for (int8_t i = 0; i < c->chk_syms; ++i)
+		synd[i] = acc[i];
+}
+
+// evaluates the locator at X(p)^-1 for the 16 positions starting at base, set bits are the roots
+uint16_t rs256_chien_block(const rs256_codec* c, const gf256_elem* loc, int8_t loc_len, int16_t base)
+{
+#if defined(__SSSE3__)
+	__m128i acc = _mm_setzero_si128();
+	for (int8_t t = 0; t < loc_len; ++t)
+	{
+		__m128i tlo = _mm_loadu_si128((const __m128i*)gf256_mul_lo[loc[t]]);
+		__m128i thi = _mm_loadu_si128((const __m128i*)gf256_mul_hi[loc[t]]);
+		acc = _mm_xor_si128(acc, _mm_shuffle_epi8(tlo, _mm_loadu_si128((const __m128i*)(c->chien_lo[t] + base))));
+		acc = _mm_xor_si128(acc, _mm_shuffle_epi8(thi, _mm_loadu_si128((const __m128i*)(c->chien_hi[t] + base))));
+	}
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(acc, _mm_setzero_si128()));
+#else
+	uint16_t roots = 0;
+	for (int8_t i = 0; i < 16; ++i)
+	{
+		gf256_elem y = 0;
+		for (int8_t t = 0; t < loc_len; ++t)
+			y ^= gf256_mul_lo[loc[t]][c->chien_lo[t][base + i]] ^ gf256_mul_hi[loc[t]][c->chien_hi[t][base + i]];
+		roots |= (uint16_t)(y == 0) << i;
+	}
+	return roots;
+#endif
+}
+
+// r = p * q mod x^r_len, all lengths in terms
+void rs256_poly_mul(gf256_elem* r, int16_t r_len, const gf256_elem* p, int16_t p_len, const gf256_elem* q, int16_t q_len)
+{
+	for (int16_t i = 0; i < r_len; ++i)
+		r[i] = 0;
+	for (int16_t i = 0; i < p_len; ++i)
+	{
+		if (!p[i])
+			continue;
+		for (int16_t j = 0; j < q_len && i + j < r_len; ++j)
+			r[i + j] ^= gf256_mul(p[i], q[j]);
+	}
+}
+
+// Berlekamp-Massey, see rs16_get_error_locator() for the naming, returns the locator length in terms or 0 if it fails
+int8_t rs256_get_error_locator(const gf256_elem* synd, int8_t s_len, gf256_elem* error_loc)
+{
+	gf256_elem error_loc_last[RS256_MAX_CHK + 1] = {1};
+	gf256_elem error_loc_temp[RS256_MAX_CHK + 1];
+	gf256_elem disc, disc_last = 1;
+	int8_t delay = 1, error_len = 0;
+
+	for (int8_t i = 0; i <= RS256_MAX_CHK; ++i)
+		error_loc[i] = 0;
+	error_loc[0] = 1;
+
+	for (int8_t n = 0; n < s_len; ++n)
+	{
+		disc = synd[n];
+		for (int8_t i = 1; i <= error_len; ++i)
+			disc ^= gf256_mul(error_loc[i], synd[n - i]);
+
+		if (disc)
+		{
+			gf256_elem scale = gf256_div(disc, disc_last);
+			for (int8_t i = 0; i <= RS256_MAX_CHK; ++i)
+				error_loc_temp[i] = error_loc[i];
+			for (int8_t i = 0; i + delay <= RS256_MAX_CHK; ++i)
+				error_loc[i + delay] ^= gf256_mul(scale, error_loc_last[i]);
+
+			if (2 * error_len <= n)
+			{
+				for (int8_t i = 0; i <= RS256_MAX_CHK; ++i)
+					error_loc_last[i] = error_loc_temp[i];
+				error_len = n + 1 - error_len;
+				disc_last = disc;
+				delay = 0;
+			}
+		}
+		++delay;
+	}
+
+	int8_t len = RS256_MAX_CHK + 1;
+	while (len > 1 && !error_loc[len - 1])
+		--len;
+	// same check as rs16_get_error_locator(), fewer terms than L means no error pattern fits the syndromes, 0 isn't
+	//  a valid length so it's returned for rs256_get_errata() to report
+	return len == error_len + 1 ? len : 0;
+}
+
+// errata gets n terms, returns the number of errata or one of the RS256_FAIL_* values
+int16_t rs256_get_errata(const rs256_codec* c, const gf256_elem* recv, const uint64_t* e_pos, gf256_elem* errata)
+{
+	int8_t chk_syms = c->chk_syms;
+	uint64_t cand[RS256_POS_WORDS];	// positions that can still hold errors, ie received and not erased
+	int16_t erase_cnt = 0;
+	for (int8_t w = 0; w < RS256_POS_WORDS; ++w)
+	{
+		int16_t valid = c->n - 64 * w;
+		uint64_t tx = (valid >= 64) ? UINT64_MAX : (valid > 0 ? ((uint64_t)1 << valid) - 1 : 0);
+		uint64_t e = e_pos ? e_pos[w] & tx : 0;
+		erase_cnt += __builtin_popcountll(e);
+		cand[w] = tx & ~e;
+	}
+	if (erase_cnt > chk_syms)
+		return RS256_FAIL_ERASURES;
+
+	for (int16_t i = 0; i < c->n; ++i)
+		errata[i] = 0;
+
+	gf256_elem synd[RS256_MAX_CHK];
+	rs256_get_syndromes(c, recv, synd);
+	gf256_elem any = 0;
+	for (int8_t i = 0; i < chk_syms; ++i)
+		any |= synd[i];
+	if (!any)	// no errors
+		return 0;
+
+	// erasure locator, product of (1 + X(p) x) over the erased positions
+	gf256_elem e_loc[RS256_MAX_CHK + 1] = {1};
+	int8_t e_loc_len = 1;
+	for (int16_t p = 0; e_pos && p < c->n; ++p)
+	{
+		if (!((e_pos[p / 64] >> (p % 64)) & 1))
+			continue;
+		gf256_elem x = gf256_exp[p];
+		for (int8_t i = e_loc_len; i > 0; --i)
+			e_loc[i] ^= gf256_mul(e_loc[i - 1], x);
+		++e_loc_len;
+	}
+
+	gf256_elem e_eval[RS256_MAX_CHK];
+	rs256_poly_mul(e_eval, chk_syms, synd, chk_syms, e_loc, e_loc_len);	// Forney syndromes
+
+	if (erase_cnt != chk_syms)
+	{
+		// the first erase_cnt Forney syndromes are consumed by the erasures, only the rest say anything about the errors
+		gf256_elem error_loc[RS256_MAX_CHK + 1];
+		int8_t error_loc_len = rs256_get_error_locator(e_eval + erase_cnt, chk_syms - erase_cnt, error_loc);
+		int8_t error_loc_order = error_loc_len - 1;
+		if (!error_loc_len || 2 * error_loc_order > chk_syms - erase_cnt)
+			return RS256_FAIL_ORDER;
+
+		int16_t root_cnt = 0;
+		for (int16_t base = 0; base < c->n; base += 16)
+		{
+			uint16_t roots = rs256_chien_block(c, error_loc, error_loc_len, base);
+			roots &= cand[base / 64] >> (base % 64);
+			root_cnt += __builtin_popcount(roots);
+			cand[base / 64] &= ~((uint64_t)(uint16_t)~roots << (base % 64));	// cand now only holds the error positions
+		}
+		if (root_cnt != error_loc_order)
+			return RS256_FAIL_ROOTS;
+
+		// combine the error and erasure locator and evaluator to the errata versions of themselves
+		gf256_elem errata_loc[RS256_MAX_CHK + 1];
+		rs256_poly_mul(errata_loc, RS256_MAX_CHK + 1, e_loc, e_loc_len, error_loc, error_loc_len);
+		for (int8_t i = 0; i <= RS256_MAX_CHK; ++i)
+			e_loc[i] = errata_loc[i];
+		e_loc_len += error_loc_order;
+		rs256_poly_mul(errata_loc, chk_syms, e_eval, chk_syms, error_loc, error_loc_len);
+		for (int8_t i = 0; i < chk_syms; ++i)
+			e_eval[i] = errata_loc[i];
+	}
+	else
+	{
+		for (int8_t w = 0; w < RS256_POS_WORDS; ++w)
+			cand[w] = 0;
+	}
+
+	// Forney algorithm over the erasures and the found errors
+	gf256_elem e_loc_prime[RS256_MAX_CHK];
+	for (int8_t i = 0; i + 1 < e_loc_len; ++i)
+		e_loc_prime[i] = (i & 1) ? 0 : e_loc[i + 1];
+
+	int16_t errata_cnt = 0;
+	for (int8_t w = 0; w < RS256_POS_WORDS; ++w)
+	{
+		uint64_t pos = cand[w] | (e_pos ? e_pos[w] : 0);
+		while (pos)
+		{
+			int16_t p = 64 * w + __builtin_ctzll(pos);
+			pos &= pos - 1;
+			if (p >= c->n)
+				break;
+			gf256_elem root = gf256_exp[(GF256_MAX - p) % GF256_MAX];
+			gf256_elem ee_res = gf256_poly_eval(e_eval, chk_syms, root);
+			gf256_elem lp_res = gf256_poly_eval(e_loc_prime, e_loc_len - 1, root);
+			errata[p] = gf256_div(ee_res, lp_res);
+			++errata_cnt;
+		}
+	}
+
+	return errata_cnt;
+}
+
+// raw gets the k corrected data terms, returns the number of errata or one of the RS256_FAIL_* values
+int16_t rs256_decode_systematic(const rs256_codec* c, const gf256_elem* recv, const uint64_t* e_pos, gf256_elem* raw)
+{
+	gf256_elem errata[RS256_MAX_N];
+	int16_t res = rs256_get_errata(c, recv, e_pos, errata);
+	if (res < 0)
+		return res;
+
+	for (int16_t j = 0; j < c->k; ++j)
+		raw[j] = recv[c->chk_syms + j] ^ errata[c->chk_syms + j];
+
+	return res;
+}
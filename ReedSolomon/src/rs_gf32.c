@@ -0,0 +1,215 @@
+// BCH view, systematic encoding Reed Solomon using 5 bit symbols
+#include "rs_gf32.h"
+
+#define RS32_MAX_TERMS 31	// terms in a full block
+#define RS32_FAIL_ORDER 0xE000000000000000	// flags set in the last word on failure, outside of the valid terms
+#define RS32_FAIL_ROOTS 0xF000000000000000
+
+const gf32_poly rs32_G_polys[] = {
+	{{0x1, 0x0, 0x0}},	// 0 symbols (dummy for indexing)
+	{{0x22, 0x0, 0x0}},	// 1 symbol	First Consectutive Root, aka fcr aka c = 1
+	{{0x4C8, 0x0, 0x0}},	// 2 symbols
+	{{0xBBAA, 0x0, 0x0}},	// 3 symbols
+	{{0x1F1931, 0x0, 0x0}},	// 4 symbols
+	{{0x3B7DF3F, 0x0, 0x0}},	// 5 symbols
+	{{0x63AF6FD8, 0x0, 0x0}},	// 6 symbols
+	{{0x9525D4736, 0x0, 0x0}},	// 7 symbols
+	{{0x1455E616A45, 0x0, 0x0}},	// 8 symbols
+	{{0x32DB8945C51D, 0x0, 0x0}},	// 9 symbols
+	{{0x461CC758D903E, 0x0, 0x0}},	// 10 symbols
+	{{0x911EA0A997F730, 0x0, 0x0}},	// 11 symbols
+	{{0x55431223E56BB5B, 0x1, 0x0}},	// 12 symbols
+	{{0x9C5ABB926EB0DC9, 0x36, 0x0}},	// 13 symbols
+	{{0x84FC6F21E1233CE, 0x574, 0x0}},	// 14 symbols
+	{{0xAF1762B2BBFB86B, 0xD265, 0x0}},	// 15 symbols
+	{{0x40B19A41FD7D46E, 0x17F02D, 0x0}},	// 16 symbols
+	{{0x76DB375CEE7BBC9, 0x3C34FD1, 0x0}},	// 17 symbols
+	{{0x4949E2ECFDFB1DB, 0x7E7CBAD8, 0x0}},	// 18 symbols
+	{{0xB68CB2DDFB20F50, 0xE5EB95C73, 0x0}},	// 19 symbols
+	{{0x4BCDE742A1B3B3E, 0x1AC8A98F0FC, 0x0}},	// 20 symbols
+	{{0x4E893A31EE6F43D, 0x2DE27D7EBFC1, 0x0}},	// 21 symbols
+	{{0xB15B92A26579105, 0x70ECC90E50FDC, 0x0}},	// 22 symbols
+	{{0x4EF16F13F9DC656, 0xDE490F73A53CF3, 0x0}},	// 23 symbols
+	{{0x70966BA2985EB38, 0x4D0D41B72EEF078, 0x1}},	// 24 symbols
+	{{0x473CB20B54147DF, 0xD91011F5178DED1, 0x30}},	// 25 symbols
+	{{0xACDB1A4486D6F31, 0x1F9140CBC993BCD, 0x4E9}},	// 26 symbols
+	{{0x8443ECB9E5F5D2A, 0x190C9CA4ABCCC25, 0xB3BA}},	// 27 symbols
+	{{0x9D501DD53A79BA8, 0xDD24EE49E737274, 0x1D3BA9}},	// 28 symbols
+	{{0x510724163BF38C2, 0x4DF0DAE7FC7D176, 0x33D30F0}},	// 29 symbols
+	{{0x84210842108421, 0x84210842108421, 0x42108421}}	// 30 symbols
+};
+
+// encodes a block of up to 150 bits worth of raw data as a Reed Solomon code word
+//  infers message length from provided data, doesn't verify that data length fits
+//  with the specified number of check symbols and will truncate to the max size,
+//  discarding the most significant bits if oversized.
+gf32_poly rs32_encode_systematic(gf32_poly raw, int8_t chk_syms)
+{
+	raw = gf32_poly_truncate(raw, RS32_MAX_TERMS - chk_syms);	//truncate most significant terms if provided data is oversized
+	gf32_idx msg_len = gf32_poly_get_size(raw);
+	if (msg_len == 0)
+		return raw;
+
+	gf32_poly chk = gf32_poly_mod(raw, msg_len, rs32_G_polys[chk_syms], chk_syms + 1);
+	return gf32_poly_add(gf32_poly_shift_up(raw, chk_syms), chk);
+}
+
+gf32_poly rs32_get_syndromes(gf32_poly p, gf32_idx p_len, int8_t nsyms)
+{
+	gf32_poly synd = {{0}};
+	for (int8_t i = 0; i < nsyms; ++i)	// which syndromes are used is effected by fcr so if you change that it must be changed here too
+		synd.w[i / GF32_WORD_TERMS] |= (uint64_t)gf32_poly_eval(p, p_len, gf32_exp[i + 1]) << (GF32_SYM_SZ * (i % GF32_WORD_TERMS));
+
+	return synd;
+}
+
+// erase_pos is encoded such that a set bit indicates the corresponding degree term is erased or in error
+gf32_poly rs32_get_erasure_locator(uint32_t erase_pos)
+{
+	gf32_poly erase_loc = {{1}};
+	while (erase_pos)
+	{
+		// faster equivalent of gf32_poly_mul() for a monic binomial in the form (ax - 1)
+		erase_loc = gf32_poly_add(erase_loc, gf32_poly_shift_up(gf32_poly_scale(erase_loc, gf32_exp[__builtin_ctz(erase_pos)]), 1));
+		erase_pos &= erase_pos - 1;
+	}
+
+	return erase_loc;
+}
+
+// this can also be used to get the Forney Syndromes
+gf32_poly rs32_get_errata_evaluator(gf32_poly synd, int8_t chk_syms, gf32_poly errata_loc)
+{
+	return gf32_poly_truncate(gf32_poly_mul(synd, errata_loc), chk_syms);
+}
+
+// Forney algorithm, see rs16_get_errata_magnitude()
+gf32_poly rs32_get_errata_magnitude(gf32_poly errata_eval, int8_t chk_syms, gf32_poly errata_loc, uint32_t errata_pos)
+{
+	gf32_poly errata_loc_prime = gf32_poly_formal_derivative(errata_loc);
+	gf32_poly errata_mag = {{0}};
+	while (errata_pos)
+	{
+		int8_t i = __builtin_ctz(errata_pos);
+		gf32_elem root = gf32_exp[GF32_MAX - i];	// X(i)^-1
+		gf32_elem ee_res = gf32_poly_eval(errata_eval, chk_syms, root);
+		gf32_elem lp_res = gf32_poly_eval(errata_loc_prime, chk_syms, root);	// chk_syms is guaranteed to be at least as big as errata_loc_prime's actual size
+		errata_mag.w[i / GF32_WORD_TERMS] |= (uint64_t)(gf32_div(ee_res, lp_res) & GF32_MAX) << (GF32_SYM_SZ * (i % GF32_WORD_TERMS));
+		errata_pos &= errata_pos - 1;
+	}
+
+	return errata_mag;
+}
+
+// Berlekamp-Massey, see rs16_get_error_locator() for the naming, s_len is in terms
+gf32_poly rs32_get_error_locator(gf32_poly synd, gf32_idx s_len)
+{
+	gf32_poly error_loc = {{1}};		// aka C(x)
+	gf32_poly error_loc_last = {{1}};	// aka B(x)
+	gf32_poly error_loc_temp;			// aka T(x)
+	gf32_elem disc, disc_last = 1;		// aka d and b
+	gf32_idx delay = 1, error_len = 0;	// aka m and L
+
+	for (gf32_idx n = 0; n < s_len; ++n)
+	{
+		disc = gf32_poly_get_term(synd, n);
+		for (gf32_idx i = 1; i <= error_len; ++i)
+			disc ^= gf32_mul(gf32_poly_get_term(error_loc, i), gf32_poly_get_term(synd, n - i));
+
+		if (disc)
+		{
+			error_loc_temp = error_loc;
+			error_loc = gf32_poly_add(error_loc, gf32_poly_shift_up(gf32_poly_scale(error_loc_last, gf32_div(disc, disc_last)), delay));
+
+			if (2 * error_len <= n)
+			{
+				error_loc_last = error_loc_temp;
+				error_len = n + 1 - error_len;
+				disc_last = disc;
+				delay = 0;
+			}
+		}
+		++delay;
+	}
+
+	// same check as rs16_get_error_locator(), a locator with fewer terms than L is returned as 0 for
+	//  rs32_get_errata() to report
+	if (gf32_poly_get_size(error_loc) != error_len + 1)
+		return (gf32_poly){{0}};
+
+	return error_loc;
+}
+
+// mask_pos has set bits for the valid (ie received) message terms and lets us skip the erasures and
+//  otherwise non-transmitted terms such as fixed padding or less than maximal message length
+uint32_t rs32_get_error_pos(gf32_poly error_loc, uint32_t mask_pos)
+{
+	uint32_t error_pos = 0;
+	gf32_idx loc_len = gf32_poly_get_size(error_loc);
+	while (mask_pos)
+	{
+		int8_t i = __builtin_ctz(mask_pos);
+		if (!gf32_poly_eval(error_loc, loc_len, gf32_exp[GF32_MAX - i]))
+			error_pos |= (uint32_t)1 << i;
+		mask_pos &= mask_pos - 1;
+	}
+
+	return error_pos;
+}
+
+// tx_pos inludes set bits for only the valid positions for errors to occur, ie not in untransmitted padding symbols
+gf32_poly rs32_get_errata(gf32_poly recv, gf32_idx r_len, int8_t chk_syms, uint32_t e_pos, uint32_t tx_pos)
+{
+	int8_t erase_cnt = __builtin_popcount(e_pos);
+	if (erase_cnt > chk_syms)	// beyond the Singleton Bound
+	{
+		gf32_poly fail;
+		for (int8_t i = 0; i < GF32_WORDS; ++i)
+			fail.w[i] = UINT64_MAX;
+		return fail;
+	}
+
+	gf32_poly e_eval = rs32_get_syndromes(recv, r_len, chk_syms);
+
+	if (gf32_poly_is_zero(e_eval))	// no errors
+		return e_eval;
+
+	gf32_poly e_loc = {{1}};
+
+	if (e_pos)	// this check isn't required but shortcuts excess calculations when no erasures specified
+	{
+		e_loc = rs32_get_erasure_locator(e_pos);
+		e_eval = rs32_get_errata_evaluator(e_eval, chk_syms, e_loc);	// compute Forney syndromes
+	}
+
+	if (erase_cnt != chk_syms)	// skip checking for errors if the maximum number of erasures occurred
+	{
+		// the first erase_cnt Forney syndromes are consumed by the erasures, only the rest say anything about the errors
+		gf32_poly error_loc = rs32_get_error_locator(gf32_poly_shift_down(e_eval, erase_cnt), chk_syms - erase_cnt);
+		int8_t error_loc_order = gf32_poly_get_order(error_loc);
+		if (gf32_poly_is_zero(error_loc) || 2 * error_loc_order > chk_syms - erase_cnt)	// check that the number of errors isn't beyond the Singleton Bound
+		{
+			error_loc.w[GF32_WORDS - 1] |= RS32_FAIL_ORDER;
+			return error_loc;
+		}
+		uint32_t error_pos = rs32_get_error_pos(error_loc, tx_pos & (~e_pos));
+		if (__builtin_popcount(error_pos) != error_loc_order)	// not enough or too many roots
+		{
+			gf32_poly fail = {{error_pos}};
+			fail.w[GF32_WORDS - 1] = RS32_FAIL_ROOTS;
+			return fail;
+		}
+
+		// combine the error and erasure position, locator, and evaluator to the errata versions of themselves
+		e_pos |= error_pos;
+		e_loc = gf32_poly_mul(e_loc, error_loc);
+		e_eval = rs32_get_errata_evaluator(e_eval, chk_syms, error_loc);
+	}
+
+	return rs32_get_errata_magnitude(e_eval, chk_syms, e_loc, e_pos);
+}
+
+gf32_poly rs32_decode_systematic(gf32_poly recv, gf32_idx r_len, int8_t chk_syms, uint32_t e_pos, uint32_t tx_pos)
+{
+	return gf32_poly_shift_down(gf32_poly_add(recv, rs32_get_errata(recv, r_len, chk_syms, e_pos, tx_pos)), chk_syms);
+}
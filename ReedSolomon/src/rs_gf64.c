@@ -0,0 +1,247 @@
+// BCH view, systematic encoding Reed Solomon using 6 bit symbols
+#include "rs_gf64.h"
+
+#define RS64_MAX_TERMS 63	// terms in a full block
+#define RS64_FAIL_ORDER 0xE000000000000000	// flags set in the last word on failure, outside of the valid terms
+#define RS64_FAIL_ROOTS 0xF000000000000000
+
+const gf64_poly rs64_G_polys[] = {
+	{{0x1, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0}},	// 0 symbols (dummy for indexing)
+	{{0x42, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0}},	// 1 symbol	First Consectutive Root, aka fcr aka c = 1
+	{{0x1188, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0}},	// 2 symbols
+	{{0x4EE03, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0}},	// 3 symbols
+	{{0x179D470, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0}},	// 4 symbols
+	{{0x7E323228, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0}},	// 5 symbols
+	{{0x1F4DDEEC3B, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0}},	// 6 symbols
+	{{0x7B15969175C, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0}},	// 7 symbols
+	{{0x1DFD970BD4196, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0}},	// 8 symbols
+	{{0x2FA057F13AF159, 0x1, 0x0, 0x0, 0x0, 0x0, 0x0}},	// 9 symbols
+	{{0x1C9EAE420F1B2E, 0x5F, 0x0, 0x0, 0x0, 0x0, 0x0}},	// 10 symbols
+	{{0x1157B3865F48C8, 0x1F0C, 0x0, 0x0, 0x0, 0x0, 0x0}},	// 11 symbols
+	{{0x3E5CC09F02868, 0x7916D, 0x0, 0x0, 0x0, 0x0, 0x0}},	// 12 symbols
+	{{0x27B2D825435B5C, 0x1CF53FD, 0x0, 0x0, 0x0, 0x0, 0x0}},	// 13 symbols
+	{{0x1D19FEC9EBB8FA, 0x67619D17, 0x0, 0x0, 0x0, 0x0, 0x0}},	// 14 symbols
+	{{0x19AB77DD175F7E, 0x13F920D4DE, 0x0, 0x0, 0x0, 0x0, 0x0}},	// 15 symbols
+	{{0x1BD2217BA66EF0, 0x5C7424D15D2, 0x0, 0x0, 0x0, 0x0, 0x0}},	// 16 symbols
+	{{0x1ACBF0F225FACE, 0x1E84F5C0CA7AF, 0x0, 0x0, 0x0, 0x0, 0x0}},	// 17 symbols
+	{{0x22F498CBAC8359, 0x35F412316FB0E5, 0x1, 0x0, 0x0, 0x0, 0x0}},	// 18 symbols
+	{{0x10848E3C3B8242, 0x20A5613D16C1D6, 0x6B, 0x0, 0x0, 0x0, 0x0}},	// 19 symbols
+	{{0x305919A17D35FB, 0xB85B21697990F, 0x15EC, 0x0, 0x0, 0x0, 0x0}},	// 20 symbols
+	{{0x33BFFEA31FBFBA, 0x3E9F51DBB2B846, 0x6CA74, 0x0, 0x0, 0x0, 0x0}},	// 21 symbols
+	{{0x3A79C855D89A42, 0x34DAA595591F4B, 0x1654B66, 0x0, 0x0, 0x0, 0x0}},	// 22 symbols
+	{{0x1A98A833A07C11, 0x62DCA13B1A545, 0x70D01D9B, 0x0, 0x0, 0x0, 0x0}},	// 23 symbols
+	{{0x165CC2FFC44D4D, 0x2E87D943AE53CC, 0x18508A76A7, 0x0, 0x0, 0x0, 0x0}},	// 24 symbols
+	{{0x267D918DB7BAB0, 0x7B1E70EBD0EC4, 0x4305A4C2136, 0x0, 0x0, 0x0, 0x0}},	// 25 symbols
+	{{0x281CA7CEF4D8D6, 0x397C56456088FA, 0x1108756E0AA83, 0x0, 0x0, 0x0, 0x0}},	// 26 symbols
+	{{0x3D830CAA926341, 0xEE6F76E79086B, 0xAC2EDB954596B, 0x1, 0x0, 0x0, 0x0}},	// 27 symbols
+	{{0x318A926B1D42DC, 0x1737DB62DE896E, 0x2DD4AA778CA59D, 0x56, 0x0, 0x0, 0x0}},	// 28 symbols
+	{{0x2CF9C6A1EBC7BE, 0x31A4F4A0C085CA, 0x58538BB96C651, 0x1BA9, 0x0, 0x0, 0x0}},	// 29 symbols
+	{{0x2E365C8292A911, 0x3595F87B9C5C5B, 0x1BAD054E749526, 0x5D72F, 0x0, 0x0, 0x0}},	// 30 symbols
+	{{0x24D935ADB9F56E, 0xFFB0232B468ED, 0x2839ECA2455FF8, 0x1E04497, 0x0, 0x0, 0x0}},	// 31 symbols
+	{{0x3E7DB3643B7551, 0xADF2E453156AE, 0x298D92AF284DBE, 0x71D764C1, 0x0, 0x0, 0x0}},	// 32 symbols
+	{{0x11701ADE39F93E, 0x5E2AD9522FC1C, 0x3CD2277ADBD984, 0x18D060B6FB, 0x0, 0x0, 0x0}},	// 33 symbols
+	{{0x2380FAE4BAA79C, 0xAAE79610D3C70, 0x23660FFC355BD3, 0x47243F188D2, 0x0, 0x0, 0x0}},	// 34 symbols
+	{{0x1280136D93C2C1, 0x263BBA6739A8BA, 0x2B1903E3A7E5A1, 0x13384E1D8E803, 0x0, 0x0, 0x0}},	// 35 symbols
+	{{0x2371B582E94356, 0x24E976B26D72FA, 0x179E0D0E0E5E6D, 0x1A557D3D2E1791, 0x1, 0x0, 0x0}},	// 36 symbols
+	{{0x117D3CA11E68F0, 0x361066E74978B0, 0x3B6CE7C149926B, 0x3C428B19E483A6, 0x76, 0x0, 0x0}},	// 37 symbols
+	{{0x3EDA56AB90DA8D, 0x10A42B676DAC5C, 0x2611B909575B71, 0x2F4867050D3895, 0x1B68, 0x0, 0x0}},	// 38 symbols
+	{{0x2435C26AF7BD51, 0x1E8C26F2393C2E, 0x1B1B0E59A5C37C, 0x17AE56828C5FA, 0x5B538, 0x0, 0x0}},	// 39 symbols
+	{{0x2EFA9C8EB44C02, 0x1EA466A70EF6AD, 0x2E5CDD5C76D7A7, 0x314DC42499A7C5, 0x1D3CBC2, 0x0, 0x0}},	// 40 symbols
+	{{0x2C8B07CDC47A7A, 0x10117A612158DB, 0x513275ECEB7BC, 0x25893F63951844, 0x6981E34B, 0x0, 0x0}},	// 41 symbols
+	{{0x3180A1BFA09FBB, 0x36EBB955306C4A, 0x137FF882CED371, 0x120C2E0F869668, 0x14E4E7C171, 0x0, 0x0}},	// 42 symbols
+	{{0x3D1D92F3DBB5C2, 0x243A7D85B455EE, 0x22A7989E75CB6B, 0x96155D04D12AC, 0x6466D4C47CF, 0x0, 0x0}},	// 43 symbols
+	{{0x287CC8151D3259, 0x26AEAE729C896B, 0x2AA7F75CA7526D, 0x12FC56DEA2A4AD, 0x1271AB1F6D8E8, 0x0, 0x0}},	// 44 symbols
+	{{0x265CA8637F834E, 0xAE3223BC2887A, 0x227F2D59559E61, 0x17AA58AA4D916D, 0x1095DE8AC24DEB, 0x1, 0x0}},	// 45 symbols
+	{{0x1699CEA1388AF0, 0x5DF0860DD08C4, 0x1310DE494A5593, 0x6CF6985E194AC, 0x1126BA0DED1B33, 0x62, 0x0}},	// 46 symbols
+	{{0x1A7BF9BCADFEFE, 0xAF9F4A2788ECC, 0x55F09010FEBC4, 0x2488F1C54EA2A8, 0x5E23B32C60212, 0x1149, 0x0}},	// 47 symbols
+	{{0x3ABD1E0B266F7A, 0xF94FB6E6103C5, 0x2E19B7CEA559BE, 0x3CFCF9AAA11644, 0x1DD11D44A2E6B, 0x48C23, 0x0}},	// 48 symbols
+	{{0x335888F2A758DC, 0x35A7D745BE554B, 0x1B10ED2337DDB8, 0x3C8B689E4E9845, 0x2DA77453F1A650, 0x14A57B8, 0x0}},	// 49 symbols
+	{{0x308490FB17BB68, 0x3136F64EADAF46, 0x266E03FCD84FE6, 0x24CE56D08517FA, 0xC1E2C3470F66B, 0x66651EFE, 0x0}},	// 50 symbols
+	{{0x10F7F15DEB5848, 0x17E45703B1184F, 0x3B9D0FFA295511, 0x6A855CF95A5D5, 0x3ADBA14771AE52, 0x13790FE995, 0x0}},	// 51 symbols
+	{{0x22CA27C94028EE, 0xE7DE9535AB916, 0x171A076F44965D, 0x17FD5E2398C8A6, 0x139A0174F22233, 0x585590545A7, 0x0}},	// 52 symbols
+	{{0x1AD37EE5F34B19, 0x39B3DA15B391E5, 0x2B6622A276C5AB, 0x12602F64293391, 0x259BAC134A0B2B, 0x1CB48CAF8683F, 0x0}},	// 53 symbols
+	{{0x1BA9F8095F1156, 0x785C59B96C0EF, 0x23D19C8E94A943, 0x90D34280C8783, 0x13DA2454C51DE8, 0x2563E3AE2D10BF, 0x1}},	// 54 symbols
+	{{0x191ADC060EF19C, 0x2E2EA1D617B792, 0x3C8DE57B8C5AB6, 0x1289C545E61812, 0x3A1F71F2EE48CF, 0x31F14C2C7D1827, 0x4B}},	// 55 symbols
+	{{0x1DB1C38239477B, 0x6DB523D6CA5DE, 0x293908B754A127, 0x254EE7192CE8FB, 0xCA51B0DC2D7F1, 0x2B7B692C2C6595, 0x152D}},	// 56 symbols
+	{{0x27E7BE71BD1C28, 0x349DB1310D14D7, 0x28AD3A79E0269B, 0x31786B3DD986C1, 0x2DDE3A0AF4414B, 0x7F36C2EF949BE, 0x6A870}},	// 57 symbols
+	{{0x356A7F06AE230, 0x3E85621C4CDD3D, 0x1B84AD964E7DA6, 0x14A8D21F0B4D7, 0x1E2BEB14FC342, 0x779438A07EEF8, 0x156C3A7}},	// 58 symbols
+	{{0x119C5959DE3443, 0xBA41F422193ED, 0x5D6E75A881B74, 0x2F4174C36364AF, 0x525DAADE5EBF8, 0x2BF3E8D90D17A3, 0x6885C3B0}},	// 59 symbols
+	{{0x1CA3D14D31DE08, 0x20F4477963514C, 0x2DC08050D14A6C, 0x3C578250D44729, 0x1197166483C528, 0x31634579665C09, 0x146486C86D}},	// 60 symbols
+	{{0x2FDFBF7E78E182, 0x35E9C3E7CF9F1F, 0xA10387066C5EB, 0x1A3078F1E1DB96, 0x102644E9D1BB76, 0x25C98366488162, 0x6046856A50B}},	// 61 symbols
+	{{0x1041041041041, 0x1041041041041, 0x1041041041041, 0x1041041041041, 0x1041041041041, 0x1041041041041, 0x1041041041041}}	// 62 symbols
+};
+
+// encodes a block of up to 372 bits worth of raw data as a Reed Solomon code word
+//  infers message length from provided data, doesn't verify that data length fits
+//  with the specified number of check symbols and will truncate to the max size,
+//  discarding the most significant bits if oversized.
+gf64_poly rs64_encode_systematic(gf64_poly raw, int8_t chk_syms)
+{
+	raw = gf64_poly_truncate(raw, RS64_MAX_TERMS - chk_syms);	//truncate most significant terms if provided data is oversized
+	gf64_idx msg_len = gf64_poly_get_size(raw);
+	if (msg_len == 0)
+		return raw;
+
+	gf64_poly chk = gf64_poly_mod(raw, msg_len, rs64_G_polys[chk_syms], chk_syms + 1);
+	return gf64_poly_add(gf64_poly_shift_up(raw, chk_syms), chk);
+}
+
+gf64_poly rs64_get_syndromes(gf64_poly p, gf64_idx p_len, int8_t nsyms)
+{
+	gf64_poly synd = {{0}};
+	for (int8_t i = 0; i < nsyms; ++i)	// which syndromes are used is effected by fcr so if you change that it must be changed here too
+		synd.w[i / GF64_WORD_TERMS] |= (uint64_t)gf64_poly_eval(p, p_len, gf64_exp[i + 1]) << (GF64_SYM_SZ * (i % GF64_WORD_TERMS));
+
+	return synd;
+}
+
+// erase_pos is encoded such that a set bit indicates the corresponding degree term is erased or in error
+gf64_poly rs64_get_erasure_locator(uint64_t erase_pos)
+{
+	gf64_poly erase_loc = {{1}};
+	while (erase_pos)
+	{
+		// faster equivalent of gf64_poly_mul() for a monic binomial in the form (ax - 1)
+		erase_loc = gf64_poly_add(erase_loc, gf64_poly_shift_up(gf64_poly_scale(erase_loc, gf64_exp[__builtin_ctzll(erase_pos)]), 1));
+		erase_pos &= erase_pos - 1;
+	}
+
+	return erase_loc;
+}
+
+// this can also be used to get the Forney Syndromes
+gf64_poly rs64_get_errata_evaluator(gf64_poly synd, int8_t chk_syms, gf64_poly errata_loc)
+{
+	return gf64_poly_truncate(gf64_poly_mul(synd, errata_loc), chk_syms);
+}
+
+// Forney algorithm, see rs16_get_errata_magnitude()
+gf64_poly rs64_get_errata_magnitude(gf64_poly errata_eval, int8_t chk_syms, gf64_poly errata_loc, uint64_t errata_pos)
+{
+	gf64_poly errata_loc_prime = gf64_poly_formal_derivative(errata_loc);
+	gf64_poly errata_mag = {{0}};
+	while (errata_pos)
+	{
+		int8_t i = __builtin_ctzll(errata_pos);
+		gf64_elem root = gf64_exp[GF64_MAX - i];	// X(i)^-1
+		gf64_elem ee_res = gf64_poly_eval(errata_eval, chk_syms, root);
+		gf64_elem lp_res = gf64_poly_eval(errata_loc_prime, chk_syms, root);	// chk_syms is guaranteed to be at least as big as errata_loc_prime's actual size
+		errata_mag.w[i / GF64_WORD_TERMS] |= (uint64_t)(gf64_div(ee_res, lp_res) & GF64_MAX) << (GF64_SYM_SZ * (i % GF64_WORD_TERMS));
+		errata_pos &= errata_pos - 1;
+	}
+
+	return errata_mag;
+}
+
+// Berlekamp-Massey, see rs16_get_error_locator() for the naming, s_len is in terms
+gf64_poly rs64_get_error_locator(gf64_poly synd, gf64_idx s_len)
+{
+	gf64_poly error_loc = {{1}};		// aka C(x)
+	gf64_poly error_loc_last = {{1}};	// aka B(x)
+	gf64_poly error_loc_temp;			// aka T(x)
+	gf64_elem disc, disc_last = 1;		// aka d and b
+	gf64_idx delay = 1, error_len = 0;	// aka m and L
+
+	for (gf64_idx n = 0; n < s_len; ++n)
+	{
+		disc = gf64_poly_get_term(synd, n);
+		for (gf64_idx i = 1; i <= error_len; ++i)
+			disc ^= gf64_mul(gf64_poly_get_term(error_loc, i), gf64_poly_get_term(synd, n - i));
+
+		if (disc)
+		{
+			error_loc_temp = error_loc;
+			error_loc = gf64_poly_add(error_loc, gf64_poly_shift_up(gf64_poly_scale(error_loc_last, gf64_div(disc, disc_last)), delay));
+
+			if (2 * error_len <= n)
+			{
+				error_loc_last = error_loc_temp;
+				error_len = n + 1 - error_len;
+				disc_last = disc;
+				delay = 0;
+			}
+		}
+		++delay;
+	}
+
+	// same check as rs16_get_error_locator(), a locator with fewer terms than L is returned as 0 for
+	//  rs64_get_errata() to report
+	if (gf64_poly_get_size(error_loc) != error_len + 1)
+		return (gf64_poly){{0}};
+
+	return error_loc;
+}
+
+// mask_pos has set bits for the valid (ie received) message terms and lets us skip the erasures and
+//  otherwise non-transmitted terms such as fixed padding or less than maximal message length
+uint64_t rs64_get_error_pos(gf64_poly error_loc, uint64_t mask_pos)
+{
+	uint64_t error_pos = 0;
+	gf64_idx loc_len = gf64_poly_get_size(error_loc);
+	while (mask_pos)
+	{
+		int8_t i = __builtin_ctzll(mask_pos);
+		if (!gf64_poly_eval(error_loc, loc_len, gf64_exp[GF64_MAX - i]))
+			error_pos |= (uint64_t)1 << i;
+		mask_pos &= mask_pos - 1;
+	}
+
+	return error_pos;
+}
+
+// tx_pos inludes set bits for only the valid positions for errors to occur, ie not in untransmitted padding symbols
+gf64_poly rs64_get_errata(gf64_poly recv, gf64_idx r_len, int8_t chk_syms, uint64_t e_pos, uint64_t tx_pos)
+{
+	int8_t erase_cnt = __builtin_popcountll(e_pos);
+	if (erase_cnt > chk_syms)	// beyond the Singleton Bound
+	{
+		gf64_poly fail;
+		for (int8_t i = 0; i < GF64_WORDS; ++i)
+			fail.w[i] = UINT64_MAX;
+		return fail;
+	}
+
+	gf64_poly e_eval = rs64_get_syndromes(recv, r_len, chk_syms);
+
+	if (gf64_poly_is_zero(e_eval))	// no errors
+		return e_eval;
+
+	gf64_poly e_loc = {{1}};
+
+	if (e_pos)	// this check isn't required but shortcuts excess calculations when no erasures specified
+	{
+		e_loc = rs64_get_erasure_locator(e_pos);
+		e_eval = rs64_get_errata_evaluator(e_eval, chk_syms, e_loc);	// compute Forney syndromes
+	}
+
+	if (erase_cnt != chk_syms)	// skip checking for errors if the maximum number of erasures occurred
+	{
+		// the first erase_cnt Forney syndromes are consumed by the erasures, only the rest say anything about the errors
+		gf64_poly error_loc = rs64_get_error_locator(gf64_poly_shift_down(e_eval, erase_cnt), chk_syms - erase_cnt);
+		int8_t error_loc_order = gf64_poly_get_order(error_loc);
+		if (gf64_poly_is_zero(error_loc) || 2 * error_loc_order > chk_syms - erase_cnt)	// check that the number of errors isn't beyond the Singleton Bound
+		{
+			error_loc.w[GF64_WORDS - 1] |= RS64_FAIL_ORDER;
+			return error_loc;
+		}
+		uint64_t error_pos = rs64_get_error_pos(error_loc, tx_pos & (~e_pos));
+		if (__builtin_popcountll(error_pos) != error_loc_order)	// not enough or too many roots
+		{
+			gf64_poly fail = {{error_pos}};
+			fail.w[GF64_WORDS - 1] = RS64_FAIL_ROOTS;
+			return fail;
+		}
+
+		// combine the error and erasure position, locator, and evaluator to the errata versions of themselves
+		e_pos |= error_pos;
+		e_loc = gf64_poly_mul(e_loc, error_loc);
+		e_eval = rs64_get_errata_evaluator(e_eval, chk_syms, error_loc);
+	}
+
+	return rs64_get_errata_magnitude(e_eval, chk_syms, e_loc, e_pos);
+}
+
+gf64_poly rs64_decode_systematic(gf64_poly recv, gf64_idx r_len, int8_t chk_syms, uint64_t e_pos, uint64_t tx_pos)
+{
+	return gf64_poly_shift_down(gf64_poly_add(recv, rs64_get_errata(recv, r_len, chk_syms, e_pos, tx_pos)), chk_syms);
+}
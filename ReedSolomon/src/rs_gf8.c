@@ -1,5 +1,7 @@
 // BCH view, systematic encoding Reed Solomon using 3 bit symbols
 #include "rs_gf8.h"
+#include "rs_profile.h"
+#include "rs_telemetry.h"
 
 #define RS8_BLOCK_MASK 07777777 // mask that represents the valid symbol positions
 
@@ -35,7 +37,7 @@ gf8_poly rs8_get_syndromes(gf8_poly p, gf8_idx p_sz, int8_t nsyms)
 	for (; nsyms > 0; --nsyms)	// accumulation done in descending index order
 	{							// which syndromes are used is effected by fcr so if you change that it must be changed here too
 		synd <<= GF8_SYM_SZ;
-		synd |= gf8_poly_eval(p, p_sz, gf8_exp[nsyms]);
+		synd |= gf8_poly_eval(p, p_sz, gf8_2pow(nsyms));
 	}
 
 	return synd;
@@ -43,9 +45,8 @@ gf8_poly rs8_get_syndromes(gf8_poly p, gf8_idx p_sz, int8_t nsyms)
 
 // erase_pos is encoded such that a set bit indicates the corresponding degree term is erased or in error
 //  might not be faster than listing indices but is a bit more transparent and since the field is small
-//  should have relatively little impact.
-// TODO: verify this ^
-gf8_poly rs8_get_erasure_locator(int8_t erase_pos)
+//  should have relatively little impact. The list version below is there to check this, see apps/bench_variants.c
+gf8_poly rs8_get_erasure_locator_mask(int8_t erase_pos)
 {
 	gf8_poly erase_loc = 1;	// the errata locator polynomial
 	for (int8_t i = 0; i < GF8_MAX; ++i)
@@ -54,7 +55,7 @@ gf8_poly rs8_get_erasure_locator(int8_t erase_pos)
 		{
 			// faster equivalent of gf8_poly_mul() for a monic binomial in the form (ax - 1)
 			// using this form of the roots simplifies later calculations since we know term 0 is a 1
-			erase_loc ^= gf8_poly_scale(erase_loc, gf8_exp[i]) << GF8_SYM_SZ;
+			erase_loc ^= gf8_poly_scale(erase_loc, gf8_2pow(i)) << GF8_SYM_SZ;
 		}
 		erase_pos >>= 1;
 	}
@@ -62,6 +63,29 @@ gf8_poly rs8_get_erasure_locator(int8_t erase_pos)
 	return erase_loc;
 }
 
+// same locator from a list of erased term indices
+gf8_poly rs8_get_erasure_locator_list(const int8_t* erase_list, int8_t erase_cnt)
+{
+	gf8_poly erase_loc = 1;
+	for (int8_t i = 0; i < erase_cnt; ++i)
+		erase_loc ^= gf8_poly_scale(erase_loc, gf8_2pow(erase_list[i])) << GF8_SYM_SZ;
+
+	return erase_loc;
+}
+
+gf8_poly rs8_get_erasure_locator(int8_t erase_pos)
+{
+#ifdef RS8_ERASE_LIST
+	int8_t erase_list[GF8_MAX];
+	int8_t erase_cnt = 0;
+	for (uint8_t e = erase_pos & 0x7F; e; e &= e - 1)	// only visits the set bits
+		erase_list[erase_cnt++] = __builtin_ctz(e);
+	return rs8_get_erasure_locator_list(erase_list, erase_cnt);
+#else
+	return rs8_get_erasure_locator_mask(erase_pos);
+#endif
+}
+
 // this can also be used to get the Forney Syndromes
 gf8_poly rs8_get_errata_evaluator(gf8_poly synd, gf8_idx chk_sz, gf8_poly errata_loc)
 {
@@ -96,7 +120,7 @@ gf8_poly rs8_get_errata_magnitude(gf8_poly errata_eval, gf8_idx chk_sz, gf8_poly
 
 		if (errata_pos & 128)
 		{
-			root = gf8_exp[i];
+			root = gf8_2pow(i);
 			ee_res = gf8_poly_eval(errata_eval, chk_sz, root);
 			lp_res = gf8_poly_eval(errata_loc_prime, chk_sz, root);	// chk_sz is guaranteed to be at least as big as errata_loc_prime's actual size
 			errata_mag |= gf8_div(ee_res, lp_res);					// TODO: if converting to position list form, consider adding a pairwise divide function to gf8.c
@@ -149,6 +173,12 @@ gf8_poly rs8_get_error_locator(gf8_poly synd, gf8_idx s_sz)
 		delay += GF8_SYM_SZ;
 	}
 
+	// fewer terms than L means no error pattern the remaining syndromes can describe fits them, eg a lone nonzero
+	//  first syndrome cancels back down to 1. 0 isn't a valid locator, they all have term 0 = 1, so it's returned
+	//  for rs8_get_errata_synd() to report instead of going on to "correct" 0 errors
+	if (gf8_poly_get_size(error_loc) != error_sz + GF8_SYM_SZ)
+		return 0;
+
 	return error_loc;
 }
 
@@ -163,7 +193,7 @@ int8_t rs8_get_error_pos(gf8_poly error_loc, int8_t mask_pos)
 		error_pos <<= 1;
 		mask_pos <<= 1;
 		if (mask_pos & 0b10000000)	// skips non-received symbols, not strictly required but potentially beneficial since poly eval is relatively expensive
-			error_pos |= !gf8_poly_eval(error_loc, 21, gf8_exp[i]);	// for non-C coders, this means that when it evaluates to 0 we get back a True which is equivalent to 1
+			error_pos |= !gf8_poly_eval(error_loc, 21, gf8_2pow(i));	// for non-C coders, this means that when it evaluates to 0 we get back a True which is equivalent to 1
 	}
 
 	return error_pos;
@@ -171,35 +201,66 @@ int8_t rs8_get_error_pos(gf8_poly error_loc, int8_t mask_pos)
 
 // tx_pos inludes set bits for only the valid positions for errors to occur, ie not in untransmitted padding symbols
 gf8_poly rs8_get_errata(gf8_poly recv, gf8_idx r_sz, int8_t chk_syms, int8_t e_pos, int8_t tx_pos)
+{
+	RS_PROF_START(total);
+	RS_PROF_START(t);
+	gf8_poly synd = rs8_get_syndromes(recv, r_sz, chk_syms);
+	RS_PROF_STAGE(RS_PROF_RS8, RS_STAGE_SYNDROMES, t);
+	gf8_poly errata = rs8_get_errata_synd(synd, chk_syms, e_pos, tx_pos);
+	RS_PROF_STAGE(RS_PROF_RS8, RS_STAGE_TOTAL, total);
+	return errata;
+}
+
+// same as rs8_get_errata() but starting from already calculated syndromes, lets batched versions
+//  compute the syndromes for several code words at once and only fall back to this for the dirty ones
+gf8_poly rs8_get_errata_synd(gf8_poly synd, int8_t chk_syms, int8_t e_pos, int8_t tx_pos)
 {
 	int8_t erase_cnt = __builtin_popcount(e_pos);
 	if (erase_cnt > chk_syms)	// if the number of erasures is greater than the number of check symbols,
+	{
+		RS_TELEM(RS_TELEM_RS8, RS_OUT_ERASE_OVERFLOW, 0, erase_cnt);
 		return -1;				// it's already beyond the Singleton Bound and can't be uniquely decoded so we return an error value
+	}
 
-	gf8_poly e_eval = rs8_get_syndromes(recv, r_sz, chk_syms);
+	gf8_poly e_eval = synd;
 
 	if (e_eval == 0)	// no errors
+	{
+		RS_TELEM(RS_TELEM_RS8, RS_OUT_CLEAN, 0, 0);
 		return 0;
+	}
 
 	gf8_idx chk_sz = chk_syms * GF8_SYM_SZ;
 	gf8_poly e_loc = 1;
+	RS_PROF_START(t);	// only stages that actually run get recorded, see rs_profile.h
 
 	if (e_pos) // this check isn't required but shortcuts excess calculations when no erasures specified
 	{
 		e_loc = rs8_get_erasure_locator(e_pos);
 		e_eval = rs8_get_errata_evaluator(e_eval, chk_sz, e_loc);	// compute Forney syndromes
+		RS_PROF_STAGE(RS_PROF_RS8, RS_STAGE_ERASURE_LOC, t);
 	}
 
 	if (erase_cnt != chk_syms)	// skip checking for errors if the maximum number of erasures occurred as we no longer have enough extra data
 	{
-		gf8_poly error_loc = rs8_get_error_locator(e_eval, chk_sz);	// may be smaller than chk_sz but under most conditions this is correct
+		// the first erase_cnt Forney syndromes are consumed by the erasures, only the rest say anything about the errors
+		gf8_idx erase_sz = erase_cnt * GF8_SYM_SZ;
+		gf8_poly error_loc = rs8_get_error_locator(e_eval >> erase_sz, chk_sz - erase_sz);
 		int8_t error_loc_order = gf8_poly_get_order(error_loc);
-		if (2 * error_loc_order > chk_syms - erase_cnt)	// check that the number of errors isn't beyond the Singleton Bound
+		RS_PROF_STAGE(RS_PROF_RS8, RS_STAGE_BERLEKAMP, t);
+		if (!error_loc || 2 * error_loc_order > chk_syms - erase_cnt)	// check that the number of errors isn't beyond the Singleton Bound
+		{
+			RS_TELEM(RS_TELEM_RS8, RS_OUT_BM_ORDER, 0, erase_cnt);
 			return 020000000000 | error_loc;
+		}
 		int8_t error_pos = rs8_get_error_pos(error_loc, tx_pos & (~e_pos));
 		int8_t error_cnt = __builtin_popcount(error_pos);
+		RS_PROF_STAGE(RS_PROF_RS8, RS_STAGE_CHIEN, t);
 		if (error_cnt != error_loc_order)
+		{
+			RS_TELEM(RS_TELEM_RS8, RS_OUT_ROOT_MISMATCH, 0, erase_cnt);
 			return 030000000000 | error_pos;	// not enough or too many roots
+		}
 
 		// combine the error and erasure position, locator, and evaluator to the errata versions of themselves
 		e_pos |= error_pos;
@@ -207,10 +268,56 @@ gf8_poly rs8_get_errata(gf8_poly recv, gf8_idx r_sz, int8_t chk_syms, int8_t e_p
 		e_eval = rs8_get_errata_evaluator(e_eval, chk_sz, error_loc);
 	}
 
-	return rs8_get_errata_magnitude(e_eval, chk_sz, e_loc, e_pos);
+	gf8_poly errata_mag = rs8_get_errata_magnitude(e_eval, chk_sz, e_loc, e_pos);
+	RS_PROF_STAGE(RS_PROF_RS8, RS_STAGE_FORNEY, t);
+	RS_TELEM(RS_TELEM_RS8, RS_OUT_CORRECTED, __builtin_popcount(e_pos) - erase_cnt, erase_cnt);
+	return errata_mag;
 }
 
 gf8_poly rs8_decode_systematic(gf8_poly recv, gf8_idx r_sz, int8_t chk_syms, int8_t e_pos, int8_t tx_pos)
 {
 	return (recv ^ rs8_get_errata(recv, r_sz, chk_syms, e_pos, tx_pos)) >> chk_syms*GF8_SYM_SZ;
+}
+
+// incremental redundancy, hybrid ARQ style, see rs_gf8.h
+// first transmission, the data plus the top chk_syms of max_chk check symbols, -1 if that shape doesn't fit
+gf8_poly rs8_ir_encode(gf8_poly raw, int8_t chk_syms, int8_t max_chk)
+{
+	if (chk_syms < 0 || chk_syms > max_chk || max_chk >= GF8_MAX)
+		return -1;
+	return rs8_encode_systematic(raw, max_chk) >> (max_chk - chk_syms) * GF8_SYM_SZ;
+}
+
+// the next extra_syms check symbols to send for a word that has chk_syms so far, in the low bits ready to be
+//  appended below it. The data is already in the word so this doesn't need the caller to keep the original around,
+//  at the cost of a full encode. -1 if the symbols asked for aren't all among the max_chk, which can't be confused
+//  with a result since those only fill the low extra_syms symbols
+gf8_poly rs8_ir_extend(gf8_poly sent, int8_t chk_syms, int8_t max_chk, int8_t extra_syms)
+{
+	if (chk_syms < 0 || extra_syms < 1 || chk_syms + extra_syms > max_chk || max_chk >= GF8_MAX)
+		return -1;
+	gf8_poly cw = rs8_encode_systematic(sent >> chk_syms * GF8_SYM_SZ, max_chk);
+	cw >>= (max_chk - chk_syms - extra_syms) * GF8_SYM_SZ;	// drop the ones that still aren't being sent
+	return cw & ((1 << extra_syms * GF8_SYM_SZ) - 1);
+}
+
+// errata for a word received with chk_syms of the max_chk check symbols, in the same layout as recv. The missing
+//  check symbols are put back below it as erasures so e_pos, tx_pos and the result all stay relative to recv,
+//  failures come back as the same sentinels as rs8_get_errata()
+gf8_poly rs8_ir_get_errata(gf8_poly recv, gf8_idx r_sz, int8_t chk_syms, int8_t max_chk, int8_t e_pos, int8_t tx_pos)
+{
+	int8_t missing = max_chk - chk_syms;
+	int8_t missing_pos = (1 << missing) - 1;
+	gf8_idx missing_sz = missing * GF8_SYM_SZ;
+	gf8_poly errata = rs8_get_errata(recv << missing_sz, r_sz + missing_sz, max_chk, ((e_pos << missing) | missing_pos) & 0x7F,
+		((tx_pos << missing) | missing_pos) & 0x7F);
+	if ((uint32_t)errata >> 21)	// every failure sentinel has bits set above the code word
+		return errata;
+
+	return errata >> missing_sz;
+}
+
+gf8_poly rs8_ir_decode(gf8_poly recv, gf8_idx r_sz, int8_t chk_syms, int8_t max_chk, int8_t e_pos, int8_t tx_pos)
+{
+	return (recv ^ rs8_ir_get_errata(recv, r_sz, chk_syms, max_chk, e_pos, tx_pos)) >> chk_syms*GF8_SYM_SZ;
 }
\ No newline at end of file
@@ -0,0 +1,70 @@
+// decode result caches in front of the rs8 decoder, see rs_gf8_cache.h
+#include "rs_gf8_cache.h"
+#include "rs_gf8.h"
+#include <string.h>
+
+#define RS8_CACHE_VALID (1ULL << 63)
+#define RS8_WORD_MASK 07777777
+
+// packs all the decoder inputs into one key, 21 bits of recv then 7 each of e_pos and tx_pos, 3 of chk_syms
+//  and 5 of r_sz, with the top bit set so no valid key is ever 0
+static uint64_t rs8_cache_key(gf8_poly recv, gf8_idx r_sz, int8_t chk_syms, int8_t e_pos, int8_t tx_pos)
+{
+	return RS8_CACHE_VALID | (uint64_t)(recv & RS8_WORD_MASK) | (uint64_t)(e_pos & 0x7F) << 21
+		| (uint64_t)(tx_pos & 0x7F) << 28 | (uint64_t)(chk_syms & 7) << 35 | (uint64_t)(r_sz & 037) << 38;
+}
+
+void rs8_cache_init(rs8_cache* c)
+{
+	memset(c, 0, sizeof(*c));
+}
+
+gf8_poly rs8_cache_get_errata(rs8_cache* c, gf8_poly recv, gf8_idx r_sz, int8_t chk_syms, int8_t e_pos, int8_t tx_pos)
+{
+	uint64_t key = rs8_cache_key(recv, r_sz, chk_syms, e_pos, tx_pos);
+	uint32_t set = (uint32_t)((key * 0x9E3779B97F4A7C15ULL) >> 40) & (RS8_CACHE_SETS - 1);	// Fibonacci hash, the low key bits alone cluster badly
+
+	for (int8_t w = 0; w < RS8_CACHE_WAYS; ++w)
+	{
+		if (c->key[set][w] == key)
+		{
+			++c->hits;
+			return c->errata[set][w];
+		}
+	}
+
+	++c->misses;
+	gf8_poly errata = rs8_get_errata(recv, r_sz, chk_syms, e_pos, tx_pos);
+	uint8_t w = c->victim[set];
+	c->key[set][w] = key;
+	c->errata[set][w] = errata;
+	c->victim[set] = (w + 1) % RS8_CACHE_WAYS;
+
+	return errata;
+}
+
+gf8_poly rs8_cache_decode_systematic(rs8_cache* c, gf8_poly recv, gf8_idx r_sz, int8_t chk_syms, int8_t e_pos, int8_t tx_pos)
+{
+	return (recv ^ rs8_cache_get_errata(c, recv, r_sz, chk_syms, e_pos, tx_pos)) >> chk_syms*GF8_SYM_SZ;
+}
+
+void rs8_full_table_init(rs8_full_table* t, int8_t chk_syms, int8_t tx_pos)
+{
+	t->chk_syms = chk_syms;
+	t->tx_pos = tx_pos;
+	for (gf8_poly recv = 0; recv < RS8_FULL_ENTRIES; ++recv)
+		t->errata[recv] = rs8_get_errata(recv, 21, chk_syms, 0, tx_pos);
+}
+
+// the table only covers words without erasures, those go to the decoder as usual
+gf8_poly rs8_full_table_get_errata(const rs8_full_table* t, gf8_poly recv, int8_t e_pos)
+{
+	if (e_pos)
+		return rs8_get_errata(recv, 21, t->chk_syms, e_pos, t->tx_pos);
+	return t->errata[recv & RS8_WORD_MASK];
+}
+
+gf8_poly rs8_full_table_decode_systematic(const rs8_full_table* t, gf8_poly recv, int8_t e_pos)
+{
+	return (recv ^ rs8_full_table_get_errata(t, recv, e_pos)) >> t->chk_syms*GF8_SYM_SZ;
+}
@@ -0,0 +1,376 @@
+// Configurable BCH view, systematic encoding Reed Solomon using 3 bit symbols
+#include "rs_gf8_codec.h"
+
+// masks that isolate out the term overflow from the result in the mul and scale functions,
+//  these only depend on the symbol size so they're shared with gf8.c
+#define RS8C_R1_OF 011111111110
+#define RS8C_R2_OF 033333333330
+#define RS8C_R1_R0 006666666666
+#define RS8C_R2_R0 004444444444
+#define RS8C_ODD   007070707070
+
+// builds every table and constant the encoder and decoder need so that none of it has to be worked out per call
+//  returns 0 on success or -1 if the polynomial isn't primitive or the code parameters don't fit in a gf8_poly
+int8_t rs8_codec_init(rs8_codec* c, gf8_poly prime, int8_t fcr, int8_t n, int8_t k)
+{
+	if ((prime >> GF8_SYM_SZ) != 1)	// must be exactly degree 3
+		return -1;
+	if (n > GF8_MAX || k < 1 || n - k < 1 || n - k > 6)	// packed mul only handles up to 6 check symbols
+		return -1;
+
+	// exp and log tables, primitive element 2 must cycle through every non-zero element exactly once
+	gf8_elem x = 1;
+	c->log[0] = -1;
+	for (int8_t i = 0; i < GF8_MAX; ++i)
+	{
+		if (x == 0 || (x == 1 && i != 0))	// hit 0 or cycled early so the polynomial isn't primitive
+			return -1;
+		c->exp[i] = x;
+		c->log[x] = i;
+		x <<= 1;
+		if (x > GF8_MAX)
+			x ^= prime;
+	}
+	if (x != 1)	// a reducible polynomial never gets back to 1 at all
+		return -1;
+	for (int8_t i = GF8_MAX; i < RS8_CODEC_EXP_ENTRIES; ++i)
+		c->exp[i] = c->exp[i - GF8_MAX];
+
+	// the overflow of a term j bits above the symbol is x^(3 + j) mod prime which gets folded back into the
+	//  term below it, every set bit b of that residue means shifting overflow bit j right by 3 + j - b,
+	//  grouping those by shift amount gives the fewest mask/shift pairs, ie 2 full width shifts for 1011
+	gf8_poly shift_mask[RS8_CODEC_RED_MAX + 1] = {0};
+	for (int8_t j = 0; j < GF8_SYM_SZ - 1; ++j)
+	{
+		int32_t res = 1 << (GF8_SYM_SZ + j);
+		for (int8_t b = GF8_SYM_SZ + j; b >= GF8_SYM_SZ; --b)
+		{
+			if (res & (1 << b))
+				res ^= prime << (b - GF8_SYM_SZ);
+		}
+
+		uint32_t lane_mask = 0;	// bit j of every term's overflow, ie bit j of every term but the lowest
+		for (int8_t t = GF8_SYM_SZ + j; t < 32; t += GF8_SYM_SZ)
+			lane_mask |= (uint32_t)1 << t;
+
+		for (int8_t b = 0; b < GF8_SYM_SZ; ++b)
+		{
+			if (res & (1 << b))
+				shift_mask[GF8_SYM_SZ + j - b] |= lane_mask;
+		}
+	}
+	c->red_cnt = 0;
+	for (int8_t s = RS8_CODEC_RED_MAX; s > 0; --s)
+	{
+		if (shift_mask[s])
+		{
+			c->red_mask[c->red_cnt] = shift_mask[s];
+			c->red_shift[c->red_cnt] = s;
+			++c->red_cnt;
+		}
+	}
+
+	fcr %= GF8_MAX;
+	if (fcr < 0)
+		fcr += GF8_MAX;
+
+	c->prime = prime;
+	c->fcr = fcr;
+	c->n = n;
+	c->k = k;
+	c->chk_syms = n - k;
+	c->n_sz = n * GF8_SYM_SZ;
+	c->chk_sz = c->chk_syms * GF8_SYM_SZ;
+	c->tx_pos = (1 << n) - 1;
+	c->msg_mask = (1 << (k * GF8_SYM_SZ)) - 1;
+
+	for (int8_t i = 0; i < GF8_MAX; ++i)
+	{
+		c->synd_root[i] = c->exp[fcr + i];
+		c->root_inv[i] = c->exp[GF8_MAX - i];
+		c->forney_log[i] = (i * (GF8_MAX + 1 - fcr)) % GF8_MAX;	// (1 - fcr) kept non-negative mod 7
+	}
+
+	// generator, multiplying by each monic binomial (x - alpha^(fcr + i)) in turn same as gen_LUTs does
+	c->g_poly = 1;
+	for (int8_t i = 0; i < c->chk_syms; ++i)
+		c->g_poly = rs8_codec_poly_scale(c, c->g_poly, c->synd_root[i]) ^ (c->g_poly << GF8_SYM_SZ);
+
+	return 0;
+}
+
+gf8_elem rs8_codec_mul(const rs8_codec* c, gf8_elem a, gf8_elem b)
+{
+	if (a == 0 || b == 0)
+		return 0;
+
+	return c->exp[c->log[a] + c->log[b]];
+}
+
+gf8_elem rs8_codec_div(const rs8_codec* c, gf8_elem a, gf8_elem b)
+{
+	if (b == 0)
+		return -1;	// divide by 0 error, normal operation should never get here
+	if (a == 0)
+		return 0;
+
+	return c->exp[GF8_MAX + c->log[a] - c->log[b]];
+}
+
+// generic version of gf8_poly_reduce(), folds each group of overflow bits back down by its precomputed shift
+gf8_poly rs8_codec_poly_reduce(const rs8_codec* c, gf8_poly p, gf8_poly of)
+{
+	for (int8_t i = 0; i < c->red_cnt; ++i)
+		p ^= (uint32_t)(of & c->red_mask[i]) >> c->red_shift[i];
+
+	return p;
+}
+
+gf8_poly rs8_codec_poly_scale(const rs8_codec* c, gf8_poly p, gf8_elem x)
+{
+	gf8_poly r0, r1, r2, of;
+	r0 = (x & 1) ? p : 0;
+	p <<= 1;
+	r1 = (x & 2) ? p : 0;
+	p <<= 1;
+	r2 = (x & 4) ? p : 0;
+
+	of = (r1 & RS8C_R1_OF) ^ (r2 & RS8C_R2_OF);
+	r0 ^= (r1 & RS8C_R1_R0) ^ (r2 & RS8C_R2_R0);
+
+	return rs8_codec_poly_reduce(c, r0, of);
+}
+
+// same limits as gf8_poly_mul(), no more than 5 terms in q
+gf8_poly rs8_codec_poly_mul(const rs8_codec* c, gf8_poly p, gf8_poly q)
+{
+	gf8_poly r0, r1, r2, of;
+	// term 0
+	r0 = (q & 01) ? p : 0;
+	r1 = (q & 02) * p;
+	r2 = (q & 04) * p;
+	// term 1
+	r0 ^= (q & 010) * p;
+	r1 ^= (q & 020) * p;
+	r2 ^= (q & 040) * p;
+	// term 2
+	r0 ^= (q & 0100) * p;
+	r1 ^= (q & 0200) * p;
+	r2 ^= (q & 0400) * p;
+	// term 3
+	r0 ^= (q & 01000) * p;
+	r1 ^= (q & 02000) * p;
+	r2 ^= (q & 04000) * p;
+	// term 4
+	r0 ^= (q & 010000) * p;
+	r1 ^= (q & 020000) * p;
+	r2 ^= (q & 040000) * p;
+
+	of = (r1 & RS8C_R1_OF) ^ (r2 & RS8C_R2_OF);
+	r0 ^= (r1 & RS8C_R1_R0) ^ (r2 & RS8C_R2_R0);
+
+	return rs8_codec_poly_reduce(c, r0, of);
+}
+
+gf8_poly rs8_codec_poly_mul_q0_monic(const rs8_codec* c, gf8_poly p, gf8_poly q)
+{
+	return p ^ (rs8_codec_poly_mul(c, p, q >> GF8_SYM_SZ) << GF8_SYM_SZ);
+}
+
+// p is dividend, q is divisor, p_sz and q_sz are size in BITS not symbols
+gf8_poly rs8_codec_poly_mod(const rs8_codec* c, gf8_poly p, gf8_idx p_sz, gf8_poly q, gf8_idx q_sz)
+{
+	p_sz -= GF8_SYM_SZ;
+	q_sz -= GF8_SYM_SZ;
+	p <<= q_sz;
+	q <<= p_sz;
+	for (gf8_idx i = p_sz + q_sz; i >= q_sz; i -= GF8_SYM_SZ)
+	{
+		p ^= rs8_codec_poly_scale(c, q, (p >> i) & GF8_MAX);
+		q >>= GF8_SYM_SZ;
+	}
+
+	return p;
+}
+
+gf8_elem rs8_codec_poly_eval(const rs8_codec* c, gf8_poly p, gf8_idx p_sz, gf8_elem x)
+{
+	p_sz -= GF8_SYM_SZ;
+	gf8_elem y = (p >> p_sz) & GF8_MAX;	// anything above the top term is ignored
+	gf8_elem logx = c->log[x];
+	for (p_sz -= GF8_SYM_SZ; p_sz >= 0; p_sz -= GF8_SYM_SZ)
+	{
+		if (y)
+			y = c->exp[c->log[y] + logx];
+
+		y ^= ((p >> p_sz) & GF8_MAX);
+	}
+	return y;
+}
+
+// the data length is fixed by the codec so leading 0 data symbols don't need to be counted
+gf8_poly rs8_codec_encode(const rs8_codec* c, gf8_poly raw)
+{
+	raw &= c->msg_mask;
+	gf8_poly chk = rs8_codec_poly_mod(c, raw, c->k * GF8_SYM_SZ, c->g_poly, c->chk_sz + GF8_SYM_SZ);
+	return (raw << c->chk_sz) | chk;
+}
+
+// only the n transmitted terms are evaluated, the padding is all 0s and contributes nothing
+gf8_poly rs8_codec_get_syndromes(const rs8_codec* c, gf8_poly p)
+{
+	gf8_poly synd = 0;
+	for (int8_t i = c->chk_syms - 1; i >= 0; --i)
+	{
+		synd <<= GF8_SYM_SZ;
+		synd |= rs8_codec_poly_eval(c, p, c->n_sz, c->synd_root[i]);
+	}
+
+	return synd;
+}
+
+gf8_poly rs8_codec_get_erasure_locator(const rs8_codec* c, int8_t erase_pos)
+{
+	gf8_poly erase_loc = 1;
+	while (erase_pos)
+	{
+		int8_t i = __builtin_ctz(erase_pos);
+		erase_loc ^= rs8_codec_poly_scale(c, erase_loc, c->exp[i]) << GF8_SYM_SZ;
+		erase_pos &= erase_pos - 1;
+	}
+
+	return erase_loc;
+}
+
+gf8_poly rs8_codec_get_errata_evaluator(const rs8_codec* c, gf8_poly synd, gf8_poly errata_loc)
+{
+	gf8_poly errata_eval = rs8_codec_poly_mul_q0_monic(c, synd, errata_loc);
+	errata_eval &= (1LL << c->chk_sz) - 1;
+	return errata_eval;
+}
+
+// Forney algorithm, same as rs8_get_errata_magnitude() but keeps the X(i)^(1-c) term for arbitrary fcr
+//  and only visits the errata positions instead of the whole block
+gf8_poly rs8_codec_get_errata_magnitude(const rs8_codec* c, gf8_poly errata_eval, gf8_poly errata_loc, int8_t errata_pos)
+{
+	gf8_poly errata_loc_prime = (errata_loc & RS8C_ODD) >> GF8_SYM_SZ;
+	gf8_poly errata_mag = 0;
+	while (errata_pos)
+	{
+		int8_t i = __builtin_ctz(errata_pos);
+		gf8_elem root = c->root_inv[i];
+		gf8_elem ee_res = rs8_codec_poly_eval(c, errata_eval, c->chk_sz, root);
+		gf8_elem lp_res = rs8_codec_poly_eval(c, errata_loc_prime, c->chk_sz, root);
+		if (ee_res && lp_res)
+			errata_mag |= (gf8_poly)c->exp[c->log[ee_res] + GF8_MAX - c->log[lp_res] + c->forney_log[i]] << (i * GF8_SYM_SZ);
+
+		errata_pos &= errata_pos - 1;
+	}
+
+	return errata_mag;
+}
+
+// Berlekamp-Massey, see rs8_get_error_locator() for the naming
+gf8_poly rs8_codec_get_error_locator(const rs8_codec* c, gf8_poly synd, gf8_idx s_sz)
+{
+	gf8_poly error_loc, error_loc_last, error_loc_temp;
+	gf8_elem disc, disc_last;
+	gf8_idx delay, error_sz;
+
+	error_loc = 1;
+	error_loc_last = 1;
+	error_sz = 0;
+	delay = GF8_SYM_SZ;
+	disc_last = 1;
+
+	for (gf8_idx n = 0; n < s_sz; n += GF8_SYM_SZ)
+	{
+		disc = (synd >> n) & GF8_MAX;
+		for (gf8_idx i = GF8_SYM_SZ; i <= error_sz; i += GF8_SYM_SZ)
+		{
+			disc ^= rs8_codec_mul(c, (error_loc >> i) & GF8_MAX, (synd >> (n - i)) & GF8_MAX);
+		}
+
+		if (disc)
+		{
+			error_loc_temp = error_loc;
+			error_loc ^= (rs8_codec_poly_scale(c, error_loc_last, rs8_codec_div(c, disc, disc_last)) << delay);
+
+			if (2 * error_sz <= n)
+			{
+				error_loc_last = error_loc_temp;
+				error_sz = GF8_SYM_SZ + n - error_sz;
+				disc_last = disc;
+				delay = 0;
+			}
+		}
+		delay += GF8_SYM_SZ;
+	}
+
+	if (gf8_poly_get_size(error_loc) != error_sz + GF8_SYM_SZ)	// doesn't fit any pattern in reach, see rs8_get_error_locator()
+		return 0;
+
+	return error_loc;
+}
+
+// Chien search limited to the transmitted positions that aren't already known erasures
+int8_t rs8_codec_get_error_pos(const rs8_codec* c, gf8_poly error_loc, int8_t mask_pos)
+{
+	int8_t error_pos = 0;
+	while (mask_pos)
+	{
+		int8_t i = __builtin_ctz(mask_pos);
+		if (!rs8_codec_poly_eval(c, error_loc, c->chk_sz + GF8_SYM_SZ, c->root_inv[i]))
+			error_pos |= 1 << i;
+
+		mask_pos &= mask_pos - 1;
+	}
+
+	return error_pos;
+}
+
+// same return convention as rs8_get_errata(), including the failure sentinels
+gf8_poly rs8_codec_get_errata(const rs8_codec* c, gf8_poly recv, int8_t e_pos)
+{
+	e_pos &= c->tx_pos;	// erasures in the padding are meaningless
+	int8_t erase_cnt = __builtin_popcount(e_pos);
+	if (erase_cnt > c->chk_syms)
+		return -1;
+
+	gf8_poly e_eval = rs8_codec_get_syndromes(c, recv);
+
+	if (e_eval == 0)
+		return 0;
+
+	gf8_poly e_loc = 1;
+
+	if (e_pos)
+	{
+		e_loc = rs8_codec_get_erasure_locator(c, e_pos);
+		e_eval = rs8_codec_get_errata_evaluator(c, e_eval, e_loc);
+	}
+
+	if (erase_cnt != c->chk_syms)
+	{
+		gf8_idx erase_sz = erase_cnt * GF8_SYM_SZ;
+		gf8_poly error_loc = rs8_codec_get_error_locator(c, e_eval >> erase_sz, c->chk_sz - erase_sz);
+		int8_t error_loc_order = gf8_poly_get_order(error_loc);
+		if (!error_loc || 2 * error_loc_order > c->chk_syms - erase_cnt)
+			return 020000000000 | error_loc;
+		int8_t error_pos = rs8_codec_get_error_pos(c, error_loc, c->tx_pos & (~e_pos));
+		int8_t error_cnt = __builtin_popcount(error_pos);
+		if (error_cnt != error_loc_order)
+			return 030000000000 | error_pos;
+
+		e_pos |= error_pos;
+		e_loc = rs8_codec_poly_mul(c, e_loc, error_loc);
+		e_eval = rs8_codec_get_errata_evaluator(c, e_eval, error_loc);
+	}
+
+	return rs8_codec_get_errata_magnitude(c, e_eval, e_loc, e_pos);
+}
+
+gf8_poly rs8_codec_decode(const rs8_codec* c, gf8_poly recv, int8_t e_pos)
+{
+	return (recv ^ rs8_codec_get_errata(c, recv, e_pos)) >> c->chk_sz;
+}
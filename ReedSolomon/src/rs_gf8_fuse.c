@@ -0,0 +1,88 @@
+// multi-read fusion for rs8, see rs_gf8_fuse.h
+#include "rs_gf8_fuse.h"
+#include "rs_gf8.h"
+
+// the failure sentinels all have bits set above a full length code word
+#define RS8_FUSE_FAIL(errata) ((uint32_t)(errata) >> (GF8_MAX * GF8_SYM_SZ))
+
+// symbol wise majority of cnt reads of r_sz bits, e_pos can be NULL if no read has erasures or else holds the
+//  erasures of each read. A symbol is only kept if more than half the reads that didn't erase it agree on it,
+//  otherwise it's 0 in the result and set in fused_e_pos
+gf8_poly rs8_fuse_reads(const gf8_poly* recv, const int8_t* e_pos, int8_t cnt, gf8_idx r_sz, int8_t* fused_e_pos)
+{
+	gf8_poly fused = 0;
+	int8_t erased = 0;
+	if (cnt > RS8_FUSE_MAX_READS)
+		cnt = RS8_FUSE_MAX_READS;
+
+	for (int8_t b = 0; b * GF8_SYM_SZ < r_sz; ++b)
+	{
+		int8_t votes[1 + GF8_MAX] = {0};
+		int8_t valid = 0;
+		for (int8_t k = 0; k < cnt; ++k)
+		{
+			if (e_pos && ((e_pos[k] >> b) & 1))
+				continue;
+			++votes[(recv[k] >> (b * GF8_SYM_SZ)) & GF8_MAX];
+			++valid;
+		}
+
+		int8_t best = 0;
+		for (int8_t v = 1; v <= GF8_MAX; ++v)
+		{
+			if (votes[v] > votes[best])
+				best = v;
+		}
+		if (2 * votes[best] > valid)	// also catches a symbol nobody has, 0 votes out of 0
+			fused |= (gf8_poly)best << (b * GF8_SYM_SZ);
+		else
+			erased |= 1 << b;
+	}
+
+	*fused_e_pos = erased;
+	return fused;
+}
+
+// decodes the fused reads and falls back to decoding each read on its own if that fails, raw gets the data on
+//  success. Returns one of the RS8_FUSE_ results, see rs_gf8_fuse.h
+int8_t rs8_fuse_decode(const gf8_poly* recv, const int8_t* e_pos, int8_t cnt, gf8_idx r_sz, int8_t chk_syms, int8_t tx_pos, gf8_poly* raw)
+{
+	int8_t fused_e_pos;
+	gf8_poly fused = rs8_fuse_reads(recv, e_pos, cnt, r_sz, &fused_e_pos);
+	gf8_poly errata = rs8_get_errata(fused, r_sz, chk_syms, fused_e_pos, tx_pos);
+	if (!RS8_FUSE_FAIL(errata))
+	{
+		*raw = (fused ^ errata) >> chk_syms * GF8_SYM_SZ;
+		return RS8_FUSE_FUSED;
+	}
+
+	// every read that decodes on its own votes for its data, the first to reach the most votes wins ties
+	gf8_poly data[RS8_FUSE_MAX_READS];
+	int8_t votes[RS8_FUSE_MAX_READS];
+	int8_t found = 0, best = -1;
+	if (cnt > RS8_FUSE_MAX_READS)
+		cnt = RS8_FUSE_MAX_READS;
+	for (int8_t k = 0; k < cnt; ++k)
+	{
+		errata = rs8_get_errata(recv[k], r_sz, chk_syms, e_pos ? e_pos[k] : 0, tx_pos);
+		if (RS8_FUSE_FAIL(errata))
+			continue;
+
+		gf8_poly d = (recv[k] ^ errata) >> chk_syms * GF8_SYM_SZ;
+		int8_t j = 0;
+		while (j < found && data[j] != d)
+			++j;
+		if (j == found)
+		{
+			data[found] = d;
+			votes[found++] = 0;
+		}
+		if (++votes[j] > (best < 0 ? 0 : votes[best]))
+			best = j;
+	}
+
+	if (best < 0)
+		return RS8_FUSE_FAILED;
+	*raw = data[best];
+	return RS8_FUSE_SINGLE;
+}
@@ -0,0 +1,124 @@
+// nearest code word decoding for short rs8 codes, see rs_gf8_ml.h
+#include "rs_gf8_ml.h"
+#include "rs_gf8.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#define RS8_ML_SYM_LSBS 01111111	// lowest bit of every symbol
+#define RS8_ML_SUM_SHIFT 18			// multiplying by RS8_ML_SYM_LSBS sums every symbol into the top one
+
+// returns -1 if the code book would be too big or the code word too long
+int8_t rs8_ml_init(rs8_ml_codebook* cb, int8_t chk_syms, int8_t data_syms)
+{
+	if (data_syms < 1 || data_syms > RS8_ML_MAX_DATA_SYMS || chk_syms < 1 || chk_syms + data_syms > GF8_MAX)
+		return -1;
+
+	cb->chk_syms = chk_syms;
+	cb->data_syms = data_syms;
+	cb->cw_cnt = 1 << (data_syms * GF8_SYM_SZ);
+	for (int32_t raw = 0; raw < cb->cw_cnt; ++raw)
+		cb->cw[raw] = rs8_encode_systematic(raw, chk_syms);
+
+	return 0;
+}
+
+// the lowest bit of every symbol that isn't erased
+gf8_poly rs8_ml_keep_mask(int8_t e_pos)
+{
+	gf8_poly keep = RS8_ML_SYM_LSBS;
+	for (int8_t i = 0; i < GF8_MAX; ++i)
+	{
+		if ((e_pos >> i) & 1)
+			keep &= ~(1 << (GF8_SYM_SZ * i));
+	}
+
+	return keep;
+}
+
+// folds each symbol of the difference down to its lowest bit so a nonzero symbol leaves exactly 1 bit, then
+//  multiplying by 01111111 adds all 7 of those up into the top symbol, which can hold the max of 7 without carrying
+int8_t rs8_ml_distance_keep(gf8_poly a, gf8_poly b, gf8_poly keep)
+{
+	gf8_poly x = a ^ b;
+	x = (x | (x >> 1) | (x >> 2)) & keep;
+	return ((uint32_t)x * RS8_ML_SYM_LSBS >> RS8_ML_SUM_SHIFT) & GF8_MAX;
+}
+
+int8_t rs8_ml_distance(gf8_poly a, gf8_poly b, int8_t e_pos)
+{
+	return rs8_ml_distance_keep(a, b, rs8_ml_keep_mask(e_pos));
+}
+
+// returns the raw data of the nearest code word, ties go to the lowest raw data
+gf8_poly rs8_ml_decode(const rs8_ml_codebook* cb, gf8_poly recv, int8_t e_pos, int8_t* best_dist, int8_t* second_dist)
+{
+	gf8_poly keep = rs8_ml_keep_mask(e_pos);
+	int32_t best = GF8_MAX + 1, second = GF8_MAX + 1, best_idx = 0;
+	int32_t i = 0;
+
+#if defined(__AVX2__)
+	// 8 code words at a time, each lane keeps its own best and second best that get merged at the end
+	const __m256i v_recv = _mm256_set1_epi32(recv);
+	const __m256i v_keep = _mm256_set1_epi32(keep);
+	const __m256i v_lsbs = _mm256_set1_epi32(RS8_ML_SYM_LSBS);
+	const __m256i v_max = _mm256_set1_epi32(GF8_MAX);
+	const __m256i v_step = _mm256_set1_epi32(8);
+	__m256i v_best = _mm256_set1_epi32(GF8_MAX + 1);
+	__m256i v_second = v_best;
+	__m256i v_best_idx = _mm256_setzero_si256();
+	__m256i v_idx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+	for (; i + 8 <= cb->cw_cnt; i += 8)
+	{
+		__m256i x = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(cb->cw + i)), v_recv);
+		x = _mm256_or_si256(_mm256_or_si256(x, _mm256_srli_epi32(x, 1)), _mm256_srli_epi32(x, 2));
+		x = _mm256_and_si256(x, v_keep);
+		__m256i d = _mm256_and_si256(_mm256_srli_epi32(_mm256_mullo_epi32(x, v_lsbs), RS8_ML_SUM_SHIFT), v_max);
+
+		__m256i closer = _mm256_cmpgt_epi32(v_best, d);
+		v_second = _mm256_min_epi32(v_second, _mm256_max_epi32(v_best, d));
+		v_best = _mm256_min_epi32(v_best, d);
+		v_best_idx = _mm256_blendv_epi8(v_best_idx, v_idx, closer);
+		v_idx = _mm256_add_epi32(v_idx, v_step);
+	}
+
+	int32_t lane_best[8], lane_second[8], lane_idx[8];
+	_mm256_storeu_si256((__m256i*)lane_best, v_best);
+	_mm256_storeu_si256((__m256i*)lane_second, v_second);
+	_mm256_storeu_si256((__m256i*)lane_idx, v_best_idx);
+	for (int8_t l = 0; l < 8; ++l)
+	{
+		if (lane_best[l] < best || (lane_best[l] == best && lane_idx[l] < best_idx))
+		{
+			second = best < lane_second[l] ? best : lane_second[l];
+			best = lane_best[l];
+			best_idx = lane_idx[l];
+		}
+		else
+		{
+			int32_t s = lane_best[l];	// a lane's best that loses is still a candidate for second
+			second = s < second ? s : second;
+		}
+	}
+#endif
+
+	for (; i < cb->cw_cnt; ++i)
+	{
+		int32_t d = rs8_ml_distance_keep(cb->cw[i], recv, keep);
+		if (d < best)
+		{
+			second = best;
+			best = d;
+			best_idx = i;
+		}
+		else if (d < second)
+			second = d;
+	}
+
+	if (best_dist)
+		*best_dist = best;
+	if (second_dist)
+		*second_dist = second;
+	return best_idx;
+}
@@ -0,0 +1,66 @@
+// BCH view, systematic encoding Reed Solomon using 3 bit symbols, 2 code words at a time
+#include "rs_gf8x2.h"
+#include "rs_gf8.h"
+#include "rs_telemetry.h"
+
+#define RS8_BLOCK_MASK 07777777ULL				// valid symbol positions in a lane
+#define RS8X2_TERM_LO (01111111ULL * GF8X2_LANE_LO)		// bit 0 of each valid term in both lanes
+
+// same as rs8_encode_systematic() for both lanes, the message size is taken from the longer lane
+gf8x2_poly rs8x2_encode_systematic(gf8x2_poly raw, int8_t chk_syms)
+{
+	gf8_idx chk_sz = chk_syms * GF8_SYM_SZ;
+	raw &= (RS8_BLOCK_MASK >> chk_sz) * GF8X2_LANE_LO;	// truncate most significant bits if provided data is oversized
+	gf8_idx msg_sz = gf8_poly_get_size(gf8x2_get_lane(raw, 0) | gf8x2_get_lane(raw, 1));
+	chk_sz += GF8_SYM_SZ;
+
+	gf8x2_poly chk = gf8x2_poly_mod(raw, msg_sz, rs8_G_polys[chk_syms] * GF8X2_LANE_LO, chk_sz);
+	raw <<= chk_sz - GF8_SYM_SZ;
+	return raw | chk;
+}
+
+// instead of evaluating the code word once per syndrome, all the syndromes of both lanes are evaluated together
+//  with Horner's method, term s of every step is multiplied by alpha^(s + 1) and the next received term is added
+//  to all of them, so the result has the same layout as rs8_get_syndromes()
+gf8x2_poly rs8x2_get_syndromes(gf8x2_poly recv, int8_t chk_syms)
+{
+	gf8_idx chk_sz = chk_syms * GF8_SYM_SZ;
+	gf8x2_poly roots = 0;
+	for (int8_t s = chk_syms; s > 0; --s)	// which syndromes are used is effected by fcr so if you change that it must be changed here too
+		roots = (roots << GF8_SYM_SZ) | gf8_2pow(s);
+	roots *= GF8X2_LANE_LO;
+	gf8x2_poly broadcast = RS8X2_TERM_LO & ((1ULL << chk_sz) - 1) & GF8X2_LANE;	// copies a term to each syndrome in its lane
+
+	gf8x2_poly synd = 0;
+	for (gf8_idx i = 6 * GF8_SYM_SZ; i >= 0; i -= GF8_SYM_SZ)
+		synd = gf8x2_poly_mul_terms(synd, roots) ^ (((recv >> i) & (GF8_MAX * GF8X2_LANE_LO)) * broadcast);
+
+	return synd;
+}
+
+// the syndromes are the bulk of the work for a clean code word, so only lanes that need it go through the
+//  rest of the scalar decoder
+gf8x2_poly rs8x2_get_errata(gf8x2_poly recv, int8_t chk_syms, uint16_t e_pos, uint16_t tx_pos)
+{
+	gf8x2_poly synd = rs8x2_get_syndromes(recv, chk_syms);
+	gf8x2_poly errata = 0;
+
+	for (int8_t lane = 0; lane < 2; ++lane)
+	{
+		int8_t lane_e = e_pos >> (8 * lane);
+		int8_t lane_tx = tx_pos >> (8 * lane);
+		gf8_poly lane_synd = gf8x2_get_lane(synd, lane);
+		if (lane_synd || __builtin_popcount((uint8_t)lane_e) > chk_syms)
+			errata |= (gf8x2_poly)(uint32_t)rs8_get_errata_synd(lane_synd, chk_syms, lane_e, lane_tx) << (GF8X2_LANE_SZ * lane);
+		else
+			RS_TELEM(RS_TELEM_RS8, RS_OUT_CLEAN, 0, 0);	// counted here since clean lanes never reach the scalar decoder
+	}
+
+	return errata;
+}
+
+gf8x2_poly rs8x2_decode_systematic(gf8x2_poly recv, int8_t chk_syms, uint16_t e_pos, uint16_t tx_pos)
+{
+	gf8_idx chk_sz = chk_syms * GF8_SYM_SZ;
+	return ((recv ^ rs8x2_get_errata(recv, chk_syms, e_pos, tx_pos)) >> chk_sz) & ((GF8X2_LANE >> chk_sz) * GF8X2_LANE_LO);
+}
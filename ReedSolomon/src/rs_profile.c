@@ -0,0 +1,166 @@
+// per stage cycle histograms for the decoders, see rs_profile.h
+//
+// every thread gets its own block of histograms the first time it records something, so the hot path is a few
+//  uncontended relaxed adds with no sharing between cores. The blocks go on a lock-free list that snapshots walk,
+//  and they're never freed so counts from threads that have exited stay in the totals
+#include "rs_profile.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+typedef struct rs_prof_thread
+{
+	rs_prof_hist stage[RS_PROF_CODES][RS_STAGE_CNT];
+	struct rs_prof_thread* next;
+} rs_prof_thread;
+
+static rs_prof_thread* rs_prof_threads = NULL;		// head of the list of every thread's block
+static _Thread_local rs_prof_thread* rs_prof_local = NULL;
+
+static const char* const rs_prof_stage_names[RS_STAGE_CNT] = {
+	"syndromes", "erasure_locator", "berlekamp_massey", "chien", "forney", "total"
+};
+
+uint64_t rs_profile_now(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	struct timespec t;	// no portable cycle counter, counts ns instead
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (uint64_t)t.tv_sec * 1000000000 + t.tv_nsec;
+#endif
+}
+
+// allocates this thread's block and pushes it on the front of the list, only ever runs once per thread
+static rs_prof_thread* rs_profile_register(void)
+{
+	rs_prof_thread* t = calloc(1, sizeof(*t));
+	if (!t)
+		return NULL;
+
+	t->next = __atomic_load_n(&rs_prof_threads, __ATOMIC_RELAXED);
+	while (!__atomic_compare_exchange_n(&rs_prof_threads, &t->next, t, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+		;	// t->next gets refreshed with the current head on failure
+
+	return t;
+}
+
+// only the owning thread ever adds to its block, the atomics are just so snapshots from other threads read whole values
+static void rs_prof_add(uint64_t* counter, uint64_t v)
+{
+	__atomic_store_n(counter, __atomic_load_n(counter, __ATOMIC_RELAXED) + v, __ATOMIC_RELAXED);
+}
+
+void rs_profile_record(rs_prof_code code, rs_prof_stage stage, uint64_t cycles)
+{
+	if (!rs_prof_local)
+	{
+		rs_prof_local = rs_profile_register();
+		if (!rs_prof_local)
+			return;	// out of memory, drops the sample rather than failing the decode
+	}
+
+	rs_prof_hist* h = &rs_prof_local->stage[code][stage];
+	int8_t bucket = cycles ? 64 - __builtin_clzll(cycles) : 0;
+	if (bucket >= RS_PROF_BUCKETS)
+		bucket = RS_PROF_BUCKETS - 1;
+	rs_prof_add(&h->count, 1);
+	rs_prof_add(&h->cycles, cycles);
+	rs_prof_add(&h->hist[bucket], 1);
+}
+
+void rs_profile_snapshot_get(rs_profile_snapshot* snap)
+{
+	memset(snap, 0, sizeof(*snap));
+	for (rs_prof_thread* t = __atomic_load_n(&rs_prof_threads, __ATOMIC_ACQUIRE); t; t = t->next)
+	{
+		for (int8_t c = 0; c < RS_PROF_CODES; ++c)
+		{
+			for (int8_t s = 0; s < RS_STAGE_CNT; ++s)
+			{
+				rs_prof_hist* src = &t->stage[c][s];
+				rs_prof_hist* dst = &snap->stage[c][s];
+				dst->count += __atomic_load_n(&src->count, __ATOMIC_RELAXED);
+				dst->cycles += __atomic_load_n(&src->cycles, __ATOMIC_RELAXED);
+				for (int8_t b = 0; b < RS_PROF_BUCKETS; ++b)
+					dst->hist[b] += __atomic_load_n(&src->hist[b], __ATOMIC_RELAXED);
+			}
+		}
+	}
+}
+
+// meant to be called between runs, a thread recording at the same moment can lose or keep that one sample
+void rs_profile_reset(void)
+{
+	for (rs_prof_thread* t = __atomic_load_n(&rs_prof_threads, __ATOMIC_ACQUIRE); t; t = t->next)
+	{
+		uint64_t* counters = (uint64_t*)t->stage;
+		for (size_t i = 0; i < sizeof(t->stage) / sizeof(uint64_t); ++i)
+			__atomic_store_n(&counters[i], 0, __ATOMIC_RELAXED);
+	}
+}
+
+// upper bound of the bucket the pct percentile falls in, so at most 2x over the real value, 0 for an empty histogram
+uint64_t rs_profile_percentile(const rs_prof_hist* h, double pct)
+{
+	if (!h->count)
+		return 0;
+
+	uint64_t rank = (uint64_t)(pct / 100 * h->count);
+	if (rank >= h->count)
+		rank = h->count - 1;
+
+	uint64_t seen = 0;
+	for (int8_t b = 0; b < RS_PROF_BUCKETS; ++b)
+	{
+		seen += h->hist[b];
+		if (seen > rank)
+			return b ? (1ULL << b) - 1 : 0;
+	}
+
+	return UINT64_MAX;
+}
+
+const char* rs_profile_stage_name(rs_prof_stage stage)
+{
+	return (stage >= 0 && stage < RS_STAGE_CNT) ? rs_prof_stage_names[stage] : "unknown";
+}
+
+// only stages that recorded something are written, and only their non-empty buckets keyed by the bucket's upper bound
+void rs_profile_export_json(FILE* f, const rs_profile_snapshot* snap)
+{
+	static const char* const code_names[RS_PROF_CODES] = {"rs8", "rs16"};
+	int8_t first = 1;
+
+	fprintf(f, "{\"profile\": [");
+	for (int8_t c = 0; c < RS_PROF_CODES; ++c)
+	{
+		for (int8_t s = 0; s < RS_STAGE_CNT; ++s)
+		{
+			const rs_prof_hist* h = &snap->stage[c][s];
+			if (!h->count)
+				continue;
+
+			fprintf(f, "%s\n  {\"code\": \"%s\", \"stage\": \"%s\", \"count\": %llu, \"cycles\": %llu, \"mean\": %.1f, "
+				"\"p50\": %llu, \"p99\": %llu, \"hist\": {", first ? "" : ",", code_names[c], rs_profile_stage_name(s),
+				(unsigned long long)h->count, (unsigned long long)h->cycles, (double)h->cycles / h->count,
+				(unsigned long long)rs_profile_percentile(h, 50), (unsigned long long)rs_profile_percentile(h, 99));
+			int8_t first_b = 1;
+			for (int8_t b = 0; b < RS_PROF_BUCKETS; ++b)
+			{
+				if (!h->hist[b])
+					continue;
+				fprintf(f, "%s\"%llu\": %llu", first_b ? "" : ", ",
+					(unsigned long long)(b ? (1ULL << b) - 1 : 0), (unsigned long long)h->hist[b]);
+				first_b = 0;
+			}
+			fprintf(f, "}}");
+			first = 0;
+		}
+	}
+	fprintf(f, "\n]}\n");
+}
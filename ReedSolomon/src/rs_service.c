@@ -0,0 +1,398 @@
+// shared memory decode service, see rs_service.h
+#define _GNU_SOURCE	// pthread_setaffinity_np()
+#include "rs_service.h"
+#include "rs_batch.h"
+#include "rs_gf8.h"
+#include "rs_gf16.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+// not FUTEX_PRIVATE_FLAG, the words are shared between processes
+static int rs_service_futex_wait(uint32_t* addr, uint32_t val, int32_t ms)
+{
+	struct timespec t = {ms / 1000, (ms % 1000) * 1000000L};
+	return syscall(SYS_futex, addr, FUTEX_WAIT, val, &t, NULL, 0);
+}
+
+static void rs_service_futex_wake(uint32_t* addr)
+{
+	syscall(SYS_futex, addr, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
+
+// a pid we can't signal for lack of permission still counts as alive
+static int8_t rs_service_pid_dead(int32_t pid)
+{
+	return pid <= 0 || (kill(pid, 0) && errno == ESRCH);
+}
+
+static void rs_service_path(char* path, size_t sz, const char* name)
+{
+	snprintf(path, sz, "/tiny_ecc.%s", name);
+}
+
+// daemon
+
+// takes everything pending, up to a batch, starting from a different slot every round so a client with a lot
+//  queued can't keep the others waiting
+static int32_t rs_service_gather(rs_service* s)
+{
+	int32_t cnt = 0;
+	for (int8_t i = 0; i < RS_SERVICE_CLIENTS && cnt < RS_SERVICE_BATCH; ++i)
+	{
+		int8_t k = (s->next_slot + i) % RS_SERVICE_CLIENTS;
+		uint32_t head = __atomic_load_n(&s->shm->slot[k].head, __ATOMIC_ACQUIRE);
+		for (; s->taken[k] != head && cnt < RS_SERVICE_BATCH; ++cnt)
+		{
+			s->batch_slot[cnt] = k;
+			s->batch_pos[cnt] = s->taken[k]++ & (RS_SERVICE_RING - 1);
+		}
+	}
+	s->next_slot = (s->next_slot + 1) % RS_SERVICE_CLIENTS;
+	return cnt;
+}
+
+// requests come from other processes so anything that would index outside the decoder's tables is refused
+static int8_t rs_service_valid(const rs_service_req* r)
+{
+	if (r->op != RS_SERVICE_ENCODE && r->op != RS_SERVICE_ERRATA)
+		return 0;
+	if (r->code == RS_BATCH_RS8)
+		return r->chk_syms >= 1 && r->chk_syms < GF8_MAX;
+	return r->code == RS_BATCH_RS16 && r->chk_syms >= 1 && r->chk_syms < GF16_MAX;
+}
+
+// the rest is masked to the code, a word with bits above it would otherwise reach the decoders, and positions past
+//  the last symbol would count as erasures that aren't there
+static void rs_service_mask(rs_service_req* r)
+{
+	int8_t n = r->code == RS_BATCH_RS8 ? GF8_MAX : GF16_MAX;
+	int8_t sym_sz = r->code == RS_BATCH_RS8 ? GF8_SYM_SZ : GF16_SYM_SZ;
+	r->word &= ((int64_t)1 << n * sym_sz) - 1;
+	r->e_pos &= (1 << n) - 1;
+	r->tx_pos &= (1 << n) - 1;
+}
+
+// worker w's share of the round, decodes go through rs_batch_get_errata() RS_BATCH_MAX at a time
+static void rs_service_process(rs_service* s, int8_t w)
+{
+	rs_batch_req dec[RS_BATCH_MAX];
+	int64_t errata[RS_BATCH_MAX];
+	int64_t* dst[RS_BATCH_MAX];
+	int16_t dec_cnt = 0;
+	int32_t lo = s->batch_cnt * w / s->worker_cnt, hi = s->batch_cnt * (w + 1) / s->worker_cnt;
+
+	for (int32_t i = lo; i < hi; ++i)
+	{
+		rs_service_slot* slot = &s->shm->slot[s->batch_slot[i]];
+		rs_service_req r = slot->req[s->batch_pos[i]];	// copied since the client can write it at any time
+		int64_t* res = &slot->res[s->batch_pos[i]];
+		if (!rs_service_valid(&r))
+			*res = -1;
+		else
+		{
+			rs_service_mask(&r);
+			if (r.op == RS_SERVICE_ENCODE)
+				*res = r.code == RS_BATCH_RS8 ? rs8_encode_systematic(r.word, r.chk_syms) : rs16_encode_systematic(r.word, r.chk_syms);
+			else
+			{
+				dec[dec_cnt] = (rs_batch_req){r.word, r.code, r.chk_syms, r.e_pos, r.tx_pos};
+				dst[dec_cnt++] = res;
+			}
+		}
+
+		if (dec_cnt == RS_BATCH_MAX || (i == hi - 1 && dec_cnt))
+		{
+			rs_batch_get_errata(dec, errata, dec_cnt, NULL);
+			for (int16_t j = 0; j < dec_cnt; ++j)
+				*dst[j] = errata[j];
+			dec_cnt = 0;
+		}
+	}
+}
+
+// hands every slot its new completed count and wakes the clients asleep on it
+static void rs_service_publish(rs_service* s)
+{
+	for (int8_t k = 0; k < RS_SERVICE_CLIENTS; ++k)
+	{
+		rs_service_slot* slot = &s->shm->slot[k];
+		if (__atomic_load_n(&slot->done, __ATOMIC_RELAXED) == s->taken[k])
+			continue;
+
+		__atomic_store_n(&slot->done, s->taken[k], __ATOMIC_SEQ_CST);
+		if (__atomic_exchange_n(&slot->waiting, 0, __ATOMIC_SEQ_CST))
+			rs_service_futex_wake(&slot->done);
+	}
+}
+
+// sleeping is set before the doorbell is read, so a client either rings after that and sees it needs to wake
+//  the daemon or rang before and its requests are seen by the check here
+static void rs_service_sleep(rs_service* s)
+{
+	__atomic_store_n(&s->shm->sleeping, 1, __ATOMIC_SEQ_CST);
+	uint32_t bell = __atomic_load_n(&s->shm->doorbell, __ATOMIC_SEQ_CST);
+	int8_t pending = 0;
+	for (int8_t k = 0; k < RS_SERVICE_CLIENTS && !pending; ++k)
+		pending = __atomic_load_n(&s->shm->slot[k].head, __ATOMIC_ACQUIRE) != s->taken[k];
+	if (!pending && !__atomic_load_n(&s->stop, __ATOMIC_ACQUIRE))
+		rs_service_futex_wait(&s->shm->doorbell, bell, RS_SERVICE_POLL_MS);
+	__atomic_store_n(&s->shm->sleeping, 0, __ATOMIC_SEQ_CST);
+}
+
+// worker 0 gathers and publishes each round and does its share of the work in between, the rest only do their
+//  share. A negative batch_cnt tells them to exit
+static void* rs_service_worker_main(void* arg)
+{
+	rs_service_worker* me = arg;
+	rs_service* s = me->s;
+	if (me->cpu >= 0)
+	{
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		CPU_SET(me->cpu, &set);
+		pthread_setaffinity_np(pthread_self(), sizeof(set), &set);	// best effort, a missing CPU just runs unpinned
+	}
+
+	if (me->idx)
+	{
+		for (;;)
+		{
+			pthread_barrier_wait(&s->round_start);
+			if (s->batch_cnt < 0)
+				return NULL;
+			rs_service_process(s, me->idx);
+			pthread_barrier_wait(&s->round_end);
+		}
+	}
+
+	for (;;)
+	{
+		s->batch_cnt = rs_service_gather(s);
+		if (!s->batch_cnt)
+		{
+			if (__atomic_load_n(&s->stop, __ATOMIC_ACQUIRE))
+				break;	// only once everything already submitted is done
+			rs_service_sleep(s);
+			continue;
+		}
+		pthread_barrier_wait(&s->round_start);
+		rs_service_process(s, 0);
+		pthread_barrier_wait(&s->round_end);
+		rs_service_publish(s);
+	}
+
+	s->batch_cnt = -1;
+	pthread_barrier_wait(&s->round_start);
+	return NULL;
+}
+
+// creates the segment for name and starts workers threads, worker i pinned to cpus[i % cpu_cnt] or not pinned if
+//  cpus is NULL. Returns 0 on success, -1 if the segment can't be created, -2 if a live daemon already has it or
+//  -3 if it's from an incompatible build. That one is left alone since its daemon may well still be running, with
+//  the layout unknown there's no telling, so it has to be removed by hand once it's stopped
+int8_t rs_service_start(rs_service* s, const char* name, int8_t workers, const int16_t* cpus, int8_t cpu_cnt)
+{
+	if (workers < 1 || workers > RS_SERVICE_MAX_WORKERS)
+		return -1;
+
+	rs_service_path(s->path, sizeof(s->path), name);
+	int fd = shm_open(s->path, O_RDWR | O_CREAT | O_EXCL, 0600);
+	if (fd < 0 && errno == EEXIST)
+	{
+		// left behind by a daemon that didn't get to clean up, or one that's still running
+		rs_service_client old;
+		int8_t r = rs_service_connect(&old, name);
+		if (r == -2)
+			return -3;
+		if (r != -1)
+		{
+			if (old.slot)
+				rs_service_disconnect(&old);
+			return -2;
+		}
+		shm_unlink(s->path);
+		fd = shm_open(s->path, O_RDWR | O_CREAT | O_EXCL, 0600);
+	}
+	if (fd < 0)
+		return -1;
+	if (ftruncate(fd, sizeof(rs_service_shm)))
+	{
+		close(fd);
+		shm_unlink(s->path);
+		return -1;
+	}
+	s->shm = mmap(NULL, sizeof(rs_service_shm), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (s->shm == MAP_FAILED)
+	{
+		shm_unlink(s->path);
+		return -1;
+	}
+
+	// a new segment is all 0 so only the header needs filling in, the pid last so clients never see half of it
+	memcpy(s->shm->magic, RS_SERVICE_MAGIC, sizeof(s->shm->magic));
+	s->shm->version = RS_SERVICE_VERSION;
+	s->shm->size = sizeof(rs_service_shm);
+	__atomic_store_n(&s->shm->daemon_pid, getpid(), __ATOMIC_RELEASE);
+
+	rs_batch_init();
+	s->worker_cnt = workers;
+	s->stop = 0;
+	s->next_slot = 0;
+	memset(s->taken, 0, sizeof(s->taken));
+	pthread_barrier_init(&s->round_start, NULL, workers);
+	pthread_barrier_init(&s->round_end, NULL, workers);
+	for (int8_t w = 0; w < workers; ++w)
+	{
+		s->worker[w] = (rs_service_worker){s, w, cpus ? cpus[w % cpu_cnt] : -1, 0};
+		pthread_create(&s->worker[w].thread, NULL, rs_service_worker_main, &s->worker[w]);
+	}
+
+	return 0;
+}
+
+// finishes whatever has already been submitted, then stops the workers and removes the segment
+void rs_service_stop(rs_service* s)
+{
+	__atomic_store_n(&s->stop, 1, __ATOMIC_RELEASE);
+	__atomic_add_fetch(&s->shm->doorbell, 1, __ATOMIC_SEQ_CST);
+	rs_service_futex_wake(&s->shm->doorbell);
+	for (int8_t w = 0; w < s->worker_cnt; ++w)
+		pthread_join(s->worker[w].thread, NULL);
+
+	pthread_barrier_destroy(&s->round_start);
+	pthread_barrier_destroy(&s->round_end);
+	__atomic_store_n(&s->shm->daemon_pid, 0, __ATOMIC_RELEASE);	// clients still mapped see it gone
+	munmap(s->shm, sizeof(rs_service_shm));
+	shm_unlink(s->path);
+}
+
+// client
+
+// returns 0 on success, -1 if there's no daemon running under name, -2 if it's from an incompatible build
+//  or -3 if every slot is taken
+int8_t rs_service_connect(rs_service_client* c, const char* name)
+{
+	char path[64];
+	struct stat st;
+	c->shm = NULL;
+	c->slot = NULL;
+
+	rs_service_path(path, sizeof(path), name);
+	int fd = shm_open(path, O_RDWR, 0);
+	if (fd < 0)
+		return -1;
+	if (fstat(fd, &st) || st.st_size != sizeof(rs_service_shm))
+	{
+		close(fd);
+		return -2;
+	}
+	rs_service_shm* shm = mmap(NULL, sizeof(rs_service_shm), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (shm == MAP_FAILED)
+		return -1;
+
+	int32_t daemon = __atomic_load_n(&shm->daemon_pid, __ATOMIC_ACQUIRE);
+	int8_t r = 0;
+	if (memcmp(shm->magic, RS_SERVICE_MAGIC, sizeof(shm->magic)) || shm->version != RS_SERVICE_VERSION || shm->size != sizeof(rs_service_shm))
+		r = -2;
+	else if (rs_service_pid_dead(daemon))
+		r = -1;
+	if (r)
+	{
+		munmap(shm, sizeof(rs_service_shm));
+		return r;
+	}
+
+	c->shm = shm;
+	int32_t me = getpid();
+	for (int8_t k = 0; k < RS_SERVICE_CLIENTS && !c->slot; ++k)
+	{
+		rs_service_slot* slot = &shm->slot[k];
+		uint32_t free_slot = 0;
+		int32_t owner = __atomic_load_n(&slot->pid, __ATOMIC_ACQUIRE);
+		if (__atomic_compare_exchange_n(&slot->claimed, &free_slot, 1, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+		{
+			__atomic_store_n(&slot->pid, me, __ATOMIC_RELEASE);
+			c->slot = slot;
+		}
+		else if (owner && rs_service_pid_dead(owner)
+			&& __atomic_compare_exchange_n(&slot->pid, &owner, me, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+			c->slot = slot;	// the owner died without disconnecting
+	}
+
+	return c->slot ? 0 : -3;
+}
+
+// returns 0 once done reaches target or -1 if the daemon went away first
+static int8_t rs_service_wait(rs_service_client* c, uint32_t target)
+{
+	rs_service_slot* slot = c->slot;
+	for (;;)
+	{
+		if (__atomic_load_n(&slot->done, __ATOMIC_ACQUIRE) == target)
+			return 0;
+
+		// same ordering as the daemon's doorbell, waiting is set before done is read for the last time
+		__atomic_store_n(&slot->waiting, 1, __ATOMIC_SEQ_CST);
+		uint32_t done = __atomic_load_n(&slot->done, __ATOMIC_SEQ_CST);
+		if (done == target)
+			return 0;
+		if (rs_service_futex_wait(&slot->done, done, RS_SERVICE_POLL_MS) && errno == ETIMEDOUT
+			&& rs_service_pid_dead(__atomic_load_n(&c->shm->daemon_pid, __ATOMIC_ACQUIRE)))
+			return -1;
+	}
+}
+
+// runs cnt requests through the daemon and waits for all of them, res[i] gets the result of req[i].
+//  Returns 0 on success or -1 if the daemon went away, in which case res is incomplete
+int8_t rs_service_call(rs_service_client* c, const rs_service_req* req, int64_t* res, int32_t cnt)
+{
+	rs_service_slot* slot = c->slot;
+	uint32_t head = slot->head;	// only ever written by this client
+	if (rs_service_wait(c, head))	// anything a dead previous owner of the slot left in flight
+		return -1;
+
+	for (int32_t base = 0; base < cnt; base += RS_SERVICE_RING)
+	{
+		int32_t n = cnt - base < RS_SERVICE_RING ? cnt - base : RS_SERVICE_RING;
+		for (int32_t i = 0; i < n; ++i)
+			slot->req[(head + i) & (RS_SERVICE_RING - 1)] = req[base + i];
+		__atomic_store_n(&slot->head, head + n, __ATOMIC_RELEASE);
+		__atomic_add_fetch(&c->shm->doorbell, 1, __ATOMIC_SEQ_CST);
+		if (__atomic_load_n(&c->shm->sleeping, __ATOMIC_SEQ_CST))
+			rs_service_futex_wake(&c->shm->doorbell);
+
+		if (rs_service_wait(c, head + n))
+			return -1;
+		for (int32_t i = 0; i < n; ++i)
+			res[base + i] = slot->res[(head + i) & (RS_SERVICE_RING - 1)];
+		head += n;
+	}
+
+	return 0;
+}
+
+void rs_service_disconnect(rs_service_client* c)
+{
+	if (c->slot)
+	{
+		__atomic_store_n(&c->slot->pid, 0, __ATOMIC_RELEASE);
+		__atomic_store_n(&c->slot->claimed, 0, __ATOMIC_RELEASE);
+	}
+	if (c->shm)
+		munmap(c->shm, sizeof(rs_service_shm));
+	c->shm = NULL;
+	c->slot = NULL;
+}
@@ -0,0 +1,223 @@
+// precomputed table files, see rs_tables.h
+#include "rs_tables.h"
+#include "gf256.h"
+#include "golay24.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define RS_TABLES_MMAP
+#endif
+
+#define RS_TABLES_ENDIAN 0x01020304
+#define RS_TABLES_FNV_PRIME 0x100000001B3ULL
+#define RS_TABLES_FNV_BASIS 0xCBF29CE484222325ULL
+
+static uint64_t rs_tables_align(uint64_t x)
+{
+	return (x + RS_TABLES_ALIGN - 1) & ~(uint64_t)(RS_TABLES_ALIGN - 1);
+}
+
+// FNV-1a taken 8 bytes at a time instead of 1, only meant to catch truncated or corrupted files, not tampering
+uint64_t rs_tables_checksum(const void* data, uint64_t size)
+{
+	const uint8_t* p = data;
+	uint64_t h = RS_TABLES_FNV_BASIS;
+	uint64_t i = 0;
+	for (; i + 8 <= size; i += 8)
+	{
+		uint64_t w;
+		memcpy(&w, p + i, sizeof(w));
+		h = (h ^ w) * RS_TABLES_FNV_PRIME;
+	}
+	for (; i < size; ++i)
+		h = (h ^ p[i]) * RS_TABLES_FNV_PRIME;
+
+	return h;
+}
+
+// returns 0 on success, -1 if the file couldn't be written
+int8_t rs_tables_write(const char* path, const rs_table_src* src, uint32_t cnt)
+{
+	uint64_t dir_end = sizeof(rs_tables_header) + cnt * sizeof(rs_tables_section);
+	uint64_t file_sz = rs_tables_align(dir_end);
+	for (uint32_t i = 0; i < cnt; ++i)
+		file_sz = rs_tables_align(file_sz + src[i].size);
+
+	uint8_t* buf = calloc(1, file_sz);	// built in memory so the checksum can go in the header before writing
+	if (!buf)
+		return -1;
+
+	rs_tables_header* h = (rs_tables_header*)buf;
+	rs_tables_section* dir = (rs_tables_section*)(buf + sizeof(rs_tables_header));
+	uint64_t offset = rs_tables_align(dir_end);
+	for (uint32_t i = 0; i < cnt; ++i)
+	{
+		dir[i].id = src[i].id;
+		dir[i].param = src[i].param;
+		dir[i].offset = offset;
+		dir[i].size = src[i].size;
+		memcpy(buf + offset, src[i].data, src[i].size);
+		offset = rs_tables_align(offset + src[i].size);
+	}
+
+	memcpy(h->magic, RS_TABLES_MAGIC, sizeof(h->magic));
+	h->version = RS_TABLES_VERSION;
+	h->endian = RS_TABLES_ENDIAN;
+	h->rs8_full_sz = sizeof(rs8_full_table);
+	h->section_cnt = cnt;
+	h->file_sz = file_sz;
+	h->checksum = rs_tables_checksum(buf + sizeof(rs_tables_header), file_sz - sizeof(rs_tables_header));
+
+	FILE* f = fopen(path, "wb");
+	int8_t ok = f && fwrite(buf, 1, file_sz, f) == file_sz;
+	if (f)
+		ok &= fclose(f) == 0;
+	free(buf);
+
+	return ok ? 0 : -1;
+}
+
+// checks everything that doesn't need touching the sections, the checksum is separate since it reads the whole file
+static int8_t rs_tables_valid(const uint8_t* base, uint64_t size)
+{
+	const rs_tables_header* h = (const rs_tables_header*)base;
+	if (size < sizeof(rs_tables_header) || memcmp(h->magic, RS_TABLES_MAGIC, sizeof(h->magic))
+		|| h->version != RS_TABLES_VERSION || h->endian != RS_TABLES_ENDIAN || h->rs8_full_sz != sizeof(rs8_full_table)
+		|| h->file_sz != size || sizeof(rs_tables_header) + (uint64_t)h->section_cnt * sizeof(rs_tables_section) > size)
+		return 0;
+
+	const rs_tables_section* dir = (const rs_tables_section*)(base + sizeof(rs_tables_header));
+	for (uint32_t i = 0; i < h->section_cnt; ++i)
+	{
+		if (dir[i].offset % RS_TABLES_ALIGN || dir[i].offset > size || dir[i].size > size - dir[i].offset)
+			return 0;
+	}
+
+	return 1;
+}
+
+// maps the file read-only where mmap is available and reads it into memory otherwise. verify also checks the
+//  checksum, which costs a read of every page up front. Returns 0 on success, -1 if the file can't be opened
+//  and -2 if it isn't a valid table file for this build
+int8_t rs_tables_open(rs_tables* t, const char* path, int8_t verify)
+{
+	t->base = NULL;
+	t->size = 0;
+	t->mapped = 0;
+
+#ifdef RS_TABLES_MMAP
+	int fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return -1;
+	struct stat st;
+	if (fstat(fd, &st) || st.st_size < (off_t)sizeof(rs_tables_header))
+	{
+		close(fd);
+		return -2;
+	}
+	void* p = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);	// the mapping keeps its own reference
+	if (p == MAP_FAILED)
+		return -1;
+	t->base = p;
+	t->size = st.st_size;
+	t->mapped = 1;
+#else
+	FILE* f = fopen(path, "rb");
+	if (!f)
+		return -1;
+	fseek(f, 0, SEEK_END);
+	long sz = ftell(f);
+	fseek(f, 0, SEEK_SET);
+	uint8_t* p = sz > 0 ? malloc(sz) : NULL;
+	if (!p || fread(p, 1, sz, f) != (size_t)sz)
+	{
+		free(p);
+		fclose(f);
+		return -2;
+	}
+	fclose(f);
+	t->base = p;
+	t->size = sz;
+#endif
+
+	const rs_tables_header* h = (const rs_tables_header*)t->base;
+	if (!rs_tables_valid(t->base, t->size)
+		|| (verify && rs_tables_checksum(t->base + sizeof(rs_tables_header), t->size - sizeof(rs_tables_header)) != h->checksum))
+	{
+		rs_tables_close(t);
+		return -2;
+	}
+
+	return 0;
+}
+
+void rs_tables_close(rs_tables* t)
+{
+	if (!t->base)
+		return;
+#ifdef RS_TABLES_MMAP
+	if (t->mapped)
+		munmap((void*)t->base, t->size);
+	else
+#endif
+		free((void*)t->base);
+	t->base = NULL;
+	t->size = 0;
+}
+
+// NULL if there's no such section, size (if not NULL) gets its size in bytes
+const void* rs_tables_find(const rs_tables* t, rs_table_id id, uint32_t param, uint64_t* size)
+{
+	const rs_tables_header* h = (const rs_tables_header*)t->base;
+	const rs_tables_section* dir = (const rs_tables_section*)(t->base + sizeof(rs_tables_header));
+	for (uint32_t i = 0; i < h->section_cnt; ++i)
+	{
+		if (dir[i].id == (uint32_t)id && dir[i].param == param)
+		{
+			if (size)
+				*size = dir[i].size;
+			return t->base + dir[i].offset;
+		}
+	}
+
+	return NULL;
+}
+
+// copies the GF(256) split nibble tables out of the file in place of gf256_init(), -1 if it doesn't have them. Like
+//  gf256_init() it only does anything the first time, so a later gf256_init() keeps the loaded tables
+int8_t rs_tables_load_gf256(const rs_tables* t)
+{
+	uint64_t size;
+	const uint8_t* p = rs_tables_find(t, RS_TABLE_GF256_MUL, 0, &size);
+	if (!p || size != sizeof(gf256_mul_lo) + sizeof(gf256_mul_hi))
+		return -1;
+
+	gf256_init_from(p);
+	return 0;
+}
+
+// same for golay24_init()
+int8_t rs_tables_load_golay24(const rs_tables* t)
+{
+	uint64_t size;
+	const uint8_t* p = rs_tables_find(t, RS_TABLE_GOLAY24, 0, &size);
+	if (!p || size != sizeof(golay24_chk) + sizeof(golay24_errata))
+		return -1;
+
+	golay24_init_from(p);
+	return 0;
+}
+
+// the table used straight out of the mapping, NULL if the file doesn't have one for this chk_syms and tx_pos
+const rs8_full_table* rs_tables_rs8_full(const rs_tables* t, int8_t chk_syms, int8_t tx_pos)
+{
+	uint64_t size;
+	const rs8_full_table* p = rs_tables_find(t, RS_TABLE_RS8_FULL, (uint8_t)chk_syms | (uint32_t)(uint8_t)tx_pos << 8, &size);
+	return (p && size == sizeof(rs8_full_table)) ? p : NULL;
+}
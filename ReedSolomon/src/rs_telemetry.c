@@ -0,0 +1,92 @@
+// decode outcome counters, see rs_telemetry.h
+//
+// same layout as rs_profile.c, a block per thread on a lock-free list that's never freed. Only the owning thread
+//  writes its block so the increments are plain relaxed load + store with no lock prefix, the atomics are only there
+//  so a snapshot taken from another thread reads whole values
+#include "rs_telemetry.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define RS_TELEM_LINE 64	// cache line size, blocks are aligned and padded to it to keep threads off each other's lines
+
+typedef struct rs_telem_thread
+{
+	rs_telem_counts code[RS_TELEM_CODES];
+	struct rs_telem_thread* next;
+} rs_telem_thread;
+
+#define RS_TELEM_COUNTERS (RS_TELEM_CODES * sizeof(rs_telem_counts) / sizeof(uint64_t))	// all of them are uint64
+#define RS_TELEM_BLOCK_SZ ((sizeof(rs_telem_thread) + RS_TELEM_LINE - 1) / RS_TELEM_LINE * RS_TELEM_LINE)
+
+static rs_telem_thread* rs_telem_threads = NULL;
+static _Thread_local rs_telem_thread* rs_telem_local = NULL;
+
+static const char* const rs_telem_outcome_names[RS_OUT_CNT] = {
+	"clean", "corrected", "erase_overflow", "bm_order", "root_mismatch"
+};
+
+static rs_telem_thread* rs_telemetry_register(void)
+{
+	rs_telem_thread* t = aligned_alloc(RS_TELEM_LINE, RS_TELEM_BLOCK_SZ);
+	if (!t)
+		return NULL;
+	memset(t, 0, RS_TELEM_BLOCK_SZ);
+
+	t->next = __atomic_load_n(&rs_telem_threads, __ATOMIC_RELAXED);
+	while (!__atomic_compare_exchange_n(&rs_telem_threads, &t->next, t, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+		;	// t->next gets refreshed with the current head on failure
+
+	return t;
+}
+
+static void rs_telem_inc(uint64_t* counter)
+{
+	__atomic_store_n(counter, __atomic_load_n(counter, __ATOMIC_RELAXED) + 1, __ATOMIC_RELAXED);
+}
+
+void rs_telemetry_record(rs_telem_code code, rs_telem_outcome outcome, int8_t errors, int8_t erasures)
+{
+	if (!rs_telem_local)
+	{
+		rs_telem_local = rs_telemetry_register();
+		if (!rs_telem_local)
+			return;	// out of memory, drops the count rather than failing the decode
+	}
+
+	rs_telem_counts* c = &rs_telem_local->code[code];
+	rs_telem_inc(&c->decodes);
+	rs_telem_inc(&c->outcome[outcome]);
+	if (outcome == RS_OUT_CORRECTED)
+	{
+		rs_telem_inc(&c->errors[errors & (RS_TELEM_MAX_CNT - 1)]);
+		rs_telem_inc(&c->erasures[erasures & (RS_TELEM_MAX_CNT - 1)]);
+	}
+}
+
+void rs_telemetry_snapshot_get(rs_telemetry_snapshot* snap)
+{
+	memset(snap, 0, sizeof(*snap));
+	for (rs_telem_thread* t = __atomic_load_n(&rs_telem_threads, __ATOMIC_ACQUIRE); t; t = t->next)
+	{
+		uint64_t* src = (uint64_t*)t->code;
+		uint64_t* dst = (uint64_t*)snap->code;
+		for (size_t i = 0; i < RS_TELEM_COUNTERS; ++i)
+			dst[i] += __atomic_load_n(&src[i], __ATOMIC_RELAXED);
+	}
+}
+
+// meant to be called between runs, a thread counting at the same moment can lose or keep that one decode
+void rs_telemetry_reset(void)
+{
+	for (rs_telem_thread* t = __atomic_load_n(&rs_telem_threads, __ATOMIC_ACQUIRE); t; t = t->next)
+	{
+		uint64_t* counters = (uint64_t*)t->code;
+		for (size_t i = 0; i < RS_TELEM_COUNTERS; ++i)
+			__atomic_store_n(&counters[i], 0, __ATOMIC_RELAXED);
+	}
+}
+
+const char* rs_telemetry_outcome_name(rs_telem_outcome outcome)
+{
+	return (outcome >= 0 && outcome < RS_OUT_CNT) ? rs_telem_outcome_names[outcome] : "unknown";
+}
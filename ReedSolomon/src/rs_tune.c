@@ -0,0 +1,391 @@
+// per host choice of encode and syndrome implementations for every rs8 and rs16 shape, see rs_tune.h
+#include "rs_tune.h"
+#include "rs_gf8.h"
+#include "rs_gf16.h"
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+#define RS_TUNE_INPUTS 2048	// words per timing round, same ones for every variant of a shape
+#define RS_TUNE_ROUNDS 7	// the fastest round counts, slower ones are other things getting in the way
+
+rs_tune_choice rs8_tune[1 + GF8_MAX];
+rs_tune_choice rs16_tune[1 + GF16_MAX];
+
+// check symbols of data value v in data term j for each chk_syms, and every rs8 syndrome of value v in term i. The
+//  rs16 syndromes use the shared rs16_synd_lut
+static gf8_poly rs8_enc_tab[1 + GF8_MAX][GF8_MAX][1 + GF8_MAX];
+static gf16_poly rs16_enc_tab[1 + GF16_MAX][GF16_MAX][1 + GF16_MAX];
+static gf8_poly rs8_synd_tab[GF8_MAX][1 + GF8_MAX];
+static pthread_once_t rs_tune_tables_once = PTHREAD_ONCE_INIT;
+
+static const char* const rs_tune_enc_names[RS_TUNE_ENC_CNT] = {"mod", "table"};
+static const char* const rs_tune_synd_names[RS_TUNE_SYND_CNT] = {"horner", "mod", "table"};
+
+// the variants, all with the same signatures as the plain library calls so they can sit in the same tables
+
+static gf8_poly rs8_encode_table(gf8_poly raw, int8_t chk_syms)
+{
+	gf8_idx chk_sz = chk_syms * GF8_SYM_SZ;
+	raw &= ((1 << GF8_MAX * GF8_SYM_SZ) - 1) >> chk_sz;	// same truncation as rs8_encode_systematic()
+	gf8_poly chk = 0;
+	int8_t j = 0;
+	for (gf8_poly w = raw; w; w >>= GF8_SYM_SZ, ++j)
+		chk ^= rs8_enc_tab[chk_syms][j][w & GF8_MAX];
+
+	return (raw << chk_sz) | chk;
+}
+
+static gf16_poly rs16_encode_table(gf16_poly raw, int8_t chk_syms)
+{
+	gf16_idx chk_sz = chk_syms * GF16_SYM_SZ;
+	raw &= ((1LL << GF16_MAX * GF16_SYM_SZ) - 1) >> chk_sz;
+	gf16_poly chk = 0;
+	int8_t j = 0;
+	for (gf16_poly w = raw; w; w >>= GF16_SYM_SZ, ++j)
+		chk ^= rs16_enc_tab[chk_syms][j][w & GF16_MAX];
+
+	return (raw << chk_sz) | chk;
+}
+
+// same order as rs8_get_syndromes(), only the evaluation is pinned down instead of following the build
+static gf8_poly rs8_synd_horner(gf8_poly p, gf8_idx p_sz, int8_t nsyms)
+{
+	gf8_poly synd = 0;
+	for (; nsyms > 0; --nsyms)
+		synd = (synd << GF8_SYM_SZ) | gf8_poly_eval_horner(p, p_sz, gf8_2pow(nsyms));
+
+	return synd;
+}
+
+static gf8_poly rs8_synd_mod(gf8_poly p, gf8_idx p_sz, int8_t nsyms)
+{
+	gf8_poly synd = 0;
+	for (; nsyms > 0; --nsyms)
+		synd = (synd << GF8_SYM_SZ) | gf8_poly_eval_mod(p, p_sz, gf8_2pow(nsyms));
+
+	return synd;
+}
+
+// terms above p_sz are ignored same as by the evaluating versions, which also keeps the loop inside the table
+static gf8_poly rs8_synd_table(gf8_poly p, gf8_idx p_sz, int8_t nsyms)
+{
+	gf8_poly synd = 0;
+	p &= ((1 << GF8_MAX * GF8_SYM_SZ) - 1) >> (GF8_MAX * GF8_SYM_SZ - p_sz);
+	for (int8_t i = 0; p; p >>= GF8_SYM_SZ, ++i)
+		synd ^= rs8_synd_tab[i][p & GF8_MAX];
+
+	return synd & ((1 << nsyms * GF8_SYM_SZ) - 1);
+}
+
+static gf16_poly rs16_synd_horner(gf16_poly p, gf16_idx p_sz, int8_t nsyms)
+{
+	gf16_poly synd = 0;
+	for (; nsyms > 0; --nsyms)
+		synd = (synd << GF16_SYM_SZ) | gf16_poly_eval_horner(p, p_sz, gf16_2pow(nsyms));
+
+	return synd;
+}
+
+static gf16_poly rs16_synd_mod(gf16_poly p, gf16_idx p_sz, int8_t nsyms)
+{
+	gf16_poly synd = 0;
+	for (; nsyms > 0; --nsyms)
+		synd = (synd << GF16_SYM_SZ) | gf16_poly_eval_mod(p, p_sz, gf16_2pow(nsyms));
+
+	return synd;
+}
+
+typedef gf8_poly (*rs8_enc_fn)(gf8_poly raw, int8_t chk_syms);
+typedef gf8_poly (*rs8_synd_fn)(gf8_poly p, gf8_idx p_sz, int8_t nsyms);
+typedef gf16_poly (*rs16_enc_fn)(gf16_poly raw, int8_t chk_syms);
+typedef gf16_poly (*rs16_synd_fn)(gf16_poly p, gf16_idx p_sz, int8_t nsyms);
+
+static const rs8_enc_fn rs8_enc_fns[RS_TUNE_ENC_CNT] = {rs8_encode_systematic, rs8_encode_table};
+static const rs8_synd_fn rs8_synd_fns[RS_TUNE_SYND_CNT] = {rs8_synd_horner, rs8_synd_mod, rs8_synd_table};
+static const rs16_enc_fn rs16_enc_fns[RS_TUNE_ENC_CNT] = {rs16_encode_systematic, rs16_encode_table};
+static const rs16_synd_fn rs16_synd_fns[RS_TUNE_SYND_CNT] = {rs16_synd_horner, rs16_synd_mod, rs16_get_syndromes_table};
+
+// the choices the untuned library makes, poly_mod for encoding and Horner for the syndromes unless built with
+//  the EVAL_MOD variant
+static void rs_tune_defaults(void)
+{
+	for (int8_t c = 0; c <= GF8_MAX; ++c)
+	{
+#ifdef GF8_EVAL_MOD
+		rs8_tune[c] = (rs_tune_choice){RS_TUNE_ENC_MOD, RS_TUNE_SYND_MOD};
+#else
+		rs8_tune[c] = (rs_tune_choice){RS_TUNE_ENC_MOD, RS_TUNE_SYND_HORNER};
+#endif
+	}
+	for (int8_t c = 0; c <= GF16_MAX; ++c)
+	{
+#ifdef GF16_EVAL_MOD
+		rs16_tune[c] = (rs_tune_choice){RS_TUNE_ENC_MOD, RS_TUNE_SYND_MOD};
+#else
+		rs16_tune[c] = (rs_tune_choice){RS_TUNE_ENC_MOD, RS_TUNE_SYND_HORNER};
+#endif
+	}
+}
+
+static void rs_tune_build(void)
+{
+	for (int8_t c = 1; c < GF8_MAX; ++c)
+	{
+		for (int8_t j = 0; j < GF8_MAX - c; ++j)
+		{
+			for (int8_t v = 0; v <= GF8_MAX; ++v)
+				rs8_enc_tab[c][j][v] = rs8_encode_systematic((gf8_poly)v << (j * GF8_SYM_SZ), c) & ((1 << c * GF8_SYM_SZ) - 1);
+		}
+	}
+	for (int8_t c = 1; c < GF16_MAX; ++c)
+	{
+		for (int8_t j = 0; j < GF16_MAX - c; ++j)
+		{
+			for (int8_t v = 0; v <= GF16_MAX; ++v)
+				rs16_enc_tab[c][j][v] = rs16_encode_systematic((gf16_poly)v << (j * GF16_SYM_SZ), c) & ((1LL << c * GF16_SYM_SZ) - 1);
+		}
+	}
+	// a lone symbol v in term i evaluates to v * 2^(i * s) for syndrome s
+	for (int8_t i = 0; i < GF8_MAX; ++i)
+	{
+		for (int8_t v = 0; v <= GF8_MAX; ++v)
+			rs8_synd_tab[i][v] = rs8_synd_horner((gf8_poly)v << (i * GF8_SYM_SZ), GF8_MAX * GF8_SYM_SZ, GF8_MAX);
+	}
+	rs16_synd_lut_init();
+}
+
+// builds the tables and resets every choice to the defaults, then loads the profile at path if there is one.
+//  Returns 0 if it was loaded or path is NULL, otherwise what rs_tune_load() returned with the defaults kept
+int8_t rs_tune_init(const char* path)
+{
+	pthread_once(&rs_tune_tables_once, rs_tune_build);
+	rs_tune_defaults();
+	return path ? rs_tune_load(path) : 0;
+}
+
+// the tuned calls, same arguments and results as the plain ones
+
+gf8_poly rs8_tuned_encode(gf8_poly raw, int8_t chk_syms)
+{
+	return rs8_enc_fns[rs8_tune[chk_syms].enc](raw, chk_syms);
+}
+
+gf8_poly rs8_tuned_get_syndromes(gf8_poly recv, gf8_idx r_sz, int8_t chk_syms)
+{
+	return rs8_synd_fns[rs8_tune[chk_syms].synd](recv, r_sz, chk_syms);
+}
+
+gf8_poly rs8_tuned_get_errata(gf8_poly recv, gf8_idx r_sz, int8_t chk_syms, int8_t e_pos, int8_t tx_pos)
+{
+	return rs8_get_errata_synd(rs8_tuned_get_syndromes(recv, r_sz, chk_syms), chk_syms, e_pos, tx_pos);
+}
+
+gf8_poly rs8_tuned_decode(gf8_poly recv, gf8_idx r_sz, int8_t chk_syms, int8_t e_pos, int8_t tx_pos)
+{
+	return (recv ^ rs8_tuned_get_errata(recv, r_sz, chk_syms, e_pos, tx_pos)) >> chk_syms * GF8_SYM_SZ;
+}
+
+gf16_poly rs16_tuned_encode(gf16_poly raw, int8_t chk_syms)
+{
+	return rs16_enc_fns[rs16_tune[chk_syms].enc](raw, chk_syms);
+}
+
+gf16_poly rs16_tuned_get_syndromes(gf16_poly recv, gf16_idx r_sz, int8_t chk_syms)
+{
+	return rs16_synd_fns[rs16_tune[chk_syms].synd](recv, r_sz, chk_syms);
+}
+
+gf16_poly rs16_tuned_get_errata(gf16_poly recv, gf16_idx r_sz, int8_t chk_syms, int16_t e_pos, int16_t tx_pos)
+{
+	return rs16_get_errata_synd(rs16_tuned_get_syndromes(recv, r_sz, chk_syms), chk_syms, e_pos, tx_pos);
+}
+
+gf16_poly rs16_tuned_decode(gf16_poly recv, gf16_idx r_sz, int8_t chk_syms, int16_t e_pos, int16_t tx_pos)
+{
+	return (recv ^ rs16_tuned_get_errata(recv, r_sz, chk_syms, e_pos, tx_pos)) >> chk_syms * GF16_SYM_SZ;
+}
+
+// timing
+
+static int64_t rs_tune_in[RS_TUNE_INPUTS];
+static int64_t rs_tune_ref[RS_TUNE_INPUTS];
+static volatile int64_t rs_tune_sink;	// keeps results alive without the compiler being able to drop the calls
+static uint64_t rs_tune_rng = 0x5EED5EED5EED5EEDULL;
+
+// xorshift64*, fixed seed so reruns time the same inputs
+static uint64_t rs_tune_rand(void)
+{
+	rs_tune_rng ^= rs_tune_rng >> 12;
+	rs_tune_rng ^= rs_tune_rng << 25;
+	rs_tune_rng ^= rs_tune_rng >> 27;
+	return rs_tune_rng * 0x2545F4914F6CDD1DULL;
+}
+
+static int64_t rs_tune_now(void)
+{
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (int64_t)t.tv_sec * 1000000000 + t.tv_nsec;
+}
+
+// ns per call of the fastest round, or -1 if the variant doesn't give the same results as the plain library call,
+//  which would be a bug but shouldn't ever get it picked either way. code is 8 or 16 and stage 0 for encode
+static double rs_tune_time(int8_t code, int8_t stage, int8_t variant, int8_t chk_syms)
+{
+	double best = -1;
+	for (int8_t round = -1; round < RS_TUNE_ROUNDS; ++round)	// round -1 warms up and checks the results
+	{
+		int64_t start = rs_tune_now();
+		for (int32_t i = 0; i < RS_TUNE_INPUTS; ++i)
+		{
+			int64_t r;
+			if (code == 8)
+				r = stage ? rs8_synd_fns[variant](rs_tune_in[i], GF8_MAX * GF8_SYM_SZ, chk_syms) : rs8_enc_fns[variant](rs_tune_in[i], chk_syms);
+			else
+				r = stage ? rs16_synd_fns[variant](rs_tune_in[i], GF16_MAX * GF16_SYM_SZ, chk_syms) : rs16_enc_fns[variant](rs_tune_in[i], chk_syms);
+			if (round < 0 && r != rs_tune_ref[i])
+				return -1;
+			rs_tune_sink = r;
+		}
+		double ns = (double)(rs_tune_now() - start) / RS_TUNE_INPUTS;
+		if (round >= 0 && (best < 0 || ns < best))
+			best = ns;
+	}
+	return best;
+}
+
+// times every variant of one stage for one shape on the inputs already in rs_tune_in and returns the fastest
+static int8_t rs_tune_stage(FILE* log, int8_t code, int8_t stage, int8_t chk_syms)
+{
+	int8_t cnt = stage ? RS_TUNE_SYND_CNT : RS_TUNE_ENC_CNT;
+	const char* const* names = stage ? rs_tune_synd_names : rs_tune_enc_names;
+	int8_t best = 0;
+	double best_ns = -1;
+
+	for (int32_t i = 0; i < RS_TUNE_INPUTS; ++i)	// the plain library call is the reference
+	{
+		if (code == 8)
+			rs_tune_ref[i] = stage ? rs8_get_syndromes(rs_tune_in[i], GF8_MAX * GF8_SYM_SZ, chk_syms) : rs8_encode_systematic(rs_tune_in[i], chk_syms);
+		else
+			rs_tune_ref[i] = stage ? rs16_get_syndromes(rs_tune_in[i], GF16_MAX * GF16_SYM_SZ, chk_syms) : rs16_encode_systematic(rs_tune_in[i], chk_syms);
+	}
+
+	if (log)
+		fprintf(log, "rs%-2d chk %2d %-6s", code, chk_syms, stage ? "synd" : "encode");
+	for (int8_t v = 0; v < cnt; ++v)
+	{
+		double ns = rs_tune_time(code, stage, v, chk_syms);
+		if (log)
+			fprintf(log, "  %s %7.2f", names[v], ns);
+		if (ns >= 0 && (best_ns < 0 || ns < best_ns))
+		{
+			best = v;
+			best_ns = ns;
+		}
+	}
+	if (log)
+		fprintf(log, "  -> %s\n", names[best]);
+
+	return best;
+}
+
+// times both stages of every shape and keeps the fastest of each, log gets a line of ns per call for each stage
+//  and can be NULL. Encoding is timed on random data and the syndromes on code words with a random error in half
+//  of them, the error doesn't change the work done but keeps the results from being all 0
+void rs_tune_run(FILE* log)
+{
+	pthread_once(&rs_tune_tables_once, rs_tune_build);
+	for (int8_t code = 8; code <= 16; code += 8)
+	{
+		int8_t n = code == 8 ? GF8_MAX : GF16_MAX;
+		int8_t sym_sz = code == 8 ? GF8_SYM_SZ : GF16_SYM_SZ;
+		for (int8_t c = 1; c < n; ++c)
+		{
+			int64_t data_mask = ((int64_t)1 << (n - c) * sym_sz) - 1;
+			for (int32_t i = 0; i < RS_TUNE_INPUTS; ++i)
+				rs_tune_in[i] = rs_tune_rand() & data_mask;
+			int8_t enc = rs_tune_stage(log, code, 0, c);
+
+			for (int32_t i = 0; i < RS_TUNE_INPUTS; ++i)
+			{
+				int64_t cw = code == 8 ? rs8_encode_systematic(rs_tune_in[i], c) : rs16_encode_systematic(rs_tune_in[i], c);
+				if (rs_tune_rand() & 1)
+					cw ^= (int64_t)(1 + rs_tune_rand() % n) << (rs_tune_rand() % n * sym_sz);
+				rs_tune_in[i] = cw;
+			}
+			int8_t synd = rs_tune_stage(log, code, 1, c);
+
+			if (code == 8)
+				rs8_tune[c] = (rs_tune_choice){enc, synd};
+			else
+				rs16_tune[c] = (rs_tune_choice){enc, synd};
+		}
+	}
+}
+
+// a line per shape after the header, eg "rs16 4 table table", returns 0 on success or -1 if it can't be written
+int8_t rs_tune_save(const char* path)
+{
+	FILE* f = fopen(path, "w");
+	if (!f)
+		return -1;
+
+	fprintf(f, "%s %d\n", RS_TUNE_MAGIC, RS_TUNE_VERSION);
+	for (int8_t c = 1; c < GF8_MAX; ++c)
+		fprintf(f, "rs8 %d %s %s\n", c, rs_tune_enc_names[rs8_tune[c].enc], rs_tune_synd_names[rs8_tune[c].synd]);
+	for (int8_t c = 1; c < GF16_MAX; ++c)
+		fprintf(f, "rs16 %d %s %s\n", c, rs_tune_enc_names[rs16_tune[c].enc], rs_tune_synd_names[rs16_tune[c].synd]);
+
+	return fclose(f) ? -1 : 0;
+}
+
+static int8_t rs_tune_find(const char* const* names, int8_t cnt, const char* name)
+{
+	for (int8_t i = 0; i < cnt; ++i)
+	{
+		if (!strcmp(names[i], name))
+			return i;
+	}
+	return -1;
+}
+
+// returns 0 on success, -1 if the file can't be opened or -2 if it isn't a valid profile, in which case nothing
+//  changes. Shapes the file doesn't mention keep their current choice. Builds the tables itself if rs_tune_init()
+//  hasn't, since the profile can pick the table variants
+int8_t rs_tune_load(const char* path)
+{
+	pthread_once(&rs_tune_tables_once, rs_tune_build);
+
+	FILE* f = fopen(path, "r");
+	if (!f)
+		return -1;
+
+	rs_tune_choice t8[1 + GF8_MAX], t16[1 + GF16_MAX];
+	memcpy(t8, rs8_tune, sizeof(t8));
+	memcpy(t16, rs16_tune, sizeof(t16));
+
+	char magic[16], code[8], enc[16], synd[16];
+	int version, chk, fields;
+	int8_t ok = fscanf(f, "%15s %d", magic, &version) == 2 && !strcmp(magic, RS_TUNE_MAGIC) && version == RS_TUNE_VERSION;
+	while (ok && (fields = fscanf(f, "%7s %d %15s %15s", code, &chk, enc, synd)) != EOF)
+	{
+		int8_t e = rs_tune_find(rs_tune_enc_names, RS_TUNE_ENC_CNT, enc);
+		int8_t s = rs_tune_find(rs_tune_synd_names, RS_TUNE_SYND_CNT, synd);
+		if (fields != 4 || e < 0 || s < 0)
+			ok = 0;
+		else if (!strcmp(code, "rs8") && chk >= 1 && chk < GF8_MAX)
+			t8[chk] = (rs_tune_choice){e, s};
+		else if (!strcmp(code, "rs16") && chk >= 1 && chk < GF16_MAX)
+			t16[chk] = (rs_tune_choice){e, s};
+		else
+			ok = 0;
+	}
+	fclose(f);
+
+	if (!ok)
+		return -2;
+	memcpy(rs8_tune, t8, sizeof(t8));
+	memcpy(rs16_tune, t16, sizeof(t16));
+	return 0;
+}
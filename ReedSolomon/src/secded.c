@@ -0,0 +1,286 @@
+// extended Hamming SECDED codes, see secded.h
+#include "secded.h"
+#include <string.h>
+
+#if defined(__AVX2__) || defined(__AVX512VPOPCNTDQ__)
+#include <immintrin.h>
+#endif
+
+// every data bit outside of the other masks, its parity is the overall parity bit (see secded64_get_chk_x4())
+#define SECDED64_OVERALL_MASK ~(secded_masks[0] ^ secded_masks[1] ^ secded_masks[2] ^ secded_masks[3] \
+	^ secded_masks[4] ^ secded_masks[5] ^ secded_masks[6])
+
+// data bit i sits at the i-th Hamming code word position that isn't a power of 2, positions 3, 5, 6, 7, 9, ...
+const uint64_t secded_masks[SECDED64_CHK_BITS] = {
+	0xAB55555556AAAD5B,
+	0xCD9999999B33366D,
+	0xF1E1E1E1E3C3C78E,
+	0x01FE01FE03FC07F0,
+	0x01FFFE0003FFF800,
+	0x01FFFFFFFC000000,
+	0xFE00000000000000
+};
+
+// Hamming check bits with the overall parity bit above them
+static uint8_t secded_get_chk(uint64_t data, int8_t chk_bits)
+{
+	uint8_t chk = 0;
+	for (int8_t j = 0; j < chk_bits; ++j)
+		chk |= __builtin_parityll(data & secded_masks[j]) << j;
+	chk |= (__builtin_parityll(data) ^ __builtin_parity(chk)) << chk_bits;
+
+	return chk;
+}
+
+uint8_t secded64_get_chk(uint64_t data)
+{
+	return secded_get_chk(data, SECDED64_CHK_BITS);
+}
+
+uint8_t secded32_get_chk(uint32_t data)
+{
+	return secded_get_chk(data, SECDED32_CHK_BITS);
+}
+
+// the syndrome is the Hamming position of a single bit error, which is a check bit when it's a power of 2 and
+//  otherwise data bit s - (check bits below s) - 1. A wrong overall parity means an odd number of errors so a
+//  single one, right parity with a nonzero syndrome means 2
+static int8_t secded_correct(uint64_t* data, uint8_t* chk, int8_t chk_bits, int8_t data_bits)
+{
+	uint8_t diff = secded_get_chk(*data, chk_bits) ^ *chk;
+	uint8_t synd = diff & ((1 << chk_bits) - 1);
+	int8_t odd = __builtin_parity(diff);	// works out to the parity of the whole received code word
+
+	if (!diff)
+		return SECDED_CLEAN;
+	if (!odd)
+		return SECDED_DOUBLE;
+
+	if (!synd)
+		*chk ^= 1 << chk_bits;	// the overall parity bit itself
+	else if (!(synd & (synd - 1)))
+		*chk ^= synd;			// one of the check bits
+	else
+	{
+		int8_t bit = synd - (31 - __builtin_clz(synd)) - 2;
+		if (bit >= data_bits)
+			return SECDED_DOUBLE;	// points past the end of the (shortened) code word, can't be a single error
+		*data ^= 1ULL << bit;
+	}
+
+	return SECDED_CORRECTED;
+}
+
+int8_t secded64_decode(uint64_t* data, uint8_t* chk)
+{
+	return secded_correct(data, chk, SECDED64_CHK_BITS, 64);
+}
+
+int8_t secded32_decode(uint32_t* data, uint8_t* chk)
+{
+	uint64_t d = *data;
+	int8_t status = secded_correct(&d, chk, SECDED32_CHK_BITS, 32);
+	*data = d;
+	return status;
+}
+
+#if defined(__AVX2__)
+// check bytes of 4 words at once, packed into the 4 bytes of the return value
+//
+// the 7 masked copies of each word and an 8th for the overall parity get folded in halves, but instead of each
+//  fold throwing away half the vector the folds of 2 masks are blended into the halves of 1, so after 3 rounds
+//  byte b of each lane holds mask b folded down to 8 bits. 3 more folds leave each byte's parity in its bit 0
+//  and movemask collects them into exactly the check bytes. The overall parity needs no separate pass since the
+//  parity of the data xor the parities of the check bits is the parity of the data masked by the complement of
+//  all the other masks xored together
+static inline uint32_t secded64_get_chk_x4(__m256i data)
+{
+#define SECDED_MASK(j) _mm256_and_si256(data, _mm256_set1_epi64x(secded_masks[j]))
+#define SECDED_FOLD_PAIR(lo, hi, bits, blend) _mm256_blend_epi##bits(_mm256_xor_si256(lo, _mm256_srli_epi64(lo, bits)), \
+	_mm256_xor_si256(hi, _mm256_slli_epi64(hi, bits)), blend)
+	__m256i all = _mm256_and_si256(data, _mm256_set1_epi64x(SECDED64_OVERALL_MASK));
+
+	// 64 to 32 bits, mask j in the low half and j + 4 in the high half
+	__m256i m04 = SECDED_FOLD_PAIR(SECDED_MASK(0), SECDED_MASK(4), 32, 0xAA);
+	__m256i m15 = SECDED_FOLD_PAIR(SECDED_MASK(1), SECDED_MASK(5), 32, 0xAA);
+	__m256i m26 = SECDED_FOLD_PAIR(SECDED_MASK(2), SECDED_MASK(6), 32, 0xAA);
+	__m256i m37 = SECDED_FOLD_PAIR(SECDED_MASK(3), all, 32, 0xAA);
+	// 32 to 16
+	__m256i m0246 = SECDED_FOLD_PAIR(m04, m26, 16, 0xAA);
+	__m256i m1357 = SECDED_FOLD_PAIR(m15, m37, 16, 0xAA);
+	// 16 to 8, no byte blend with an immediate so it's masked instead
+	const __m256i hi_bytes = _mm256_set1_epi16((int16_t)0xFF00);
+	__m256i v = _mm256_or_si256(_mm256_andnot_si256(hi_bytes, _mm256_xor_si256(m0246, _mm256_srli_epi64(m0246, 8))),
+		_mm256_and_si256(hi_bytes, _mm256_xor_si256(m1357, _mm256_slli_epi64(m1357, 8))));
+#undef SECDED_MASK
+#undef SECDED_FOLD_PAIR
+
+	v = _mm256_xor_si256(v, _mm256_srli_epi16(v, 4));	// bits from the next byte up only land in the top bits
+	v = _mm256_xor_si256(v, _mm256_srli_epi16(v, 2));
+	v = _mm256_xor_si256(v, _mm256_srli_epi16(v, 1));
+	return _mm256_movemask_epi8(_mm256_slli_epi16(v, 7));
+}
+#endif
+
+#if defined(__AVX512VPOPCNTDQ__) && defined(__AVX512F__)
+// check bytes of 8 words at once, with a real popcount per lane it's just the masked parities shifted into place
+static inline uint64_t secded64_get_chk_x8(__m512i data)
+{
+	__m512i chk = _mm512_setzero_si512();
+#define SECDED_BIT(j, mask) chk = _mm512_ternarylogic_epi64(chk, _mm512_slli_epi64(_mm512_popcnt_epi64(	\
+	_mm512_and_si512(data, _mm512_set1_epi64(mask))), j), _mm512_set1_epi64(1 << j), 0xF8)	// chk | (parity << j)
+	SECDED_BIT(0, secded_masks[0]);
+	SECDED_BIT(1, secded_masks[1]);
+	SECDED_BIT(2, secded_masks[2]);
+	SECDED_BIT(3, secded_masks[3]);
+	SECDED_BIT(4, secded_masks[4]);
+	SECDED_BIT(5, secded_masks[5]);
+	SECDED_BIT(6, secded_masks[6]);
+	SECDED_BIT(7, SECDED64_OVERALL_MASK);
+#undef SECDED_BIT
+	return _mm_cvtsi128_si64(_mm512_cvtepi64_epi8(chk));
+}
+#endif
+
+void secded64_encode_batch(const uint64_t* data, uint8_t* chk, int32_t n)
+{
+	int32_t i = 0;
+#if defined(__AVX512VPOPCNTDQ__) && defined(__AVX512F__)
+	for (; i + 8 <= n; i += 8)
+	{
+		uint64_t packed = secded64_get_chk_x8(_mm512_loadu_si512((const void*)(data + i)));
+		memcpy(chk + i, &packed, sizeof(packed));
+	}
+#endif
+#if defined(__AVX2__)
+	for (; i + 4 <= n; i += 4)
+	{
+		uint32_t packed = secded64_get_chk_x4(_mm256_loadu_si256((const __m256i*)(data + i)));
+		memcpy(chk + i, &packed, sizeof(packed));
+	}
+#endif
+	for (; i < n; ++i)
+		chk[i] = secded64_get_chk(data[i]);
+}
+
+// marks word i in whichever bitmap its outcome calls for, either bitmap can be NULL
+static void secded_mark(int8_t status, int32_t i, uint64_t* corrected, uint64_t* failed)
+{
+	if (status == SECDED_CORRECTED && corrected)
+		corrected[i >> 6] |= 1ULL << (i & 63);
+	else if (status == SECDED_DOUBLE && failed)
+		failed[i >> 6] |= 1ULL << (i & 63);
+}
+
+static void secded_clear_bitmaps(int32_t n, uint64_t* corrected, uint64_t* failed)
+{
+	for (int32_t w = 0; w < (n + 63) / 64; ++w)
+	{
+		if (corrected)
+			corrected[w] = 0;
+		if (failed)
+			failed[w] = 0;
+	}
+}
+
+// checks and corrects n words in place, corrected and failed get a bit per word (so (n + 63) / 64 uint64s each)
+//  set for the ones that had a single error fixed or a double error detected. Returns the number of failed words
+int32_t secded64_scrub(uint64_t* data, uint8_t* chk, int32_t n, uint64_t* corrected, uint64_t* failed)
+{
+	int32_t fails = 0;
+	int32_t i = 0;
+	secded_clear_bitmaps(n, corrected, failed);
+
+#if defined(__AVX512VPOPCNTDQ__) && defined(__AVX512F__)
+	for (; i + 8 <= n; i += 8)
+	{
+		uint64_t stored;
+		memcpy(&stored, chk + i, sizeof(stored));
+		uint64_t diff = secded64_get_chk_x8(_mm512_loadu_si512((const void*)(data + i))) ^ stored;
+		for (; diff; diff &= ~(0xFFULL << (__builtin_ctzll(diff) & ~7)))
+		{
+			int32_t w = i + __builtin_ctzll(diff) / 8;
+			int8_t status = secded64_decode(data + w, chk + w);
+			fails += status == SECDED_DOUBLE;
+			secded_mark(status, w, corrected, failed);
+		}
+	}
+#endif
+#if defined(__AVX2__)
+	for (; i + 4 <= n; i += 4)
+	{
+		uint32_t stored;
+		memcpy(&stored, chk + i, sizeof(stored));
+		uint32_t diff = secded64_get_chk_x4(_mm256_loadu_si256((const __m256i*)(data + i))) ^ stored;
+		for (; diff; diff &= ~(0xFFU << (__builtin_ctz(diff) & ~7)))	// the rare dirty ones go through the scalar decoder
+		{
+			int32_t w = i + __builtin_ctz(diff) / 8;
+			int8_t status = secded64_decode(data + w, chk + w);
+			fails += status == SECDED_DOUBLE;
+			secded_mark(status, w, corrected, failed);
+		}
+	}
+#endif
+	for (; i < n; ++i)
+	{
+		int8_t status = secded64_decode(data + i, chk + i);
+		fails += status == SECDED_DOUBLE;
+		secded_mark(status, i, corrected, failed);
+	}
+
+	return fails;
+}
+
+// the (39,32) check bytes from the (72,64) ones of the same data zero extended, check bit 6 never covers any of
+//  the low 32 bits so it's always 0 and drops out, leaving the overall parity bit to move down 1. 8 bytes at a time
+static inline uint64_t secded32_from_chk64(uint64_t chk64)
+{
+	return (chk64 & 0x3F3F3F3F3F3F3F3FULL) | ((chk64 >> 1) & 0x4040404040404040ULL);
+}
+
+// same as secded64_scrub() for the (39,32) code
+int32_t secded32_scrub(uint32_t* data, uint8_t* chk, int32_t n, uint64_t* corrected, uint64_t* failed)
+{
+	int32_t fails = 0;
+	int32_t i = 0;
+	secded_clear_bitmaps(n, corrected, failed);
+
+#if defined(__AVX512VPOPCNTDQ__) && defined(__AVX512F__)
+	for (; i + 8 <= n; i += 8)
+	{
+		uint64_t stored;
+		memcpy(&stored, chk + i, sizeof(stored));
+		uint64_t diff = secded32_from_chk64(secded64_get_chk_x8(_mm512_cvtepu32_epi64(_mm256_loadu_si256((const __m256i*)(data + i))))) ^ stored;
+		for (; diff; diff &= ~(0xFFULL << (__builtin_ctzll(diff) & ~7)))
+		{
+			int32_t w = i + __builtin_ctzll(diff) / 8;
+			int8_t status = secded32_decode(data + w, chk + w);
+			fails += status == SECDED_DOUBLE;
+			secded_mark(status, w, corrected, failed);
+		}
+	}
+#endif
+#if defined(__AVX2__)
+	for (; i + 4 <= n; i += 4)
+	{
+		uint32_t stored;
+		memcpy(&stored, chk + i, sizeof(stored));
+		uint32_t diff = secded32_from_chk64(secded64_get_chk_x4(_mm256_cvtepu32_epi64(_mm_loadu_si128((const __m128i*)(data + i))))) ^ stored;
+		for (; diff; diff &= ~(0xFFU << (__builtin_ctz(diff) & ~7)))
+		{
+			int32_t w = i + __builtin_ctz(diff) / 8;
+			int8_t status = secded32_decode(data + w, chk + w);
+			fails += status == SECDED_DOUBLE;
+			secded_mark(status, w, corrected, failed);
+		}
+	}
+#endif
+	for (; i < n; ++i)
+	{
+		int8_t status = secded32_decode(data + i, chk + i);
+		fails += status == SECDED_DOUBLE;
+		secded_mark(status, i, corrected, failed);
+	}
+
+	return fails;
+}